@@ -1,13 +1,17 @@
 #include "bind_immutable.h"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>  // Collection::select predicates
 #include <pybind11/stl.h>
 #include <pybind11/iostream.h>  // py::add_ostream_redirect
 
+#include <morphio/collection.h>
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/enums.h>
 #include <morphio/glial_cell.h>
+#include <morphio/loading.h>
 #include <morphio/mut/morphology.h>
+#include <morphio/shared_store.h>
 #include <morphio/soma.h>
 #include <morphio/types.h>
 
@@ -23,21 +27,140 @@ void bind_immutable_module(py::module& m) {
     py::add_ostream_redirect(m, "ostream_redirect");
 
     py::class_<morphio::Morphology>(m, "Morphology")
-        .def(py::init<const std::string&, unsigned int>(),
+        .def(py::init([](const std::string& filename,
+                         unsigned int options,
+                         const py::object& load_options) {
+                 const morphio::LoadOptions loadOptions = load_options_or_default(load_options);
+                 py::gil_scoped_release release;
+                 return std::unique_ptr<morphio::Morphology>(
+                     new morphio::Morphology(filename, options, loadOptions));
+             }),
              "filename"_a,
-             "options"_a = morphio::enums::Option::NO_MODIFIER)
-        .def(py::init<morphio::mut::Morphology&>())
-        .def(py::init([](py::object arg, unsigned int options) {
+             "options"_a = morphio::enums::Option::NO_MODIFIER,
+             "load_options"_a = py::none())
+        .def(py::init<morphio::mut::Morphology&>(), py::call_guard<py::gil_scoped_release>())
+        .def(py::init([](py::object arg, unsigned int options, const py::object& load_options) {
+                 const std::string filename = py::str(arg);
+                 const morphio::LoadOptions loadOptions = load_options_or_default(load_options);
+                 py::gil_scoped_release release;
                  return std::unique_ptr<morphio::Morphology>(
-                     new morphio::Morphology(py::str(arg), options));
+                     new morphio::Morphology(filename, options, loadOptions));
              }),
              "filename"_a,
              "options"_a = morphio::enums::Option::NO_MODIFIER,
+             "load_options"_a = py::none(),
              "Additional Ctor that accepts as filename any python object that implements __repr__ "
              "or __str__")
+        .def_static("from_arrays",
+                    [](const contiguous_array<morphio::floatType>& points,
+                       const contiguous_array<morphio::floatType>& diameters,
+                       const contiguous_array<morphio::floatType>& perimeters,
+                       const contiguous_array<uint32_t>& section_offsets,
+                       const contiguous_array<int32_t>& section_parents,
+                       const contiguous_array<int>& section_types,
+                       const contiguous_array<morphio::floatType>& soma_points,
+                       const contiguous_array<morphio::floatType>& soma_diameters,
+                       unsigned int options) {
+                        return morphio::Morphology::fromArrays(
+                            contiguous_array_to_points(points),
+                            contiguous_array_to_vector<morphio::floatType>(diameters),
+                            contiguous_array_to_vector<morphio::floatType>(perimeters),
+                            contiguous_array_to_vector<uint32_t>(section_offsets),
+                            contiguous_array_to_vector<int32_t>(section_parents),
+                            contiguous_array_to_section_types(section_types),
+                            contiguous_array_to_points(soma_points),
+                            contiguous_array_to_vector<morphio::floatType>(soma_diameters),
+                            options);
+                    },
+                    "points"_a,
+                    "diameters"_a,
+                    "perimeters"_a,
+                    "section_offsets"_a,
+                    "section_parents"_a,
+                    "section_types"_a,
+                    "soma_points"_a = contiguous_array<morphio::floatType>(),
+                    "soma_diameters"_a = contiguous_array<morphio::floatType>(),
+                    "options"_a = morphio::enums::Option::NO_MODIFIER,
+                    "Build a morphology from flat arrays laid out as in the H5 format:\n"
+                    "- points: (N, 3) array; diameters, perimeters: (N,) arrays "
+                    "(perimeters may be empty)\n"
+                    "- section_offsets: index of the first point of each section "
+                    "(a trailing offset equal to N is accepted)\n"
+                    "- section_parents: parent ID of each section, -1 for root sections\n"
+                    "- section_types: SectionType of each section\n\n"
+                    "Each array is validated and copied once, without per element conversion")
+        .def_static(
+            "from_buffer",
+            [](const py::buffer& buffer,
+               const std::string& format,
+               unsigned int options,
+               const py::object& load_options) {
+                const py::buffer_info info = buffer.request();
+                if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize))
+                    throw py::value_error("The content must be a contiguous buffer");
+                const auto size = static_cast<size_t>(info.size * info.itemsize);
+                const morphio::LoadOptions loadOptions = load_options_or_default(load_options);
+                py::gil_scoped_release release;
+                return std::unique_ptr<morphio::Morphology>(
+                    new morphio::Morphology(morphio::Morphology::fromBuffer(
+                        static_cast<const char*>(info.ptr), size, format, options, loadOptions)));
+            },
+            "buffer"_a,
+            "format"_a,
+            "options"_a = morphio::enums::Option::NO_MODIFIER,
+            "load_options"_a = py::none(),
+            "Load a morphology from the content of a file held in memory (bytes, bytearray, "
+            "memoryview...), without touching the disk\n"
+            "format is 'swc', 'asc', 'h5' or 'morphio', as the extension of the file would be")
         .def("as_mutable",
              [](const morphio::Morphology* morph) { return morphio::mut::Morphology(*morph); })
 
+        // Pickling: the state is the buffer of Morphology::serialize()
+        .def(py::pickle(
+            [](const morphio::Morphology& morph) {
+                std::vector<char> buffer;
+                {
+                    py::gil_scoped_release release;
+                    buffer = morph.serialize();
+                }
+                return py::bytes(buffer.data(), buffer.size());
+            },
+            [](const py::buffer& state) {
+                const py::buffer_info info = state.request();
+                if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize))
+                    throw py::value_error("The state of a Morphology must be a contiguous buffer");
+                const auto size = static_cast<size_t>(info.size * info.itemsize);
+                py::gil_scoped_release release;
+                return std::unique_ptr<morphio::Morphology>(new morphio::Morphology(
+                    morphio::Morphology::deserialize(static_cast<const char*>(info.ptr), size)));
+            }))
+        .def(
+            "__reduce_ex__",
+            [](py::object self, int protocol) {
+                py::object state;
+                if (protocol >= 5) {
+                    // Handed over to pickle without a copy: with a buffer_callback, it is
+                    // transferred out-of-band
+                    std::vector<char> buffer;
+                    {
+                        py::gil_scoped_release release;
+                        buffer = self.cast<const morphio::Morphology&>().serialize();
+                    }
+                    state = py::module::import("pickle").attr("PickleBuffer")(
+                        as_pyarray(std::move(buffer)));
+                } else {
+                    state = self.attr("__getstate__")();
+                }
+                return py::make_tuple(py::module::import("copyreg").attr("__newobj__"),
+                                      py::make_tuple(py::module::import("morphio").attr(
+                                          "Morphology")),
+                                      state);
+            },
+            "protocol"_a,
+            "Pickle support: with protocol 5, the serialized morphology is a PickleBuffer that "
+            "can be sent out-of-band\n"
+            "Subclasses such as GlialCell are unpickled as Morphology")
+
         // Cell sub-parts accessors
         .def_property_readonly("soma", &morphio::Morphology::soma, "Returns the soma object")
         .def_property_readonly("mitochondria",
@@ -73,27 +196,27 @@ void bind_immutable_module(py::module& m) {
         // Property accessors
         .def_property_readonly(
             "points",
-            [](morphio::Morphology* morpho) {
-                const auto& data = morpho->points();
-                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            [](py::object self) {
+                const auto& data = self.cast<const morphio::Morphology&>().points();
+                return points_to_ndarray(data.data(), data.size(), self);
             },
             "Returns a list with all points from all sections (soma points are not included)\n"
             "Note: points belonging to the n'th section are located at indices:\n"
             "[Morphology.sectionOffsets(n), Morphology.sectionOffsets(n+1)[")
         .def_property_readonly(
             "diameters",
-            [](const morphio::Morphology& morpho) {
-                const auto& data = morpho.diameters();
-                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            [](py::object self) {
+                return vector_to_ndarray(self.cast<const morphio::Morphology&>().diameters(),
+                                         self);
             },
             "Returns a list with all diameters from all sections (soma points are not included)\n"
             "Note: diameters belonging to the n'th section are located at indices:\n"
             "[Morphology.sectionOffsets(n), Morphology.sectionOffsets(n+1)[")
         .def_property_readonly(
             "perimeters",
-            [](const morphio::Morphology& obj) {
-                const auto& data = obj.perimeters();
-                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            [](py::object self) {
+                return vector_to_ndarray(self.cast<const morphio::Morphology&>().perimeters(),
+                                         self);
             },
             "Returns a list with all perimeters from all sections (soma points are not included)\n"
             "Note: perimeters belonging to the n'th section are located at indices:\n"
@@ -111,15 +234,60 @@ void bind_immutable_module(py::module& m) {
             "so that the above example works also for the last section.")
         .def_property_readonly(
             "section_types",
-            [](const morphio::Morphology& morph) {
-                const auto& data = morph.sectionTypes();
-                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            [](py::object self) {
+                return vector_to_ndarray(self.cast<const morphio::Morphology&>().sectionTypes(),
+                                         self);
             },
             "Returns a vector with the section type of every section")
         .def_property_readonly("connectivity",
                                &morphio::Morphology::connectivity,
                                "Return the graph connectivity of the morphology "
                                "where each section is seen as a node\nNote: -1 is the soma node")
+        // Section level tables
+        .def_property_readonly(
+            "section_parents",
+            [](const morphio::Morphology& morph) { return as_pyarray(morph.sectionParents()); },
+            "Returns the parent ID of every section, -1 for root sections")
+        .def_property_readonly(
+            "section_point_counts",
+            [](const morphio::Morphology& morph) {
+                return as_pyarray(morph.sectionPointCounts());
+            },
+            "Returns the number of points of every section")
+        .def_property_readonly(
+            "section_lengths",
+            [](const morphio::Morphology& morph) { return as_pyarray(morph.sectionLengths()); },
+            "Returns the length of every section: the sum of the distances between its "
+            "consecutive points")
+        .def_property_readonly(
+            "root_section_ids",
+            [](const morphio::Morphology& morph) { return as_pyarray(morph.rootSectionIds()); },
+            "Returns the IDs of the root sections, the sections connected to the soma")
+        .def_property_readonly(
+            "section_children",
+            [](const morphio::Morphology& morph) {
+                auto children = morph.sectionChildren();
+                return py::make_tuple(as_pyarray(std::move(children.first)),
+                                      as_pyarray(std::move(children.second)));
+            },
+            "Returns the children of every section as a (offsets, ids) tuple of arrays\n"
+            "The children of section i are ids[offsets[i]:offsets[i + 1]]")
+        .def(
+            "section_order",
+            [](const morphio::Morphology& morph, IterType type) {
+                switch (type) {
+                case IterType::DEPTH_FIRST:
+                    return as_pyarray(morph.sectionIdsDepthFirst());
+                case IterType::BREADTH_FIRST:
+                    return as_pyarray(morph.sectionIdsBreadthFirst());
+                case IterType::UPSTREAM:
+                default:
+                    throw morphio::MorphioError(
+                        "Only iteration types depth_first and breadth_first are supported");
+                }
+            },
+            "Returns the IDs of all sections in the order of iter(iter_type)",
+            "iter_type"_a = IterType::DEPTH_FIRST)
         .def_property_readonly("soma_type", &morphio::Morphology::somaType, "Returns the soma type")
         .def_property_readonly("cell_family",
                                &morphio::Morphology::cellFamily,
@@ -150,14 +318,261 @@ void bind_immutable_module(py::module& m) {
             "iter_type"_a = IterType::DEPTH_FIRST);
 
     py::class_<morphio::GlialCell, morphio::Morphology>(m, "GlialCell")
-        .def(py::init<const std::string&>())
+        .def(py::init<const std::string&>(), py::call_guard<py::gil_scoped_release>())
         .def(py::init([](py::object arg) {
-                 return std::unique_ptr<morphio::GlialCell>(new morphio::GlialCell(py::str(arg)));
+                 const std::string filename = py::str(arg);
+                 py::gil_scoped_release release;
+                 return std::unique_ptr<morphio::GlialCell>(new morphio::GlialCell(filename));
              }),
              "filename"_a,
              "Additional Ctor that accepts as filename any python object that implements __repr__ "
              "or __str__");
 
+    py::class_<morphio::CollectionEntry>(m,
+                                         "CollectionEntry",
+                                         "What the index of a collection records about one of "
+                                         "its morphologies")
+        .def_readonly("name", &morphio::CollectionEntry::name)
+        .def_readonly("location",
+                      &morphio::CollectionEntry::location,
+                      "The file name in a directory, the group in a container or the member in "
+                      "an archive")
+        .def_readonly("format", &morphio::CollectionEntry::format, "h5, swc or asc")
+        .def_readonly("offset",
+                      &morphio::CollectionEntry::offset,
+                      "Address of the points in a container, of the member in an archive")
+        .def_readonly("size",
+                      &morphio::CollectionEntry::size,
+                      "Size in bytes of the file, or of the member in an archive")
+        .def_readonly("modification_time",
+                      &morphio::CollectionEntry::modificationTime,
+                      "Modification time of the file in a directory, in seconds since the epoch")
+        .def_readonly("n_sections", &morphio::CollectionEntry::nSections)
+        .def_readonly("n_points", &morphio::CollectionEntry::nPoints)
+        .def_property_readonly(
+            "bounding_box",
+            [](const morphio::CollectionEntry& entry) {
+                return py::array(py::cast(std::vector<morphio::Point>{entry.boundingBoxMin,
+                                                                      entry.boundingBoxMax}));
+            },
+            "The lowest and highest corners of the bounding box of the points");
+
+    py::class_<morphio::Collection>(m, "Collection")
+        .def(py::init([](py::object collection_path,
+                         size_t cache_size,
+                         size_t max_open_files,
+                         std::vector<std::string> extensions,
+                         py::object index_path) {
+                 return std::unique_ptr<morphio::Collection>(new morphio::Collection(
+                     py::str(collection_path),
+                     cache_size,
+                     max_open_files,
+                     std::move(extensions),
+                     index_path.is_none() ? std::string() : std::string(py::str(index_path))));
+             }),
+             "collection_path"_a,
+             "cache_size"_a = 0,
+             "max_open_files"_a = 64,
+             "extensions"_a = std::vector<std::string>{".h5", ".swc", ".asc"},
+             "index_path"_a = py::none(),
+             "Open a directory of morphology files, or an HDF5 container with one group per "
+             "morphology\n\n"
+             "cache_size is the number of loaded morphologies kept in memory (0: no cache)\n"
+             "max_open_files is the number of HDF5 files of a directory kept open\n"
+             "index_path is the sidecar index written by write_index, by default "
+             "collection_path followed by .morphio-index")
+        .def(
+            "write_index",
+            [](morphio::Collection& collection, py::object index_path) {
+                const std::string path = index_path.is_none() ? std::string()
+                                                              : std::string(py::str(index_path));
+                py::gil_scoped_release release;
+                collection.writeIndex(path);
+            },
+            "Load every morphology to write the sidecar index of the collection",
+            "index_path"_a = py::none())
+        .def_property_readonly("has_index",
+                               &morphio::Collection::hasIndex,
+                               "Whether the collection has its sidecar index")
+        .def("entry",
+             &morphio::Collection::entry,
+             "What the index records about the given morphology; with validate, the entry is "
+             "checked against the file of the morphology",
+             "morph_name"_a,
+             "validate"_a = false,
+             py::return_value_policy::reference_internal)
+        .def("select",
+             &morphio::Collection::select,
+             "Names of the morphologies whose CollectionEntry matches the predicate, in on-disk "
+             "order; with validate, the matching entries are checked as in entry",
+             "predicate"_a,
+             "validate"_a = false)
+        .def(
+            "load",
+            [](const morphio::Collection& collection,
+               const std::string& morph_name,
+               unsigned int options,
+               bool mutable_) -> py::object {
+                if (mutable_) {
+                    std::unique_ptr<morphio::mut::Morphology> morph;
+                    {
+                        py::gil_scoped_release release;
+                        morph.reset(
+                            new morphio::mut::Morphology(collection.load(morph_name, options)));
+                    }
+                    return py::cast(std::move(morph));
+                }
+                std::unique_ptr<morphio::Morphology> morph;
+                {
+                    py::gil_scoped_release release;
+                    morph.reset(new morphio::Morphology(collection.load(morph_name, options)));
+                }
+                return py::cast(std::move(morph));
+            },
+            "Load the morphology with the given name\n"
+            "If mutable is True, a morphio.mut.Morphology is returned",
+            "morph_name"_a,
+            "options"_a = morphio::enums::Option::NO_MODIFIER,
+            "mutable"_a = false)
+        .def_property_readonly("names",
+                               &morphio::Collection::names,
+                               "Names of the morphologies, in on-disk order")
+        .def("path",
+             &morphio::Collection::path,
+             "Path of the file holding the given morphology",
+             "morph_name"_a)
+        .def("__contains__", &morphio::Collection::contains, "morph_name"_a)
+        .def("__len__", &morphio::Collection::size)
+        .def(
+            "__iter__",
+            [](const morphio::Collection& collection) {
+                return py::make_iterator(collection.names().begin(), collection.names().end());
+            },
+            py::keep_alive<0, 1>(),
+            "Iterate over the names of the morphologies, in on-disk order");
+
+    m.def(
+        "load_many",
+        [](const std::vector<py::object>& paths,
+           unsigned int options,
+           unsigned int n_threads,
+           const py::object& load_options) {
+            std::vector<std::string> filenames;
+            filenames.reserve(paths.size());
+            for (const auto& path : paths) {
+                filenames.push_back(py::str(path));
+            }
+            const morphio::LoadOptions loadOptions = load_options_or_default(load_options);
+            py::gil_scoped_release release;
+            return morphio::loadMany(filenames, options, n_threads, loadOptions);
+        },
+        "Load a list of morphologies in parallel with n_threads threads "
+        "(0: one per hardware thread)\n"
+        "Morphologies are returned in the order of the paths. Reads of HDF5 files are "
+        "serialized, everything else runs in parallel.",
+        "paths"_a,
+        "options"_a = morphio::enums::Option::NO_MODIFIER,
+        "n_threads"_a = 0,
+        "load_options"_a = py::none());
+
+    py::class_<morphio::Prefetcher>(m, "Prefetcher")
+        .def(py::init([](const std::vector<py::object>& paths,
+                         unsigned int options,
+                         size_t depth,
+                         const py::object& load_options) {
+                 std::vector<std::string> filenames;
+                 filenames.reserve(paths.size());
+                 for (const auto& path : paths) {
+                     filenames.push_back(py::str(path));
+                 }
+                 return std::unique_ptr<morphio::Prefetcher>(
+                     new morphio::Prefetcher(std::move(filenames),
+                                             options,
+                                             depth,
+                                             load_options_or_default(load_options)));
+             }),
+             "paths"_a,
+             "options"_a = morphio::enums::Option::NO_MODIFIER,
+             "depth"_a = 4,
+             "load_options"_a = py::none(),
+             "Iterate over the morphologies of paths, loading up to depth of them in background "
+             "threads ahead of the iteration")
+        .def("__iter__", [](py::object self) { return self; })
+        .def("__next__",
+             [](morphio::Prefetcher& prefetcher) {
+                 if (!prefetcher.hasNext())
+                     throw py::stop_iteration();
+                 py::gil_scoped_release release;
+                 return prefetcher.next();
+             })
+        .def("__enter__", [](py::object self) { return self; })
+        .def("__exit__",
+             [](morphio::Prefetcher& prefetcher, py::object, py::object, py::object) {
+                 prefetcher.cancel();
+             })
+        .def("cancel",
+             &morphio::Prefetcher::cancel,
+             "Stop the iteration and launch no other load; the loads already running complete "
+             "in the background")
+        .def_property_readonly("position",
+                               &morphio::Prefetcher::position,
+                               "Index in paths of the next morphology of the iteration");
+
+    py::class_<morphio::SharedStore>(m, "SharedStore")
+        .def(py::init([](py::object name) {
+                 const std::string name_ = py::str(name);
+                 py::gil_scoped_release release;
+                 return std::unique_ptr<morphio::SharedStore>(new morphio::SharedStore(name_));
+             }),
+             "name"_a,
+             "Attach read-only to the store with the given name: a POSIX shared memory segment "
+             "if the name has no '/', otherwise a memory-mapped file")
+        .def_static(
+            "create",
+            [](py::object name, const py::dict& morphologies) {
+                const std::string name_ = py::str(name);
+                std::vector<std::string> keys;
+                std::vector<const morphio::Morphology*> values;
+                for (const auto& item : morphologies) {
+                    keys.push_back(py::str(item.first));
+                    values.push_back(item.second.cast<const morphio::Morphology*>());
+                }
+                py::gil_scoped_release release;
+                return morphio::SharedStore::create(name_, keys, values);
+            },
+            "name"_a,
+            "morphologies"_a,
+            "Create a store holding the values of the morphologies dict under their keys, and "
+            "attach to it\n"
+            "Raise a RawDataError if the store already exists")
+        .def_static(
+            "remove",
+            [](py::object name) { morphio::SharedStore::remove(py::str(name)); },
+            "name"_a,
+            "Remove the store, processes attached to it can still use it")
+        .def(
+            "load",
+            [](const morphio::SharedStore& store, const std::string& key) {
+                py::gil_scoped_release release;
+                return store.load(key);
+            },
+            "key"_a,
+            "Load the morphology stored under the given key, without reading any file\n"
+            "The points of its sections stay in the shared memory, and the morphologies of a "
+            "same key loaded by a process share their data")
+        .def_property_readonly("keys",
+                               &morphio::SharedStore::keys,
+                               "Keys of the morphologies, in storage order")
+        .def("__contains__", &morphio::SharedStore::contains, "key"_a)
+        .def("__len__", &morphio::SharedStore::size)
+        .def(
+            "__iter__",
+            [](const morphio::SharedStore& store) {
+                return py::make_iterator(store.keys().begin(), store.keys().end());
+            },
+            py::keep_alive<0, 1>(),
+            "Iterate over the keys of the morphologies");
+
     py::class_<morphio::Mitochondria>(
         m,
         "Mitochondria",
@@ -202,11 +617,15 @@ void bind_immutable_module(py::module& m) {
         .def(py::init<const morphio::Soma&>())
         .def_property_readonly(
             "points",
-            [](morphio::Soma* soma) { return span_array_to_ndarray(soma->points()); },
+            [](py::object self) {
+                return span_array_to_ndarray(self.cast<const morphio::Soma&>().points(), self);
+            },
             "Returns the coordinates (x,y,z) of all soma point")
         .def_property_readonly(
             "diameters",
-            [](morphio::Soma* soma) { return span_to_ndarray(soma->diameters()); },
+            [](py::object self) {
+                return span_to_ndarray(self.cast<const morphio::Soma&>().diameters(), self);
+            },
             "Returns the diameters of all soma points")
 
         .def_property_readonly(
@@ -256,15 +675,21 @@ void bind_immutable_module(py::module& m) {
                                "(dendrite, axon, ...)")
         .def_property_readonly(
             "points",
-            [](morphio::Section* section) { return span_array_to_ndarray(section->points()); },
+            [](py::object self) {
+                return span_array_to_ndarray(self.cast<const morphio::Section&>().points(), self);
+            },
             "Returns list of section's point coordinates")
         .def_property_readonly(
             "diameters",
-            [](morphio::Section* section) { return span_to_ndarray(section->diameters()); },
+            [](py::object self) {
+                return span_to_ndarray(self.cast<const morphio::Section&>().diameters(), self);
+            },
             "Returns list of section's point diameters")
         .def_property_readonly(
             "perimeters",
-            [](morphio::Section* section) { return span_to_ndarray(section->perimeters()); },
+            [](py::object self) {
+                return span_to_ndarray(self.cast<const morphio::Section&>().perimeters(), self);
+            },
             "Returns list of section's point perimeters")
 
         // Iterators
@@ -314,19 +739,23 @@ void bind_immutable_module(py::module& m) {
             "The section ID can be used to query sections via Mitochondria::section(uint32_t id)")
         .def_property_readonly(
             "neurite_section_ids",
-            [](morphio::MitoSection* section) {
-                return span_to_ndarray(section->neuriteSectionIds());
+            [](py::object self) {
+                return span_to_ndarray(
+                    self.cast<const morphio::MitoSection&>().neuriteSectionIds(), self);
             },
             "Returns list of neuronal section IDs associated to each point "
             "of this mitochondrial section")
         .def_property_readonly(
             "diameters",
-            [](morphio::MitoSection* section) { return span_to_ndarray(section->diameters()); },
+            [](py::object self) {
+                return span_to_ndarray(self.cast<const morphio::MitoSection&>().diameters(), self);
+            },
             "Returns list of section's point diameters")
         .def_property_readonly(
             "relative_path_lengths",
-            [](morphio::MitoSection* section) {
-                return span_to_ndarray(section->relativePathLengths());
+            [](py::object self) {
+                return span_to_ndarray(
+                    self.cast<const morphio::MitoSection&>().relativePathLengths(), self);
             },
             "Returns list of relative distances between the start of the "
             "neuronal section and each point of the mitochondrial section\n\n"
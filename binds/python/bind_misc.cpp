@@ -5,6 +5,8 @@
 
 #include <morphio/enums.h>
 #include <morphio/errorMessages.h>
+#include <morphio/io_policy.h>
+#include <morphio/parse_cache.h>
 #include <morphio/types.h>
 #include <morphio/version.h>
 
@@ -33,6 +35,127 @@ void bind_misc(py::module& m) {
           "Ignore/Unignore a list of warnings",
           "warning"_a,
           "ignore"_a = true);
+    m.def("enable_parse_cache",
+          &morphio::enableParseCache,
+          "Cache the parsed SWC and ASC files in the given directory, in the MorphIO binary\n"
+          "encoding, so that the next loads of a file with the same options skip parsing\n"
+          "Entries are keyed by the path, size, modification time and content of the file\n"
+          "The least recently used entries are removed when the cache exceeds max_size bytes",
+          "directory"_a,
+          "max_size"_a = uint64_t(1) << 30);
+    m.def("disable_parse_cache",
+          &morphio::disableParseCache,
+          "Stop using the parse cache, its content is left on disk");
+    m.def("set_io_policy",
+          &morphio::setIOPolicy,
+          "Set how the next loads read morphology files: with the readers' own reads, after\n"
+          "a readahead hint, with a single large read or by mapping the file in memory\n"
+          "This is the default of LoadOptions.io_policy, which can set it for a single load",
+          "policy"_a);
+    m.def("get_io_policy", &morphio::getIOPolicy, "Return the policy set with set_io_policy");
+    m.def("enable_io_stats",
+          &morphio::enableIOStats,
+          "Collect the I/O statistics of the loads of morphology files (Linux only)",
+          "enable"_a = true);
+    m.def("last_io_stats",
+          &morphio::lastIOStats,
+          "Return the I/O statistics of the last morphology file loaded by the calling thread");
+
+    py::class_<morphio::LoadOptions>(
+        m,
+        "LoadOptions",
+        "The payloads read when loading a morphology: disabled ones are neither read nor kept")
+        .def(py::init([](bool perimeters,
+                         bool mitochondria,
+                         bool endoplasmic_reticulum,
+                         bool markers,
+                         bool annotations,
+                         bool line_numbers,
+                         std::vector<morphio::SectionType> neurite_types,
+                         bool lazy,
+                         py::object io_policy,
+                         morphio::floatType simplify_tolerance,
+                         morphio::floatType resample_spacing) {
+                 morphio::LoadOptions loadOptions;
+                 loadOptions.perimeters = perimeters;
+                 loadOptions.mitochondria = mitochondria;
+                 loadOptions.endoplasmicReticulum = endoplasmic_reticulum;
+                 loadOptions.markers = markers;
+                 loadOptions.annotations = annotations;
+                 loadOptions.lineNumbers = line_numbers;
+                 loadOptions.neuriteTypes = std::move(neurite_types);
+                 loadOptions.lazy = lazy;
+                 if (!io_policy.is_none())
+                     loadOptions.ioPolicy = io_policy.cast<morphio::IOPolicy>();
+                 loadOptions.simplifyTolerance = simplify_tolerance;
+                 loadOptions.resampleSpacing = resample_spacing;
+                 return loadOptions;
+             }),
+             "perimeters"_a = true,
+             "mitochondria"_a = true,
+             "endoplasmic_reticulum"_a = true,
+             "markers"_a = true,
+             "annotations"_a = true,
+             "line_numbers"_a = true,
+             "neurite_types"_a = std::vector<morphio::SectionType>(),
+             "lazy"_a = false,
+             "io_policy"_a = py::none(),
+             "simplify_tolerance"_a = 0,
+             "resample_spacing"_a = 0)
+        .def_static("geometry_only",
+                    &morphio::LoadOptions::geometryOnly,
+                    "Only the points, diameters and topology")
+        .def_readwrite("perimeters",
+                       &morphio::LoadOptions::perimeters,
+                       "Perimeters of the points and of the soma (H5 and MorphIO binary)")
+        .def_readwrite("mitochondria",
+                       &morphio::LoadOptions::mitochondria,
+                       "Mitochondria (H5 and MorphIO binary)")
+        .def_readwrite("endoplasmic_reticulum",
+                       &morphio::LoadOptions::endoplasmicReticulum,
+                       "Endoplasmic reticulum (H5 and MorphIO binary)")
+        .def_readwrite("markers",
+                       &morphio::LoadOptions::markers,
+                       "Markers (ASC and MorphIO binary)")
+        .def_readwrite("annotations",
+                       &morphio::LoadOptions::annotations,
+                       "Annotations (MorphIO binary)")
+        .def_readwrite("line_numbers",
+                       &morphio::LoadOptions::lineNumbers,
+                       "Line numbers of the sections, tracked by the SWC and ASC readers")
+        .def_readwrite("neurite_types",
+                       &morphio::LoadOptions::neuriteTypes,
+                       "The types of the neurites to load, all of them when empty")
+        .def_readwrite("lazy",
+                       &morphio::LoadOptions::lazy,
+                       "Read the points of the neurites on first access (H5 only)")
+        .def_readwrite("io_policy",
+                       &morphio::LoadOptions::ioPolicy,
+                       "How the file is read, by default the policy set with set_io_policy")
+        .def_readwrite("simplify_tolerance",
+                       &morphio::LoadOptions::simplifyTolerance,
+                       "Simplify the neurites with this tolerance once loaded, 0: no "
+                       "simplification")
+        .def_readwrite("resample_spacing",
+                       &morphio::LoadOptions::resampleSpacing,
+                       "Resample the neurites to this spacing once loaded, 0: no resampling");
+
+    py::class_<morphio::IOStats>(m, "IOStats", "The input/output done while loading a file")
+        .def_readonly("bytes_read",
+                      &morphio::IOStats::bytesRead,
+                      "Bytes returned by read system calls")
+        .def_readonly("read_calls",
+                      &morphio::IOStats::readCalls,
+                      "Number of read system calls")
+        .def_readonly("bytes_mapped",
+                      &morphio::IOStats::bytesMapped,
+                      "Bytes of the file mapped in memory");
+
+    py::enum_<morphio::enums::IOPolicy>(m, "IOPolicy")
+        .value("default", morphio::enums::IOPolicy::IO_DEFAULT)
+        .value("readahead", morphio::enums::IOPolicy::IO_READAHEAD)
+        .value("slurp", morphio::enums::IOPolicy::IO_SLURP)
+        .value("mmap", morphio::enums::IOPolicy::IO_MMAP);
 
     py::enum_<morphio::enums::AnnotationType>(m, "AnnotationType")
         .value("single_child",
@@ -8,6 +8,7 @@
 #include <morphio/mut/endoplasmic_reticulum.h>
 #include <morphio/mut/glial_cell.h>
 #include <morphio/mut/mitochondria.h>
+#include <morphio/mut/modifiers.h>
 #include <morphio/mut/morphology.h>
 
 #include <array>
@@ -17,6 +18,63 @@
 
 namespace py = pybind11;
 
+namespace {
+/**
+   The base of the numpy views on the data of a section: it keeps the section alive and
+   registers the views, so that the number of points of the section can not change under them
+**/
+py::capsule section_view_owner(const std::shared_ptr<morphio::mut::Section>& section) {
+    section->acquireWritableView();
+    return py::capsule(new std::shared_ptr<morphio::mut::Section>(section), [](void* ptr) {
+        auto* owned = static_cast<std::shared_ptr<morphio::mut::Section>*>(ptr);
+        (*owned)->releaseWritableView();
+        delete owned;
+    });
+}
+
+/** The base of the numpy views on the data of a soma, keeping it alive **/
+py::capsule soma_view_owner(const std::shared_ptr<morphio::mut::Soma>& soma) {
+    soma->acquireWritableView();
+    return py::capsule(new std::shared_ptr<morphio::mut::Soma>(soma), [](void* ptr) {
+        auto* owned = static_cast<std::shared_ptr<morphio::mut::Soma>*>(ptr);
+        (*owned)->releaseWritableView();
+        delete owned;
+    });
+}
+
+/**
+   Data with writable views keeps its size: reallocating it would leave the views pointing to
+   freed memory. Sections check it in mut::Section::setProperties.
+**/
+void throw_if_resized(const morphio::mut::Soma& soma, size_t size, py::ssize_t newSize) {
+    if (static_cast<size_t>(newSize) != size)
+        soma.throwIfWritableViews();
+}
+
+/**
+   Replace the points, diameters or perimeters of a section through
+   mut::Section::setProperties: the other fields are read through the const accessor
+**/
+template <typename Assign>
+void set_section_data(morphio::mut::Section& section, Assign assign) {
+    const morphio::mut::Section& constSection = section;
+    morphio::Property::PointLevel properties = constSection.properties();
+    assign(properties);
+    section.setProperties(std::move(properties));
+}
+
+py::array_t<morphio::floatType> points_view(morphio::Points& points, py::handle owner) {
+    return writable_ndarray(reinterpret_cast<morphio::floatType*>(points.data()),
+                            {static_cast<py::ssize_t>(points.size()), 3},
+                            owner);
+}
+
+py::array_t<morphio::floatType> values_view(std::vector<morphio::floatType>& values,
+                                            py::handle owner) {
+    return writable_ndarray(values.data(), {static_cast<py::ssize_t>(values.size())}, owner);
+}
+}  // namespace
+
 void bind_mutable_module(py::module& m) {
     using namespace py::literals;
 
@@ -25,22 +83,66 @@ void bind_mutable_module(py::module& m) {
         .def(py::init<>())
         .def(py::init<const std::string&, unsigned int>(),
              "filename"_a,
-             "options"_a = morphio::enums::Option::NO_MODIFIER)
+             "options"_a = morphio::enums::Option::NO_MODIFIER,
+             py::call_guard<py::gil_scoped_release>())
         .def(py::init<const morphio::Morphology&, unsigned int>(),
              "morphology"_a,
-             "options"_a = morphio::enums::Option::NO_MODIFIER)
+             "options"_a = morphio::enums::Option::NO_MODIFIER,
+             py::call_guard<py::gil_scoped_release>())
         .def(py::init<const morphio::mut::Morphology&, unsigned int>(),
              "morphology"_a,
-             "options"_a = morphio::enums::Option::NO_MODIFIER)
+             "options"_a = morphio::enums::Option::NO_MODIFIER,
+             py::call_guard<py::gil_scoped_release>())
         .def(py::init([](py::object arg, unsigned int options) {
+                 const std::string filename = py::str(arg);
+                 py::gil_scoped_release release;
                  return std::unique_ptr<morphio::mut::Morphology>(
-                     new morphio::mut::Morphology(py::str(arg), options));
+                     new morphio::mut::Morphology(filename, options));
              }),
              "filename"_a,
              "options"_a = morphio::enums::Option::NO_MODIFIER,
              "Additional Ctor that accepts as filename any python "
              "object that implements __repr__ or __str__")
 
+        .def_static("from_arrays",
+                    [](const contiguous_array<morphio::floatType>& points,
+                       const contiguous_array<morphio::floatType>& diameters,
+                       const contiguous_array<morphio::floatType>& perimeters,
+                       const contiguous_array<uint32_t>& section_offsets,
+                       const contiguous_array<int32_t>& section_parents,
+                       const contiguous_array<int>& section_types,
+                       const contiguous_array<morphio::floatType>& soma_points,
+                       const contiguous_array<morphio::floatType>& soma_diameters,
+                       unsigned int options) {
+                        return morphio::mut::Morphology::fromArrays(
+                            contiguous_array_to_points(points),
+                            contiguous_array_to_vector<morphio::floatType>(diameters),
+                            contiguous_array_to_vector<morphio::floatType>(perimeters),
+                            contiguous_array_to_vector<uint32_t>(section_offsets),
+                            contiguous_array_to_vector<int32_t>(section_parents),
+                            contiguous_array_to_section_types(section_types),
+                            contiguous_array_to_points(soma_points),
+                            contiguous_array_to_vector<morphio::floatType>(soma_diameters),
+                            options);
+                    },
+                    "points"_a,
+                    "diameters"_a,
+                    "perimeters"_a,
+                    "section_offsets"_a,
+                    "section_parents"_a,
+                    "section_types"_a,
+                    "soma_points"_a = contiguous_array<morphio::floatType>(),
+                    "soma_diameters"_a = contiguous_array<morphio::floatType>(),
+                    "options"_a = morphio::enums::Option::NO_MODIFIER,
+                    "Build a mutable morphology from flat arrays laid out as in the H5 format:\n"
+                    "- points: (N, 3) array; diameters, perimeters: (N,) arrays "
+                    "(perimeters may be empty)\n"
+                    "- section_offsets: index of the first point of each section "
+                    "(a trailing offset equal to N is accepted)\n"
+                    "- section_parents: parent ID of each section, -1 for root sections\n"
+                    "- section_types: SectionType of each section\n\n"
+                    "Each array is validated and copied once, without per element conversion")
+
         // Cell sub-part accessors
         .def_property_readonly("sections",
                                &morphio::mut::Morphology::sections,
@@ -83,7 +185,30 @@ void bind_mutable_module(py::module& m) {
         .def("build_read_only",
              &morphio::mut::Morphology::buildReadOnly,
              "Returns the data structure used to create read-only "
-             "morphologies")
+             "morphologies",
+             py::call_guard<py::gil_scoped_release>())
+        .def(
+            "checkout_neurite",
+            &morphio::mut::Morphology::checkoutNeurite,
+            "Returns an independent copy of the neurite starting at the given root section\n\n"
+            "It can be edited while other neurites are checked out and edited. Sections keep "
+            "their IDs, new sections get IDs that do not collide with the ones of this "
+            "morphology. Use merge_neurite to bring the edits back.",
+            "root_id"_a)
+        .def(
+            "merge_neurite",
+            [](morphio::mut::Morphology& morph,
+               uint32_t root_id,
+               morphio::mut::Morphology& neurite) {
+                morph.mergeNeurite(root_id, std::move(neurite));
+            },
+            "Replaces the neurite starting at root_id by the sections of neurite, "
+            "a morphology returned by checkout_neurite(root_id)\n\n"
+            "The sections are moved: neurite is left empty. New sections are given new IDs. "
+            "Raises a SectionBuilderError, before any modification, if neurite was not "
+            "checked out from root_id of this morphology or was already merged.",
+            "root_id"_a,
+            "neurite"_a)
         .def("append_root_section",
              static_cast<std::shared_ptr<morphio::mut::Section> (morphio::mut::Morphology::*)(
                  const morphio::Property::PointLevel&, morphio::SectionType)>(
@@ -113,8 +238,12 @@ void bind_mutable_module(py::module& m) {
              "section"_a,
              "recursive"_a = true)
 
-        .def("as_immutable",
-             [](const morphio::mut::Morphology* morph) { return morphio::Morphology(*morph); })
+        .def(
+            "as_immutable",
+            [](const morphio::mut::Morphology* morph) {
+                py::gil_scoped_release release;
+                return std::unique_ptr<morphio::Morphology>(new morphio::Morphology(*morph));
+            })
 
         .def_property_readonly("connectivity",
                                &morphio::mut::Morphology::connectivity,
@@ -137,10 +266,58 @@ void bind_mutable_module(py::module& m) {
              "Fixes the morphology single child sections and issues warnings"
              "if the section starts and ends are inconsistent")
 
+        .def(
+            "resample",
+            [](morphio::mut::Morphology* morph, morphio::floatType spacing) {
+                morphio::mut::modifiers::resample(*morph, spacing);
+            },
+            "Resample each section with equally spaced points, the spacing being at most "
+            "`spacing`.\n"
+            "The first and last points of each section are kept, diameters and perimeters are "
+            "linearly interpolated. Raises a MorphioError if spacing is not strictly positive",
+            "spacing"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "resample",
+            [](morphio::mut::Morphology* morph,
+               const morphio::modifiers::SectionTypeParameters& spacings) {
+                morphio::mut::modifiers::resample(*morph, spacings);
+            },
+            "Resample the sections with a per section type spacing: {SectionType: spacing}\n"
+            "Sections whose type is not in the dict are left untouched",
+            "spacings"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "simplify",
+            [](morphio::mut::Morphology* morph, morphio::floatType tolerance) {
+                morphio::mut::modifiers::simplify(*morph, tolerance);
+            },
+            "Ramer-Douglas-Peucker simplification of each section\n"
+            "A point is removed if both its distance to the simplified section and "
+            "the difference between its radius and the interpolated one are "
+            "within `tolerance`. The first and last points of each section are kept. Raises a "
+            "MorphioError if tolerance is negative",
+            "tolerance"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "simplify",
+            [](morphio::mut::Morphology* morph,
+               const morphio::modifiers::SectionTypeParameters& tolerances) {
+                morphio::mut::modifiers::simplify(*morph, tolerances);
+            },
+            "Simplify the sections with a per section type tolerance: {SectionType: tolerance}\n"
+            "Sections whose type is not in the dict are left untouched",
+            "tolerances"_a,
+            py::call_guard<py::gil_scoped_release>())
+
         .def(
             "write",
-            [](morphio::mut::Morphology* morph, py::object arg) { morph->write(py::str(arg)); },
-            "Write file to H5, SWC, ASC format depending on filename "
+            [](morphio::mut::Morphology* morph, py::object arg) {
+                const std::string filename = py::str(arg);
+                py::gil_scoped_release release;
+                morph->write(filename);
+            },
+            "Write file to H5, SWC, ASC or MorphIO binary (.morphio) format depending on filename "
             "extension",
             "filename"_a)
 
@@ -180,10 +357,12 @@ void bind_mutable_module(py::module& m) {
 
     py::class_<morphio::mut::GlialCell, morphio::mut::Morphology>(m, "GlialCell")
         .def(py::init<>())
-        .def(py::init<const std::string&>())
+        .def(py::init<const std::string&>(), py::call_guard<py::gil_scoped_release>())
         .def(py::init([](py::object arg) {
+                 const std::string filename = py::str(arg);
+                 py::gil_scoped_release release;
                  return std::unique_ptr<morphio::mut::GlialCell>(
-                     new morphio::mut::GlialCell(py::str(arg)));
+                     new morphio::mut::GlialCell(filename));
              }),
              "filename"_a,
              "Additional Ctor that accepts as filename any python "
@@ -361,34 +540,68 @@ void bind_mutable_module(py::module& m) {
             "(dendrite, axon, ...)")
         .def_property(
             "points",
-            [](morphio::mut::Section* section) {
-                return py::array(static_cast<py::ssize_t>(section->points().size()),
-                                 section->points().data());
+            [](const std::shared_ptr<morphio::mut::Section>& section) {
+                return points_view(section->points(), section_view_owner(section));
             },
-            [](morphio::mut::Section* section, py::array_t<morphio::floatType> _points) {
-                section->points() = array_to_points(_points);
+            [](morphio::mut::Section* section,
+               const contiguous_array<morphio::floatType>& _points) {
+                set_section_data(*section, [&_points](morphio::Property::PointLevel& level) {
+                    assign_points(level._points, _points);
+                });
             },
-            "Returns the coordinates (x,y,z) of all points of this section")
+            "Returns the coordinates (x,y,z) of all points of this section\n\n"
+            "The array is a writable view on the section data: modifying it modifies the "
+            "section. While such views are alive, the number of points of the section can not "
+            "change: setting points of another size raises a SectionBuilderError")
         .def_property(
             "diameters",
-            [](morphio::mut::Section* section) {
-                return py::array(static_cast<py::ssize_t>(section->diameters().size()),
-                                 section->diameters().data());
+            [](const std::shared_ptr<morphio::mut::Section>& section) {
+                return values_view(section->diameters(), section_view_owner(section));
             },
-            [](morphio::mut::Section* section, py::array_t<morphio::floatType> _diameters) {
-                section->diameters() = _diameters.cast<std::vector<morphio::floatType>>();
+            [](morphio::mut::Section* section,
+               const contiguous_array<morphio::floatType>& _diameters) {
+                set_section_data(*section, [&_diameters](morphio::Property::PointLevel& level) {
+                    assign_vector(level._diameters, _diameters);
+                });
             },
-            "Returns the diameters of all points of this section")
+            "Returns the diameters of all points of this section\n\n"
+            "The array is a writable view on the section data, see points")
         .def_property(
             "perimeters",
-            [](morphio::mut::Section* section) {
-                return py::array(static_cast<py::ssize_t>(section->perimeters().size()),
-                                 section->perimeters().data());
+            [](const std::shared_ptr<morphio::mut::Section>& section) {
+                return values_view(section->perimeters(), section_view_owner(section));
+            },
+            [](morphio::mut::Section* section,
+               const contiguous_array<morphio::floatType>& _perimeters) {
+                set_section_data(*section, [&_perimeters](morphio::Property::PointLevel& level) {
+                    assign_vector(level._perimeters, _perimeters);
+                });
             },
-            [](morphio::mut::Section* section, py::array_t<morphio::floatType> _perimeters) {
-                section->perimeters() = _perimeters.cast<std::vector<morphio::floatType>>();
+            "Returns the perimeters of all points of this section\n\n"
+            "The array is a writable view on the section data, see points")
+        .def(
+            "set_point_data",
+            [](morphio::mut::Section* section,
+               const contiguous_array<morphio::floatType>& points,
+               const contiguous_array<morphio::floatType>& diameters,
+               const contiguous_array<morphio::floatType>& perimeters) {
+                if (points.size() != 3 * diameters.size() ||
+                    (perimeters.size() != 0 && perimeters.size() != diameters.size())) {
+                    throw morphio::MorphioError(
+                        "set_point_data: points, diameters and perimeters (if any) must have "
+                        "the same length");
+                }
+                morphio::Property::PointLevel properties;
+                assign_points(properties._points, points);
+                assign_vector(properties._diameters, diameters);
+                assign_vector(properties._perimeters, perimeters);
+                section->setProperties(std::move(properties));
             },
-            "Returns the perimeters of all points of this section")
+            "Set the points, diameters and perimeters of the section at once\n"
+            "Contiguous float arrays are copied without any conversion",
+            "points"_a,
+            "diameters"_a,
+            "perimeters"_a = contiguous_array<morphio::floatType>())
         .def_property_readonly("is_root",
                                &morphio::mut::Section::isRoot,
                                "Return True if section is a root section")
@@ -456,22 +669,23 @@ void bind_mutable_module(py::module& m) {
         .def(py::init<const morphio::Property::PointLevel&>())
         .def_property(
             "points",
-            [](morphio::mut::Soma* soma) {
-                return py::array(static_cast<py::ssize_t>(soma->points().size()),
-                                 soma->points().data());
+            [](const std::shared_ptr<morphio::mut::Soma>& soma) {
+                return points_view(soma->points(), soma_view_owner(soma));
             },
-            [](morphio::mut::Soma* soma, py::array_t<morphio::floatType> _points) {
-                soma->points() = array_to_points(_points);
+            [](morphio::mut::Soma* soma, const contiguous_array<morphio::floatType>& _points) {
+                throw_if_resized(*soma, soma->points().size() * 3, _points.size());
+                assign_points(soma->points(), _points);
             },
-            "Returns the coordinates (x,y,z) of all soma point")
+            "Returns the coordinates (x,y,z) of all soma point\n\n"
+            "The array is a writable view on the soma data, see Section.points")
         .def_property(
             "diameters",
-            [](morphio::mut::Soma* soma) {
-                return py::array(static_cast<py::ssize_t>(soma->diameters().size()),
-                                 soma->diameters().data());
+            [](const std::shared_ptr<morphio::mut::Soma>& soma) {
+                return values_view(soma->diameters(), soma_view_owner(soma));
             },
-            [](morphio::mut::Soma* soma, py::array_t<morphio::floatType> _diameters) {
-                soma->diameters() = _diameters.cast<std::vector<morphio::floatType>>();
+            [](morphio::mut::Soma* soma, const contiguous_array<morphio::floatType>& _diameters) {
+                throw_if_resized(*soma, soma->diameters().size(), _diameters.size());
+                assign_vector(soma->diameters(), _diameters);
             },
             "Returns the diameters of all soma points")
         .def_property_readonly("type", &morphio::mut::Soma::type, "Returns the soma type")
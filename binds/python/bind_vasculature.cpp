@@ -14,10 +14,14 @@ void bind_vasculature(py::module& m) {
     using namespace py::literals;
 
     py::class_<morphio::vasculature::Vasculature>(m, "Vasculature")
-        .def(py::init<const std::string&>(), "filename"_a)
+        .def(py::init<const std::string&>(),
+             "filename"_a,
+             py::call_guard<py::gil_scoped_release>())
         .def(py::init([](py::object arg) {
+                 const std::string filename = py::str(arg);
+                 py::gil_scoped_release release;
                  return std::unique_ptr<morphio::vasculature::Vasculature>(
-                     new morphio::vasculature::Vasculature(py::str(arg)));
+                     new morphio::vasculature::Vasculature(filename));
              }),
              "filename"_a,
              "Additional Ctor that accepts as filename any python object that implements __repr__ "
@@ -38,23 +42,23 @@ void bind_vasculature(py::module& m) {
         // Property accessors
         .def_property_readonly(
             "points",
-            [](morphio::vasculature::Vasculature* morpho) {
-                return py::array(static_cast<py::ssize_t>(morpho->points().size()),
-                                 morpho->points().data());
+            [](py::object self) {
+                const auto& data = self.cast<const morphio::vasculature::Vasculature&>().points();
+                return points_to_ndarray(data.data(), data.size(), self);
             },
             "Returns a list with all points from all sections")
         .def_property_readonly(
             "diameters",
-            [](morphio::vasculature::Vasculature* morpho) {
-                auto diameters = morpho->diameters();
-                return py::array(static_cast<py::ssize_t>(diameters.size()), diameters.data());
+            [](py::object self) {
+                return vector_to_ndarray(
+                    self.cast<const morphio::vasculature::Vasculature&>().diameters(), self);
             },
             "Returns a list with all diameters from all sections")
         .def_property_readonly(
             "section_types",
-            [](morphio::vasculature::Vasculature* obj) {
-                auto data = obj->sectionTypes();
-                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            [](py::object self) {
+                return vector_to_ndarray(
+                    self.cast<const morphio::vasculature::Vasculature&>().sectionTypes(), self);
             },
             "Returns a vector with the section type of every section")
 
@@ -91,14 +95,16 @@ void bind_vasculature(py::module& m) {
                                "Returns the morphological type of this section")
         .def_property_readonly(
             "points",
-            [](morphio::vasculature::Section* section) {
-                return span_array_to_ndarray(section->points());
+            [](py::object self) {
+                return span_array_to_ndarray(
+                    self.cast<const morphio::vasculature::Section&>().points(), self);
             },
             "Returns list of section's point coordinates")
         .def_property_readonly(
             "diameters",
-            [](morphio::vasculature::Section* section) {
-                return span_to_ndarray(section->diameters());
+            [](py::object self) {
+                return span_to_ndarray(
+                    self.cast<const morphio::vasculature::Section&>().diameters(), self);
             },
             "Returns list of section's point diameters")
 
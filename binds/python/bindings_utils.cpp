@@ -5,6 +5,7 @@
 #include <pybind11/numpy.h>  // py::array_t
 
 #include <array>
+#include <cstring>  // std::memcpy
 #include <string>
 #include <utility>  // std::move
 
@@ -30,33 +31,36 @@ void _raise_if_wrong_shape(const py::buffer_info& info) {
 }
 }  // anonymous namespace
 
-morphio::Points array_to_points(py::array_t<morphio::floatType>& buf) {
-    morphio::Points points;
-    py::buffer_info info = buf.request();
-    _raise_if_wrong_shape(info);
-
-    for (int i = 0; i < info.shape[0]; ++i) {
-        points.push_back(
-            std::array<morphio::floatType, 3>{*buf.data(i, 0), *buf.data(i, 1), *buf.data(i, 2)});
+morphio::Points contiguous_array_to_points(
+    const contiguous_array<morphio::floatType>& buf) {
+    if (buf.size() == 0) {
+        return {};
     }
+    _raise_if_wrong_shape(buf.request());
+
+    morphio::Points points(static_cast<size_t>(buf.shape(0)));
+    std::memcpy(points.data(), buf.data(), sizeof(morphio::floatType) * 3 * points.size());
     return points;
 }
 
-py::array_t<morphio::floatType> span_array_to_ndarray(
-    const morphio::range<const std::array<morphio::floatType, 3>>& span) {
-    const void* ptr = static_cast<const void*>(span.data());
-    const auto buffer_info = py::buffer_info(
-        // Cast from (const void*) to (void*) for function signature matching
-        const_cast<void*>(ptr),                              /* Pointer to buffer */
-        sizeof(morphio::floatType),                          /* Size of one scalar */
-        py::format_descriptor<morphio::floatType>::format(), /* Python struct-style format
-                                                                descriptor */
-        2,                                                   /* Number of dimensions */
-
-        // Forced cast to prevent error:
-        // template argument deduction/substitution failed */
-        {static_cast<int>(span.size()), 3}, /* buffer dimentions */
-        {sizeof(morphio::floatType) * 3,    /* Strides (in bytes) for each index */
-         sizeof(morphio::floatType)});
-    return py::array(buffer_info);
+void assign_points(morphio::Points& points, const contiguous_array<morphio::floatType>& buf) {
+    if (buf.size() == 0) {
+        points.clear();
+        return;
+    }
+    _raise_if_wrong_shape(buf.request());
+
+    points.resize(static_cast<size_t>(buf.shape(0)));
+    std::memcpy(points.data(), buf.data(), sizeof(morphio::floatType) * 3 * points.size());
+}
+
+std::vector<morphio::SectionType> contiguous_array_to_section_types(
+    const contiguous_array<int>& buf) {
+    const auto values = contiguous_array_to_vector<int>(buf);
+    std::vector<morphio::SectionType> types;
+    types.reserve(values.size());
+    for (int value : values) {
+        types.push_back(static_cast<morphio::SectionType>(value));
+    }
+    return types;
 }
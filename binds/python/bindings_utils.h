@@ -3,31 +3,108 @@
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <string>
+#include <vector>
+
+#include <morphio/exceptions.h>
 #include <morphio/types.h>
 
 namespace py = pybind11;
 
-morphio::Points array_to_points(py::array_t<morphio::floatType>& buf);
-py::array_t<morphio::floatType> span_array_to_ndarray(
-    const morphio::range<const morphio::Point>& span);
+/** A numpy array that pybind11 converts to a C-contiguous buffer of T (copying only if needed) */
+template <typename T>
+using contiguous_array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/**
+   The load_options argument of the bindings, None by default: LoadOptions built when the module
+   is imported would keep the I/O policy of that time instead of the one set with set_io_policy
+**/
+inline morphio::LoadOptions load_options_or_default(const py::object& load_options) {
+    return load_options.is_none() ? morphio::LoadOptions()
+                                  : load_options.cast<morphio::LoadOptions>();
+}
+
+/** Copy a contiguous (X, 3) array into Points with a single memcpy **/
+morphio::Points contiguous_array_to_points(const contiguous_array<morphio::floatType>& buf);
+
+/**
+   Copy a contiguous (X, 3) array into points with a single memcpy
+
+   The storage of points is reused when their number does not change, so that the views
+   on it stay valid.
+**/
+void assign_points(morphio::Points& points, const contiguous_array<morphio::floatType>& buf);
+
+/** Convert a 1D array of integers into section types **/
+std::vector<morphio::SectionType> contiguous_array_to_section_types(
+    const contiguous_array<int>& buf);
+
+/** Copy a contiguous 1D array into a std::vector in a single pass **/
+template <typename T>
+std::vector<T> contiguous_array_to_vector(const contiguous_array<T>& buf) {
+    if (buf.ndim() > 1) {
+        throw morphio::MorphioError("Wrong array shape. Expected a 1D array, got " +
+                                    std::to_string(buf.ndim()) + " dimensions");
+    }
+    return std::vector<T>(buf.data(), buf.data() + buf.size());
+}
+
+/** Copy a contiguous 1D array into values, reusing their storage as assign_points does **/
+template <typename T>
+void assign_vector(std::vector<T>& values, const contiguous_array<T>& buf) {
+    if (buf.ndim() > 1) {
+        throw morphio::MorphioError("Wrong array shape. Expected a 1D array, got " +
+                                    std::to_string(buf.ndim()) + " dimensions");
+    }
+    values.assign(buf.data(), buf.data() + buf.size());
+}
+
+/**
+   A read-only numpy view on the C-contiguous data of the given shape
+
+   No copy is made: `owner`, the Python object owning the data, becomes the base of the array
+   and is kept alive as long as the array.
+**/
+template <typename T>
+py::array_t<T> readonly_ndarray(const T* data, std::vector<py::ssize_t> shape, py::handle owner) {
+    py::array_t<T> array(std::move(shape), data, owner);
+    py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return array;
+}
+
+/**
+   A writable numpy view on the C-contiguous data of the given shape, kept alive by `owner`
+
+   The view is only valid as long as the storage of the data is not reallocated.
+**/
+template <typename T>
+py::array_t<T> writable_ndarray(T* data, std::vector<py::ssize_t> shape, py::handle owner) {
+    return py::array_t<T>(std::move(shape), data, owner);
+}
+
+/** A read-only (N, 3) view on points owned by `owner` **/
+inline py::array_t<morphio::floatType> points_to_ndarray(const morphio::Point* data,
+                                                         size_t size,
+                                                         py::handle owner) {
+    return readonly_ndarray(reinterpret_cast<const morphio::floatType*>(data),
+                            {static_cast<py::ssize_t>(size), 3},
+                            owner);
+}
+
+inline py::array_t<morphio::floatType> span_array_to_ndarray(
+    const morphio::range<const morphio::Point>& span, py::handle owner) {
+    return points_to_ndarray(span.data(), span.size(), owner);
+}
 
 template <typename T>
-py::array_t<morphio::floatType> span_to_ndarray(const morphio::range<const T>& span) {
-    const void* ptr = static_cast<const void*>(span.data());
-    const auto buffer_info = py::buffer_info(
-        // Cast from (const void*) to (void*) for function signature matching
-        const_cast<void*>(ptr),             /* Pointer to buffer */
-        sizeof(T),                          /* Size of one scalar */
-        py::format_descriptor<T>::format(), /* Python struct-style format descriptor */
-        1,                                  /* Number of dimensions */
-
-        // Forced cast to prevent error:
-        // template argument deduction/substitution failed */
-        {static_cast<int>(span.size())}, /* buffer dimentions */
-        {sizeof(T)});                    /* Strides (in bytes) for each index */
-    return py::array(buffer_info);
+py::array_t<T> span_to_ndarray(const morphio::range<const T>& span, py::handle owner) {
+    return readonly_ndarray(span.data(), {static_cast<py::ssize_t>(span.size())}, owner);
 }
 
+template <typename T>
+py::array_t<T> vector_to_ndarray(const std::vector<T>& data, py::handle owner) {
+    return readonly_ndarray(data.data(), {static_cast<py::ssize_t>(data.size())}, owner);
+}
 
 /**
  * @brief "Casts" a Cpp sequence to a python array (no memory copies)
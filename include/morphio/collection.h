@@ -0,0 +1,164 @@
+#pragma once
+
+#include <functional>  // std::function
+#include <memory>      // std::shared_ptr
+#include <string>      // std::string
+#include <vector>      // std::vector
+
+#include <morphio/morphology.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/** What the index of a collection records about one of its morphologies **/
+struct CollectionEntry {
+    std::string name;
+    /** The file name in a directory, the group in a container or the member in an archive **/
+    std::string location;
+    /** "h5", "swc" or "asc" **/
+    std::string format;
+    /** Address of the points in a container, of the member in an archive, 0 in a directory **/
+    uint64_t offset = 0;
+    /** Size in bytes of the file, or of the member in an archive, 0 in a container **/
+    uint64_t size = 0;
+    /** Modification time of the file in a directory, in seconds since the epoch, 0 otherwise **/
+    int64_t modificationTime = 0;
+    uint32_t nSections = 0;
+    uint64_t nPoints = 0;
+    /** Bounding box of the points of the soma and the neurites **/
+    Point boundingBoxMin{};
+    Point boundingBoxMax{};
+};
+
+/**
+   A collection of morphologies stored either as files in a directory, as groups of
+   a single HDF5 container or as members of a tar archive
+
+   The collection is opened once: the directory listing, the list of groups of the
+   container, or the headers of the archive, are read at construction time and indexed by
+   morphology name. Loading a morphology then only reads its data:
+   - HDF5 files stay open in a pool of handles, so loading the same file again does not
+     reopen it. A container is opened once for the lifetime of the collection.
+   - Loaded morphologies can be kept in a cache. As morphologies are immutable, the
+     cached data is shared between all the Morphology objects returned for a name.
+   - Members of an archive are read straight from their byte range in the archive, which is
+     never extracted.
+
+   A Collection can be shared between threads.
+**/
+class Collection
+{
+  public:
+    /**
+       Open a collection of morphologies
+
+       collectionPath is either a directory of morphology files, an HDF5 container
+       file with one group per morphology, or an uncompressed tar archive of morphology files.
+
+       In a directory, the name of a morphology is its file name without the extension.
+       When a name exists with several extensions, the first one of `extensions` wins.
+       In an archive, it is the path of the member without the extension (ex: dir/name).
+       In a container, morphologies are the groups holding a structure dataset, possibly
+       nested in other groups. Their name is their path in the container (ex: 00/00/name).
+
+       cacheSize is the number of loaded morphologies to keep around, 0 disables the
+       cache. maxOpenFiles bounds the number of HDF5 files of a directory kept open.
+
+       indexPath is the sidecar index written by writeIndex, by default collectionPath followed
+       by ".morphio-index". When it exists, was built with the same extensions and the
+       collection was not modified since (same size and modification time), it replaces the
+       directory listing, the walk of the groups of the container or the read of the headers
+       of the archive. Otherwise, it is ignored.
+    **/
+    explicit Collection(const std::string& collectionPath,
+                        size_t cacheSize = 0,
+                        size_t maxOpenFiles = 64,
+                        std::vector<std::string> extensions = {".h5", ".swc", ".asc"},
+                        const std::string& indexPath = "");
+
+    ~Collection();
+
+    /**
+       Load the morphology with the given name
+
+       Throws a RawDataError if the collection has no such morphology, or if it is the member
+       of an archive that was rewritten since its index was written
+    **/
+    Morphology load(const std::string& morphName, unsigned int options = NO_MODIFIER) const;
+
+    /**
+       Return true if the collection has a morphology with the given name
+    **/
+    bool contains(const std::string& morphName) const;
+
+    /**
+       Return the names of all morphologies, in on-disk order
+
+       Loading the morphologies in this order reads the storage sequentially:
+       - in a directory, files are sorted by inode number, which is how most file
+         systems allocate them;
+       - in a container, groups are sorted by the address of their points in the file;
+       - in an archive, members are in archive order.
+    **/
+    const std::vector<std::string>& names() const noexcept;
+
+    /**
+       Return the number of morphologies in the collection
+    **/
+    size_t size() const noexcept;
+
+    /**
+       Return the path of the file holding the given morphology: either its own file, the
+       container or the archive
+    **/
+    std::string path(const std::string& morphName) const;
+
+    /**
+       Load every morphology to write the sidecar index of the collection, to indexPath or to
+       the default path of the constructor. The collection then uses it for entry and select.
+       The index of a directory must be written outside of it: adding a file to the directory
+       would modify it, making the index stale.
+
+       @throw RawDataError if a morphology cannot be loaded or the index cannot be written
+    **/
+    void writeIndex(const std::string& indexPath = "");
+
+    /**
+       Return true if the collection was opened with, or has written, its sidecar index
+    **/
+    bool hasIndex() const noexcept;
+
+    /**
+       Return what the index records about the given morphology, without reading it
+
+       The index is only checked as a whole, when the collection is opened. With validate, the
+       entry is also checked against the morphology: the size and modification time of its file
+       in a directory, the header of its member in an archive. This touches the file of the
+       morphology; a container cannot be checked this way.
+
+       Throws a RawDataError if the collection has no index or no such morphology, or if
+       validate is set and the morphology was modified since the index was written
+    **/
+    const CollectionEntry& entry(const std::string& morphName, bool validate = false) const;
+
+    /**
+       Return the names of the morphologies whose entry matches the predicate, in on-disk
+       order, without reading any morphology
+
+           collection.select([](const CollectionEntry& e) { return e.nSections > 1000; });
+
+       With validate, the matching entries are checked as in entry(): the others are not, so
+       that a query does not touch every file of the collection.
+
+       Throws a RawDataError if the collection has no index, or if validate is set and a
+       matching morphology was modified since the index was written
+    **/
+    std::vector<std::string> select(const std::function<bool(const CollectionEntry&)>& predicate,
+                                    bool validate = false) const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> _impl;
+};
+
+}  // namespace morphio
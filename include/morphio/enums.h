@@ -110,5 +110,15 @@ enum AccessMode {
     MODE_READOVERWRITE = MODE_READ | MODE_OVERWRITE
 };
 
+/**
+   How morphology files are read from disk, see LoadOptions::ioPolicy and morphio::setIOPolicy
+**/
+enum IOPolicy {
+    IO_DEFAULT,    //!< each reader issues its own reads, e.g. many small ones for HDF5
+    IO_READAHEAD,  //!< as IO_DEFAULT, after asking the kernel to prefetch the whole file
+    IO_SLURP,      //!< the whole file is read in memory with a single large request
+    IO_MMAP        //!< the file is mapped in memory and parsed from the mapping
+};
+
 }  // namespace enums
 }  // namespace morphio
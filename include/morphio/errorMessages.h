@@ -44,8 +44,6 @@ struct DebugInfo {
     std::map<unsigned int, int> _lineNumbers;
 };
 
-static std::set<Warning> _ignoredWarnings;
-
 struct Sample {
     Sample()
         : valid(false)
@@ -196,7 +194,14 @@ class ErrorMessages
     std::string WARNING_DISCONNECTED_NEURITE(const Sample& sample) const;
     std::string WARNING_WRONG_DUPLICATE(const std::shared_ptr<morphio::mut::Section>& current,
                                         const std::shared_ptr<morphio::mut::Section>& parent) const;
+    std::string WARNING_WRONG_DUPLICATE(uint32_t currentId,
+                                        uint32_t parentId,
+                                        range<const Point> currentPoints,
+                                        range<const floatType> currentDiameters,
+                                        range<const Point> parentPoints,
+                                        range<const floatType> parentDiameters) const;
     std::string WARNING_APPENDING_EMPTY_SECTION(std::shared_ptr<morphio::mut::Section>);
+    std::string WARNING_APPENDING_EMPTY_SECTION(uint32_t sectionId) const;
     std::string WARNING_ONLY_CHILD(const DebugInfo& info,
                                    unsigned int parentId,
                                    unsigned int childId) const;
@@ -211,6 +216,26 @@ class ErrorMessages
     std::string _uri;
 };
 
+/**
+   Ignore a warning on the current thread only, while the object is alive
+
+   Unlike set_ignored_warning, it does not affect the other threads: readers use it to
+   silence warnings that are expected while building a morphology.
+**/
+class ScopedIgnoredWarning
+{
+  public:
+    explicit ScopedIgnoredWarning(Warning warning);
+    ~ScopedIgnoredWarning();
+
+    ScopedIgnoredWarning(const ScopedIgnoredWarning&) = delete;
+    ScopedIgnoredWarning& operator=(const ScopedIgnoredWarning&) = delete;
+
+  private:
+    Warning _warning;
+    bool _inserted;
+};
+
 }  // namespace readers
 
 }  // namespace morphio
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   Set how morphology files are read by the next loads whose LoadOptions do not say otherwise,
+   IO_DEFAULT by default: this is the default of LoadOptions::ioPolicy
+
+   On parallel filesystems, each read request is expensive: the HDF5 library issues many small
+   reads per morphology, and the text readers read through small stream buffers. IO_SLURP reads
+   the file with one large request and parses it from memory, HDF5 files being opened as a
+   file image. IO_MMAP maps the file instead. IO_READAHEAD keeps the readers' own reads, after
+   asking the kernel to prefetch the whole file with posix_fadvise.
+
+   gzip compressed files are always decompressed on the fly, only IO_READAHEAD applies to them.
+   The policy is shared by all the threads of the process: set LoadOptions::ioPolicy instead to
+   read some files differently. getIOPolicy is declared in types.h.
+**/
+void setIOPolicy(IOPolicy policy);
+
+/** The input/output done while loading a morphology file **/
+struct IOStats {
+    /** Bytes returned by read system calls, whether they hit the page cache or not **/
+    uint64_t bytesRead = 0;
+    /** Number of read system calls **/
+    uint64_t readCalls = 0;
+    /** Bytes of the file mapped in memory: pages of a mapping are not read by read calls **/
+    uint64_t bytesMapped = 0;
+};
+
+/**
+   Collect the IOStats of the loads of morphology files, disabled by default
+
+   Statistics are measured by the operating system for the loading thread, so they include
+   the reads of the HDF5 library. They are only available on Linux: elsewhere they stay zero.
+   Collecting them costs two reads of /proc per load.
+**/
+void enableIOStats(bool enable = true);
+
+/**
+   Return the IOStats of the last morphology file loaded by the calling thread while
+   statistics were collected, whether the load succeeded or not
+**/
+IOStats lastIOStats();
+
+}  // namespace morphio
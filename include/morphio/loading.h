@@ -0,0 +1,130 @@
+#pragma once
+
+#include <deque>       // std::deque
+#include <functional>  // std::function
+#include <future>      // std::future
+#include <string>      // std::string
+#include <vector>      // std::vector
+
+#include <morphio/morphology.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   Load a batch of morphologies with a pool of nThreads threads (0: one per hardware thread)
+
+   Morphologies are returned in the order of `paths`.
+
+   The HDF5 library is not thread-safe: the raw reads of HDF5 files are serialized behind a
+   single lock, while everything else (validation, modifiers, building the section tree)
+   runs in parallel. SWC and ASC files are parsed fully in parallel.
+
+   If some morphologies fail to load, all the others are still loaded and the error of the
+   first failing path (in the order of `paths`) is rethrown.
+**/
+std::vector<Morphology> loadMany(const std::vector<std::string>& paths,
+                                 unsigned int options = NO_MODIFIER,
+                                 unsigned int nThreads = 0,
+                                 const LoadOptions& loadOptions = {});
+
+/**
+   Streaming counterpart of loadMany: callback(index, morphology) is called for each
+   morphology as soon as it is loaded, with index its position in `paths`
+
+   The callback is called concurrently from the worker threads, in no particular order.
+   Errors, including the ones raised by the callback, are handled as in loadMany.
+**/
+void loadMany(const std::vector<std::string>& paths,
+              unsigned int options,
+              unsigned int nThreads,
+              const std::function<void(size_t, Morphology&&)>& callback,
+              const LoadOptions& loadOptions = {});
+
+/**
+   Load a morphology in a background thread
+
+   The file is read in the background: the calling thread only blocks when calling get()
+   on the returned future. Errors are raised by get().
+**/
+std::future<Morphology> loadAsync(const std::string& path,
+                                  unsigned int options = NO_MODIFIER,
+                                  const LoadOptions& loadOptions = {});
+
+/**
+   Load an ordered list of morphologies ahead of the code consuming them
+
+   Up to `depth` morphologies are loaded in background threads while the previous ones are
+   being processed, so at most `depth` loaded morphologies wait in memory at any time. The
+   files of the next `depth` paths are also announced to the kernel (posix_fadvise), so that
+   their reads are under way before their loads start.
+
+       morphio::Prefetcher prefetcher(paths);
+       while (prefetcher.hasNext()) {
+           morphio::Morphology morph = prefetcher.next();
+           ...
+       }
+
+   A Prefetcher must be consumed from a single thread.
+**/
+class Prefetcher
+{
+  public:
+    explicit Prefetcher(std::vector<std::string> paths,
+                        unsigned int options = NO_MODIFIER,
+                        size_t depth = 4,
+                        const LoadOptions& loadOptions = {});
+
+    /**
+       Wait for the loads already launched, see cancel()
+    **/
+    ~Prefetcher();
+
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    /**
+       Return true if next() has more morphologies to return
+    **/
+    bool hasNext() const noexcept;
+
+    /**
+       Return the next morphology, blocking until it is loaded
+
+       Errors raised while loading it are rethrown here, the following morphologies can
+       still be retrieved. Throws a MorphioError if there is no next morphology.
+    **/
+    Morphology next();
+
+    /**
+       Stop the iteration: hasNext() returns false and no other load is launched
+
+       This does not interrupt any load: each of the (up to `depth`) loads launched ahead of
+       the iteration runs in its own thread from the moment it is launched, and completes in
+       the background. Their results are discarded.
+    **/
+    void cancel() noexcept;
+
+    /**
+       The index, in the list of paths, of the morphology returned by the next call to next()
+    **/
+    size_t position() const noexcept;
+
+  private:
+    void _fill();
+
+    std::vector<std::string> _paths;
+    unsigned int _options;
+    size_t _depth;
+    LoadOptions _loadOptions;
+
+    // Index of the next path to load, and of the next path to announce to the kernel
+    size_t _nextLoad = 0;
+    size_t _nextHint = 0;
+    size_t _position = 0;
+
+    bool _cancelled = false;
+    std::deque<std::future<Morphology>> _loading;
+};
+
+}  // namespace morphio
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <map>
+
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace modifiers {
+/**
+   Flat-array counterparts of the morphio::mut::modifiers
+
+   They operate directly on the Property::Properties of an immutable morphology,
+   without building any mut::Section. Each of them writes compacted output arrays
+   in a single pass over the input arrays: the output offset of every section is
+   known before any point is copied, so sections are independent of each other.
+
+   Neurite sections are renumbered in depth first order (the order
+   mut::Morphology::buildReadOnly produces) and unreachable sections are dropped.
+   The `_children` maps are cleared and must be rebuilt by the caller.
+**/
+
+/**
+   Per section type parameter of the resample and simplify modifiers.
+   Sections whose type is not a key are left untouched.
+**/
+using SectionTypeParameters = std::map<SectionType, floatType>;
+
+/**
+   Only the first and last points of each sections are kept
+**/
+void two_points_sections(Property::Properties& properties);
+
+/**
+   Remove duplicated points
+**/
+void no_duplicate_point(Property::Properties& properties);
+
+/**
+   Reduce the soma to a sphere placed at the center of gravity of soma points
+   and whose radius is the averaged distance between the soma points and the
+center of gravity
+**/
+void soma_sphere(Property::Properties& properties);
+
+/**
+   Sort the root sections by section type (stable sort)
+**/
+void nrn_order(Property::Properties& properties);
+
+/**
+   Resample each section uniformly along its path length
+
+   Sections get the smallest number of equally spaced points whose spacing does not
+   exceed `spacing`. Their first and last points are kept as is, the other points,
+   diameters and perimeters are linearly interpolated along the original polyline.
+
+   Throws a MorphioError, before any modification, if a spacing is not strictly positive.
+**/
+void resample(Property::Properties& properties, floatType spacing);
+void resample(Property::Properties& properties, const SectionTypeParameters& spacings);
+
+/**
+   Ramer-Douglas-Peucker simplification of each section
+
+   Removes points as long as the error stays within `tolerance`. The error of a removed
+   point is the largest of its distance to the simplified polyline and of the
+   difference between its radius and the radius interpolated on that polyline.
+   The first and last points of each section are always kept.
+
+   Throws a MorphioError, before any modification, if a tolerance is negative.
+**/
+void simplify(Property::Properties& properties, floatType tolerance);
+void simplify(Property::Properties& properties, const SectionTypeParameters& tolerances);
+
+/**
+   Apply all the modifiers of `modifierFlags` (see morphio::enums::Option) at once
+
+   Sanity warnings (empty sections, wrong duplicate points) are reported the same
+   way as when copying the morphology into a mut::Morphology, and mitochondrial
+   sections are renumbered in the order mut::Mitochondria writes them.
+**/
+void apply(Property::Properties& properties, unsigned int modifierFlags);
+
+/**
+   Whether apply(properties, NO_MODIFIER) leaves the sections untouched: they are in depth
+   first order, their points contiguous and the first one starts at offset 0
+**/
+bool isCompact(const Property::Properties& properties);
+
+}  // namespace modifiers
+}  // namespace morphio
@@ -34,13 +34,82 @@ class Morphology
         options is the modifier flags to be applied. All flags are defined in
        their enum: morphio::enum::Option and can be composed.
 
+        loadOptions selects the payloads and the neurites to read, see morphio::LoadOptions.
+
         Example:
             Morphology("neuron.asc", TWO_POINTS_SECTIONS | SOMA_SPHERE);
      */
-    explicit Morphology(const std::string& source, unsigned int options = NO_MODIFIER);
-    explicit Morphology(const HighFive::Group& group, unsigned int options = NO_MODIFIER);
+    explicit Morphology(const std::string& source,
+                        unsigned int options = NO_MODIFIER,
+                        const LoadOptions& loadOptions = {});
+    explicit Morphology(const HighFive::Group& group,
+                        unsigned int options = NO_MODIFIER,
+                        const LoadOptions& loadOptions = {});
     explicit Morphology(mut::Morphology);
 
+    /**
+       Build a morphology from flat arrays
+
+       The vectors are adopted (moved), not copied: pass them with std::move to
+       avoid any copy of the point data.
+
+       Section i spans the points [sectionOffsets[i], sectionOffsets[i + 1]) of
+       points, diameters and perimeters. perimeters can be empty. sectionOffsets
+       can optionally end with points.size(), as returned by sectionOffsets().
+       sectionParents[i] is -1 for root sections, otherwise the ID of a section
+       preceding section i.
+
+       The soma type is deduced from the number of soma points, as for H5 files.
+       Modifiers in options are applied as when loading an H5 file, in which case
+       sections are renumbered depth first.
+
+       @throw RawDataError if the arrays are inconsistent
+    **/
+    static Morphology fromArrays(Points points,
+                                 std::vector<floatType> diameters,
+                                 std::vector<floatType> perimeters,
+                                 std::vector<uint32_t> sectionOffsets,
+                                 std::vector<int32_t> sectionParents,
+                                 std::vector<SectionType> sectionTypes,
+                                 Points somaPoints = {},
+                                 std::vector<floatType> somaDiameters = {},
+                                 unsigned int options = NO_MODIFIER);
+
+    /**
+       Load a morphology from a memory buffer holding the content of a file, without touching
+       the disk
+
+       format is the format of the content: "swc", "asc", "h5" or "morphio", as the extension of
+       the file would be. SWC and ASC contents are parsed in place, HDF5 contents are opened as
+       a file image, with the core driver. Modifiers are applied as when loading a file.
+
+       @throw RawDataError if the content cannot be parsed
+       @throw UnknownFileType if the format is not supported
+    **/
+    static Morphology fromBuffer(const char* data,
+                                 size_t size,
+                                 const std::string& format,
+                                 unsigned int options = NO_MODIFIER,
+                                 const LoadOptions& loadOptions = {});
+
+    /**
+       Encode the morphology in a compact binary buffer, to send it to another process
+
+       Every array is stored contiguously, so serializing and deserializing cost about one
+       memcpy of the data. The buffer can only be read by deserialize() on a platform with the
+       same byte order and floating point precision.
+    **/
+    std::vector<char> serialize() const;
+
+    /**
+       Rebuild a morphology from a buffer returned by serialize()
+
+       Modifiers are not applied again: the morphology is identical to the serialized one.
+
+       @throw RawDataError if the buffer is not a valid serialized morphology
+    **/
+    static Morphology deserialize(const char* data, size_t size);
+
     /**
      * Return the soma object
      **/
@@ -87,8 +156,10 @@ class Morphology
     /**
      * Return a vector with all points from all sections
      * (soma points are not included)
+     *
+     * The points of a morphology loaded lazily are all read by the first call.
      **/
-    const Points& points() const noexcept;
+    const Points& points() const;
 
     /**
      * Returns a list with offsets to access data of a specific section in the points
@@ -125,6 +196,51 @@ class Morphology
      **/
     const std::map<int, std::vector<unsigned int>>& connectivity() const;
 
+    /** @{
+       Section level tables, one value per section, computed from the flat arrays without
+       creating any Section object
+    **/
+
+    /**
+     * Return the parent ID of every section, -1 for root sections
+     **/
+    std::vector<int32_t> sectionParents() const;
+
+    /**
+     * Return the number of points of every section
+     **/
+    std::vector<uint32_t> sectionPointCounts() const;
+
+    /**
+     * Return the length of every section: the sum of the distances between its
+     * consecutive points
+     **/
+    std::vector<floatType> sectionLengths() const;
+
+    /**
+     * Return the IDs of the root sections, the sections connected to the soma
+     **/
+    std::vector<uint32_t> rootSectionIds() const;
+
+    /**
+     * Return the children of every section in compressed sparse row format: (offsets, ids)
+     *
+     * The children of section i are ids[offsets[i]] to ids[offsets[i+1]-1], in increasing
+     * order. offsets has one more element than there are sections.
+     **/
+    std::pair<std::vector<uint32_t>, std::vector<uint32_t>> sectionChildren() const;
+
+    /**
+     * Return the IDs of all sections in the order of depth_begin()
+     **/
+    std::vector<uint32_t> sectionIdsDepthFirst() const;
+
+    /**
+     * Return the IDs of all sections in the order of breadth_begin()
+     **/
+    std::vector<uint32_t> sectionIdsBreadthFirst() const;
+    /** @} */
+
 
     /**
        Depth first iterator starting at a given section id
@@ -160,11 +276,23 @@ class Morphology
 
   protected:
     friend class mut::Morphology;
-    Morphology(const Property::Properties& properties, unsigned int options);
+    friend class Collection;
+    friend class SharedStore;
+    Morphology(Property::Properties properties,
+               unsigned int options,
+               const LoadOptions& loadOptions = {});
+
+    /**
+       Another view on already built properties: used to share cached morphologies
+    **/
+    explicit Morphology(std::shared_ptr<Property::Properties> properties);
 
     std::shared_ptr<Property::Properties> _properties;
 
     template <typename Property>
     const std::vector<typename Property::Type>& get() const;
+
+    /** The point level of the neurites, read first when they are loaded lazily **/
+    const Property::PointLevel& _pointLevel() const;
 };
 }  // namespace morphio
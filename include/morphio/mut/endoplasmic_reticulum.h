@@ -19,7 +19,9 @@ class EndoplasmicReticulum
                          const std::vector<morphio::floatType>& surfaceAreas,
                          const std::vector<uint32_t>& filamentCounts);
     EndoplasmicReticulum(const EndoplasmicReticulum& endoplasmicReticulum);
+    EndoplasmicReticulum(EndoplasmicReticulum&& endoplasmicReticulum) noexcept = default;
     EndoplasmicReticulum(const morphio::EndoplasmicReticulum& endoplasmicReticulum);
+    EndoplasmicReticulum& operator=(const EndoplasmicReticulum& endoplasmicReticulum) = default;
 
 
     /**
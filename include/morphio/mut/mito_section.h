@@ -56,6 +56,8 @@ class MitoSection
     /** @} */
 
   private:
+    friend class Mitochondria;
+
     uint32_t _id;
 
     Mitochondria* _mitochondria;
@@ -32,6 +32,11 @@ class Mitochondria
   public:
     Mitochondria()
         : _counter(0) {}
+    Mitochondria(const Mitochondria&) = default;
+    Mitochondria& operator=(const Mitochondria&) = default;
+
+    /** The sections are moved, with their IDs, and now belong to this instance **/
+    Mitochondria(Mitochondria&& mitochondria) noexcept;
 
     const std::vector<MitoSectionP>& children(const MitoSectionP&) const;
     const MitoSectionP& section(uint32_t id) const;
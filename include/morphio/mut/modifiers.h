@@ -1,5 +1,6 @@
 #pragma once
 
+#include <morphio/modifiers.h>
 #include <morphio/types.h>
 
 namespace morphio {
@@ -24,6 +25,24 @@ void soma_sphere(morphio::mut::Morphology& morpho);
 
 void nrn_order(morphio::mut::Morphology& morpho);
 
+/**
+   Resample each section uniformly along its path length
+
+   See morphio::modifiers::resample
+**/
+void resample(morphio::mut::Morphology& morpho, floatType spacing);
+void resample(morphio::mut::Morphology& morpho,
+              const morphio::modifiers::SectionTypeParameters& spacings);
+
+/**
+   Ramer-Douglas-Peucker simplification of each section, accounting for diameter changes
+
+   See morphio::modifiers::simplify
+**/
+void simplify(morphio::mut::Morphology& morpho, floatType tolerance);
+void simplify(morphio::mut::Morphology& morpho,
+              const morphio::modifiers::SectionTypeParameters& tolerances);
+
 }  // namespace modifiers
 
 }  // namespace mut
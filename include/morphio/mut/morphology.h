@@ -38,16 +38,27 @@ class Morphology
        options is the modifier flags to be applied. All flags are defined in
     their enum: morphio::enum::Option and can be composed.
 
+       loadOptions selects the payloads and the neurites to read, see morphio::LoadOptions.
+
        Example:
            Morphology("neuron.asc", TWO_POINTS_SECTIONS | SOMA_SPHERE);
     **/
-    Morphology(const std::string& uri, unsigned int options = NO_MODIFIER);
+    Morphology(const std::string& uri,
+               unsigned int options = NO_MODIFIER,
+               const LoadOptions& loadOptions = {});
 
     /**
        Build a mutable Morphology from a mutable morphology
     **/
     Morphology(const morphio::mut::Morphology& morphology, unsigned int options = NO_MODIFIER);
 
+    /**
+       Move the sections of a mutable morphology, which keep their IDs
+
+       morphology is left without sections, soma nor cell properties: it can only be destroyed
+    **/
+    Morphology(morphio::mut::Morphology&& morphology) noexcept;
+
     /**
        Build a mutable Morphology from a read-only morphology
     **/
@@ -55,6 +66,22 @@ class Morphology
 
     virtual ~Morphology();
 
+    /**
+       Build a mutable morphology from flat arrays
+
+       Same arguments and validation as morphio::Morphology::fromArrays. Sections keep
+       the IDs they have in the arrays. No sanity warning is issued.
+    **/
+    static Morphology fromArrays(Points points,
+                                 std::vector<floatType> diameters,
+                                 std::vector<floatType> perimeters,
+                                 std::vector<uint32_t> sectionOffsets,
+                                 std::vector<int32_t> sectionParents,
+                                 std::vector<SectionType> sectionTypes,
+                                 Points somaPoints = {},
+                                 std::vector<floatType> somaDiameters = {},
+                                 unsigned int options = NO_MODIFIER);
+
     /**
        Returns all section ids at the tree root
     **/
@@ -168,6 +195,41 @@ class Morphology
     std::shared_ptr<Section> appendRootSection(const Property::PointLevel&,
                                                SectionType sectionType);
 
+    /**
+       Return an independent copy of the neurite starting at the given root section
+
+       The copy shares no state with this morphology: it can be edited in another thread
+       while other neurites are checked out and edited concurrently. Sections keep their
+       IDs and new sections get IDs from a range that does not collide with the sections
+       of this morphology. The soma and cell properties are copied for reference,
+       organelles are not.
+
+       Concurrent calls are safe as long as this morphology is not modified meanwhile.
+       Throws a SectionBuilderError if rootId is not the ID of a root section.
+
+       Note: the neurite is returned by pointer as copying a morphology renumbers its
+       sections
+    **/
+    std::unique_ptr<Morphology> checkoutNeurite(uint32_t rootId) const;
+
+    /**
+       Replace the neurite starting at rootId by the sections of neurite, a morphology
+       returned by checkoutNeurite(rootId)
+
+       The sections are moved, neurite is left empty. Sections coming from this
+       morphology keep their IDs, new sections are given new IDs. The root sections of
+       neurite take the place of rootId among the root sections. Edits made to this
+       neurite in this morphology since the checkout are discarded.
+
+       The validation is done before any modification: if it throws, this morphology
+       is left untouched. Merges modify this morphology and must not run concurrently
+       with each other or with checkouts.
+
+       Throws a SectionBuilderError if neurite was not returned by checkoutNeurite(rootId)
+       of this morphology, or was already merged.
+    **/
+    void mergeNeurite(uint32_t rootId, Morphology&& neurite);
+
     void applyModifiers(unsigned int modifierFlags);
 
     /**
@@ -186,7 +248,8 @@ class Morphology
     inline MorphologyVersion version() const noexcept;
 
     /**
-     * Write file to H5, SWC, ASC format depending on filename extension
+     * Write file to H5, SWC, ASC or MorphIO binary (.morphio) format depending on filename
+     * extension
      **/
     void write(const std::string& filename);
 
@@ -242,6 +305,10 @@ class Morphology
   private:
     void eraseByValue(std::vector<std::shared_ptr<Section>>& vec,
                       const std::shared_ptr<Section> section);
+
+    // Set on the morphologies returned by checkoutNeurite, until they are merged
+    const Morphology* _checkoutSource = nullptr;
+    uint32_t _checkoutRoot = 0;
 };
 
 inline const std::vector<std::shared_ptr<Section>>& Morphology::rootSections() const noexcept {
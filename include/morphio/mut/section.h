@@ -59,6 +59,31 @@ class Section: public std::enable_shared_from_this<Section>
     inline Property::PointLevel& properties() noexcept;
     inline const Property::PointLevel& properties() const noexcept;
     /** @} */
+
+    /** @{
+       Register a writable view on the point data of this section (ex: a numpy array)
+
+       While one is registered, the number of points of the section cannot change, see
+       throwIfWritableViews(). Each call to acquireWritableView() must be balanced by a call to
+       releaseWritableView().
+    **/
+    inline void acquireWritableView() noexcept;
+    inline void releaseWritableView() noexcept;
+    /** @} */
+
+    /**
+       Throw a SectionBuilderError if writable views are registered: changing the number of
+       points would reallocate the data they point to
+    **/
+    void throwIfWritableViews() const;
+
+    /**
+       Replace the points, diameters and perimeters of the section
+
+       Data with writable views is copied in place, and keeps its size: see
+       throwIfWritableViews().
+    **/
+    void setProperties(Property::PointLevel pointLevel);
     ////////////////////////////////////////////////////////////////////////////////
     //
     // Methods that were previously in mut::Morphology
@@ -121,6 +146,9 @@ class Section: public std::enable_shared_from_this<Section>
     Property::PointLevel _pointProperties;
     uint32_t _id;
     SectionType _sectionType;
+
+    // Number of registered writable views, see acquireWritableView()
+    uint32_t _writableViews = 0;
 };
 
 std::ostream& operator<<(std::ostream&, const std::shared_ptr<Section>&);
@@ -169,6 +197,14 @@ inline const Property::PointLevel& Section::properties() const noexcept {
     return _pointProperties;
 }
 
+inline void Section::acquireWritableView() noexcept {
+    ++_writableViews;
+}
+
+inline void Section::releaseWritableView() noexcept {
+    --_writableViews;
+}
+
 }  // namespace mut
 }  // namespace morphio
 
@@ -52,10 +52,26 @@ class Soma
     inline Property::PointLevel& properties() noexcept;
     inline const Property::PointLevel& properties() const noexcept;
 
+    /** @{
+       Register a writable view on the point data of the soma (ex: a numpy array). Each call
+       to acquireWritableView() must be balanced by a call to releaseWritableView().
+    **/
+    inline void acquireWritableView() noexcept;
+    inline void releaseWritableView() noexcept;
+    /** @} */
+
+    /**
+       Throw a SectionBuilderError if writable views are registered: changing the number of
+       points would reallocate the data they point to
+    **/
+    void throwIfWritableViews() const;
+
   private:
     friend class Morphology;
     SomaType _somaType;
     Property::PointLevel _pointProperties;
+    // Number of registered writable views, see acquireWritableView()
+    uint32_t _writableViews = 0;
 };
 
 inline std::vector<Point>& Soma::points() noexcept {
@@ -86,6 +102,14 @@ inline const Property::PointLevel& Soma::properties() const noexcept {
     return _pointProperties;
 }
 
+inline void Soma::acquireWritableView() noexcept {
+    ++_writableViews;
+}
+
+inline void Soma::releaseWritableView() noexcept {
+    --_writableViews;
+}
+
 std::ostream& operator<<(std::ostream& os, const std::shared_ptr<Soma>& sectionPtr);
 std::ostream& operator<<(std::ostream& os, const Soma& soma);
 
@@ -6,6 +6,7 @@ namespace writer {
 void swc(const Morphology& morphology, const std::string& filename);
 void asc(const Morphology& morphology, const std::string& filename);
 void h5(const Morphology& morphology, const std::string& filename);
+void binary(const Morphology& morphology, const std::string& filename);
 }  // namespace writer
 }  // end namespace mut
 }  // end namespace morphio
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+#include <string>   // std::string
+
+namespace morphio {
+
+/**
+   Enable the persistent cache of parsed SWC and ASC files, stored in `directory`
+
+   Once a SWC or ASC file is parsed with some options, the resulting morphology is stored in
+   the cache in the MorphIO binary encoding. The next loads of this file with the same options
+   read it from the cache: no lexing, validation or modifier application. Entries are keyed by
+   the path, size, modification time and content hash of the file, so modified files are
+   parsed again. Warnings emitted while parsing a file are not emitted again when it is loaded
+   from the cache.
+
+   When the cache exceeds maxSize bytes, the least recently used entries are removed. Several
+   processes can use the same cache directory at once: entries are written to temporary files
+   and renamed into place, so a reader sees either a whole entry or none. Errors accessing the
+   cache are ignored, the file is then parsed as usual.
+
+   The directory is created if needed. The cache is shared by all the threads of the process.
+**/
+void enableParseCache(const std::string& directory, uint64_t maxSize = uint64_t(1) << 30);
+
+/**
+   Stop using the parse cache, its content is left on disk
+**/
+void disableParseCache();
+
+}  // namespace morphio
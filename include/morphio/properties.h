@@ -20,6 +20,7 @@
 #pragma once
 
 #include <map>
+#include <memory>  // std::shared_ptr
 #include <morphio/types.h>
 
 namespace morphio {
@@ -73,8 +74,10 @@ struct PointLevel {
                std::vector<Diameter::Type> diameters,
                std::vector<Perimeter::Type> perimeters = {});
     PointLevel(const PointLevel& data);
+    PointLevel(PointLevel&& data) noexcept = default;
     PointLevel(const PointLevel& data, SectionRange range);
     PointLevel& operator=(const PointLevel& other);
+    PointLevel& operator=(PointLevel&& other) noexcept = default;
 };
 
 struct SectionLevel {
@@ -164,6 +167,44 @@ struct CellLevel {
     uint32_t minorVersion();
 };
 
+/**
+   The point level of the neurites when it is not held in _pointLevel: either read from the
+   file on first access (see LoadOptions::lazy), or viewed in place in the memory of a
+   SharedStore
+
+   A lazy one is read one block of consecutive sections at a time. Blocks are kept as long as
+   the morphology: the ranges returned by Section::points() stay valid like with eager loading.
+**/
+class LazyPointLevel
+{
+  public:
+    virtual ~LazyPointLevel() = default;
+
+    /** Number of points of the neurites **/
+    virtual size_t size() const noexcept = 0;
+
+    /**
+       Return a point level holding the points of the range, reading them if needed, and set
+       offset to the index of the first one in it. The range must not cross sections.
+    **/
+    virtual const PointLevel& block(const SectionRange& range, size_t& offset) = 0;
+
+    /** Return the whole point level, reading it once **/
+    virtual const PointLevel& all() = 0;
+
+    /** The points of a section, by default the range of block() holding them **/
+    virtual range<const Point::Type> points(const SectionRange& range);
+    virtual range<const Diameter::Type> diameters(const SectionRange& range);
+    /** Empty when the morphology has no perimeters **/
+    virtual range<const Perimeter::Type> perimeters(const SectionRange& range);
+
+    /**
+       Free the blocks holding no point at or after `end`, invalidating the ranges into them.
+       Only for the readers going through the sections once, like morphio::stream
+    **/
+    virtual void release(size_t end) = 0;
+};
+
 // The lowest level data blob
 struct Properties {
     PointLevel _pointLevel;
@@ -176,6 +217,9 @@ struct Properties {
 
     EndoplasmicReticulumLevel _endoplasmicReticulumLevel;
 
+    // Set, with _pointLevel left empty, when the points of the neurites are loaded lazily
+    std::shared_ptr<LazyPointLevel> _lazyPointLevel;
+
     template <typename T>
     std::vector<typename T::Type>& get_mut() noexcept;
 
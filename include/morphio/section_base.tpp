@@ -1,3 +1,5 @@
+#include <type_traits>  // std::is_same
+
 #include <morphio/morphology.h>
 #include <morphio/properties.h>
 #include <morphio/section.h>
@@ -14,10 +16,15 @@ SectionBase<T>::SectionBase(const uint32_t id_,
             "Requested section ID (" + std::to_string(_id) +
             ") is out of array bounds (array size = " + std::to_string(sections.size()) + ")");
 
+    size_t pointCount = properties->get<typename T::PointAttribute>().size();
+    // The points of the neurites loaded lazily are not in the properties
+    if (std::is_same<typename T::PointAttribute, Property::Point>::value &&
+        properties->_lazyPointLevel)
+        pointCount = properties->_lazyPointLevel->size();
+
     const auto start = static_cast<size_t>(sections[_id][0]);
-    const size_t end = _id == sections.size() - 1
-                           ? properties->get<typename T::PointAttribute>().size()
-                           : static_cast<size_t>(sections[_id + 1][0]);
+    const size_t end = _id == sections.size() - 1 ? pointCount
+                                                  : static_cast<size_t>(sections[_id + 1][0]);
 
     _range = std::make_pair(start, end);
 
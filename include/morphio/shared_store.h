@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>  // std::shared_ptr
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/morphology.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   Immutable morphologies materialized once in memory shared between the processes of a node
+
+   One process creates the store, the others attach to it read-only by name:
+
+       // Node leader
+       morphio::SharedStore::create("templates", names, morphologies);
+       // ... barrier ...
+       // Any process of the node
+       morphio::SharedStore store("templates");
+       morphio::Morphology morph = store.load(name);
+
+   The store holds the morphologies in the encoding of Morphology::serialize(): loading one
+   does not read or parse any file. The points, diameters and perimeters of the neurites are
+   not copied either: Section::points() and the like return ranges into the shared memory, that
+   stays mapped as long as a morphology loaded from it is alive. Only the structure (sections,
+   soma, organelles, annotations) is copied in the process. The accessors of the whole arrays,
+   like Morphology::points(), copy the points of the morphology once on first call.
+
+   Within a process, the morphologies loaded from a store share their data: loading the same
+   name again while a Morphology of it is alive does not copy anything.
+
+   A name without '/' is a POSIX shared memory segment (see shm_open), anything else is the
+   path of a file that is memory-mapped. A SharedStore can be shared between threads.
+**/
+class SharedStore
+{
+  public:
+    /**
+       Attach read-only to an existing store
+
+       @throw RawDataError if the store does not exist or is not a valid store
+    **/
+    explicit SharedStore(const std::string& name);
+
+    ~SharedStore();
+
+    /**
+       Create a store holding morphologies[i] under the name keys[i], and attach to it
+
+       @throw RawDataError if the store already exists, it must be removed first
+    **/
+    static SharedStore create(const std::string& name,
+                              const std::vector<std::string>& keys,
+                              const std::vector<const Morphology*>& morphologies);
+
+    /**
+       Remove the store: processes attached to it keep their mapping until they detach
+
+       Does nothing if the store does not exist.
+    **/
+    static void remove(const std::string& name);
+
+    /**
+       Load the morphology stored under the given key
+
+       @throw RawDataError if the store has no such morphology
+    **/
+    Morphology load(const std::string& key) const;
+
+    /**
+       Return true if the store has a morphology with the given key
+    **/
+    bool contains(const std::string& key) const;
+
+    /**
+       Return the keys of all morphologies, in storage order
+    **/
+    const std::vector<std::string>& keys() const noexcept;
+
+    /**
+       Return the number of morphologies in the store
+    **/
+    size_t size() const noexcept;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> _impl;
+};
+
+}  // namespace morphio
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>  // std::string
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   Receive the content of a morphology file as a sequence of events, see morphio::stream
+
+   Every callback does nothing by default: a handler only overrides the events it needs. The
+   ranges passed to the callbacks are only valid during the call.
+**/
+class MorphologyHandler
+{
+  public:
+    virtual ~MorphologyHandler() = default;
+
+    /** The soma, first of all events **/
+    virtual void onSoma(SomaType /*type*/,
+                        range<const Point> /*points*/,
+                        range<const floatType> /*diameters*/) {}
+
+    /** A section starts; parent is -1 for root sections **/
+    virtual void onSectionBegin(uint32_t /*id*/, SectionType /*type*/, int32_t /*parent*/) {}
+
+    /** The points of the current section; perimeters are empty when the file has none **/
+    virtual void onPoints(range<const Point> /*points*/,
+                          range<const floatType> /*diameters*/,
+                          range<const floatType> /*perimeters*/) {}
+
+    /** The current section ends **/
+    virtual void onSectionEnd(uint32_t /*id*/) {}
+
+    /** A marker, once all the sections are done **/
+    virtual void onMarker(const Property::Marker& /*marker*/) {}
+};
+
+/**
+   Read the morphology at `path` into `handler` without building a Morphology
+
+   Sections are passed in the order of a Morphology loaded with NO_MODIFIER, with the same ids;
+   neither modifiers nor the organelles apply. For HDF5 files, only the structure is held in
+   memory: the points are read one block of sections at a time (see LoadOptions::lazy), each
+   block being freed once its sections are passed. The SWC and ASC readers need the whole file
+   to delimit the sections: they still load it before the events are sent.
+**/
+void stream(const std::string& path,
+            MorphologyHandler& handler,
+            const LoadOptions& loadOptions = {});
+
+}  // namespace morphio
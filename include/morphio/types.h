@@ -1,8 +1,9 @@
 #pragma once
 
-#include <memory>  // std::shared_ptr
-#include <string>  // std::string
-#include <vector>  // std::vector
+#include <initializer_list>  // std::initializer_list
+#include <memory>            // std::shared_ptr
+#include <string>            // std::string
+#include <vector>            // std::vector
 
 #include <gsl/gsl>
 #include <morphio/enums.h>
@@ -16,9 +17,11 @@ namespace morphio {
 using namespace enums;
 class EndoplasmicReticulum;
 class MitoSection;
+class Collection;
 class Mitochondria;
 class Morphology;
 class Section;
+class SharedStore;
 template <class T>
 class SectionBase;
 class Soma;
@@ -54,4 +57,98 @@ using MorphologyVersion = std::tuple<std::string, uint32_t, uint32_t>;
 template <typename T>
 using range = gsl::span<T>;
 
+/**
+   Return the policy set with morphio::setIOPolicy, the default of LoadOptions::ioPolicy
+**/
+IOPolicy getIOPolicy();
+
+/**
+   The payloads read when loading a morphology, independently of the modifier flags
+
+   Most uses only need the points, diameters and topology: the other payloads can be disabled
+   so that they are neither read from the file nor kept in memory. A disabled payload is left
+   empty in the loaded morphology.
+
+       morphio::LoadOptions loadOptions;
+       loadOptions.perimeters = false;
+       morphio::Morphology("neuron.h5", NO_MODIFIER, loadOptions);
+
+   The neurites can be filtered by type as well, for instance to only load the dendrites:
+
+       morphio::Morphology("neuron.h5", NO_MODIFIER, {SECTION_DENDRITE, SECTION_APICAL_DENDRITE});
+**/
+struct LoadOptions {
+    LoadOptions() = default;
+
+    /** Only load the neurites of the given types **/
+    LoadOptions(std::initializer_list<SectionType> types)
+        : neuriteTypes(types) {}
+
+    /** Perimeters of the points and of the soma (H5 and MorphIO binary) **/
+    bool perimeters = true;
+    /** Mitochondria (H5 and MorphIO binary) **/
+    bool mitochondria = true;
+    /** Endoplasmic reticulum (H5 and MorphIO binary) **/
+    bool endoplasmicReticulum = true;
+    /** Markers (ASC and MorphIO binary) **/
+    bool markers = true;
+    /** Annotations (MorphIO binary) **/
+    bool annotations = true;
+    /** Line numbers of the sections, tracked by the SWC and ASC readers **/
+    bool lineNumbers = true;
+
+    /**
+       The types of the neurites to load, all of them when empty
+
+       A neurite is kept or skipped whole, after the type of its root section. The soma is
+       always loaded. The sections kept are renumbered in their order in the file, and the
+       organelles and markers of the skipped neurites are dropped.
+    **/
+    std::vector<SectionType> neuriteTypes;
+
+    /**
+       Read the structure eagerly, but the points, diameters and perimeters of the neurites only
+       when they are first accessed, the file being kept open (H5 only)
+
+       Topology queries on very large morphologies then read no point. Section::points() reads
+       the block of sections holding the section, Morphology::points() reads all the points.
+       Loading with modifiers, or sections that are not in depth first order, reads all the
+       points at once. The sanity warnings that need the points are not reported.
+    **/
+    bool lazy = false;
+
+    /**
+       How the file is read, see IOPolicy. Defaults to the policy set with setIOPolicy when the
+       options are built, so that the loads of a thread can use another policy than the rest
+       of the process.
+    **/
+    IOPolicy ioPolicy = getIOPolicy();
+
+    /**
+       Simplify the neurites with this tolerance once loaded, see modifiers::simplify; 0: no
+       simplification
+    **/
+    floatType simplifyTolerance = 0;
+    /**
+       Resample the neurites to this spacing once loaded, see modifiers::resample; 0: no
+       resampling
+
+       Both apply to every format, after the modifiers of the load options: simplification
+       first, then resampling. A negative value raises a MorphioError.
+    **/
+    floatType resampleSpacing = 0;
+
+    /** Only the points, diameters and topology **/
+    static LoadOptions geometryOnly() {
+        LoadOptions loadOptions;
+        loadOptions.perimeters = false;
+        loadOptions.mitochondria = false;
+        loadOptions.endoplasmicReticulum = false;
+        loadOptions.markers = false;
+        loadOptions.annotations = false;
+        loadOptions.lineNumbers = false;
+        return loadOptions;
+    }
+};
+
 }  // namespace morphio
@@ -4,10 +4,14 @@ from ._morphio import (
     AnnotationType,
     CellFamily,
     CellLevel,
+    Collection,
     EndoplasmicReticulum,
     GlialCell,
     IDSequenceError,
+    IOPolicy,
+    IOStats,
     IterType,
+    LoadOptions,
     LogLevel,
     MissingParentError,
     MitoSection,
@@ -18,6 +22,7 @@ from ._morphio import (
     MultipleTrees,
     Option,
     PointLevel,
+    Prefetcher,
     Points,
     Properties,
     RawDataError,
@@ -25,6 +30,7 @@ from ._morphio import (
     SectionBuilderError,
     SectionLevel,
     SectionType,
+    SharedStore,
     Soma,
     SomaError,
     SomaType,
@@ -32,8 +38,15 @@ from ._morphio import (
     VasculatureSectionType,
     Warning,
     WriterError,
+    disable_parse_cache,
+    enable_io_stats,
+    enable_parse_cache,
+    get_io_policy,
+    last_io_stats,
+    load_many,
     mut,
     ostream_redirect,
+    set_io_policy,
     set_ignored_warning,
     set_raise_warnings,
     set_maximum_warnings,
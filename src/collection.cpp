@@ -0,0 +1,646 @@
+#include <dirent.h>     // opendir, readdir
+#include <sys/stat.h>  // stat
+#include <unistd.h>    // getpid, unlink
+
+#include <algorithm>
+#include <cctype>  // std::tolower
+#include <cstdio>  // std::rename
+#include <fstream>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+#include <morphio/collection.h>
+#include <morphio/properties.h>
+#include <morphio/soma.h>
+
+#include <highfive/H5File.hpp>
+#include <highfive/H5Utility.hpp>  // HighFive::SilenceHDF5
+
+#include "readers/morphologyHDF5.h"
+#include "readers/tarArchive.h"
+
+namespace morphio {
+
+namespace {
+std::string _lowerCase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    });
+    return value;
+}
+
+struct Entry {
+    std::string name;
+    std::string fileName;
+    // Index of the extension in the list of extensions: the lowest one wins
+    size_t priority;
+    // Sort key for the on-disk order: inode, or address of the points in the container
+    uint64_t position;
+};
+
+using Entries = std::unordered_map<std::string, Entry>;
+
+/**
+   Add a morphology file if it has one of the extensions: when a name exists with several
+   extensions, the first one wins. fileName can be a path: the name of the morphology is the
+   path without the extension.
+**/
+void _addFile(Entries& entries,
+              const std::string& fileName,
+              const std::vector<std::string>& extensions,
+              uint64_t position) {
+    const size_t slash = fileName.find_last_of('/');
+    const size_t pos = fileName.find_last_of('.');
+    if (pos == std::string::npos || pos == 0 || (slash != std::string::npos && pos <= slash + 1))
+        return;
+
+    const auto extension = std::find(extensions.begin(),
+                                     extensions.end(),
+                                     _lowerCase(fileName.substr(pos)));
+    if (extension == extensions.end())
+        return;
+
+    Entry entry{fileName.substr(0, pos),
+                fileName,
+                static_cast<size_t>(extension - extensions.begin()),
+                position};
+    const auto inserted = entries.emplace(entry.name, entry);
+    if (!inserted.second && entry.priority < inserted.first->second.priority)
+        inserted.first->second = entry;
+}
+
+std::vector<Entry> _values(Entries& entries) {
+    std::vector<Entry> result;
+    result.reserve(entries.size());
+    for (auto& kv : entries) {
+        result.push_back(std::move(kv.second));
+    }
+    return result;
+}
+
+std::vector<Entry> _listDirectory(const std::string& directory,
+                                  const std::vector<std::string>& extensions) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+        throw RawDataError("Could not open the morphology directory " + directory);
+
+    Entries entries;
+    while (const dirent* dirEntry = readdir(dir)) {
+        _addFile(entries, dirEntry->d_name, extensions, static_cast<uint64_t>(dirEntry->d_ino));
+    }
+    closedir(dir);
+    return _values(entries);
+}
+
+/**
+   Members are named as files of a directory, from their path in the archive
+   (ex: dir/name for dir/name.swc)
+**/
+std::vector<Entry> _listArchive(const readers::tar::Archive& archive,
+                                const std::vector<std::string>& extensions) {
+    Entries entries;
+    for (const auto& member : archive.members()) {
+        // A path can be archived several times, the last member wins
+        if (archive.find(member.name) == &member)
+            _addFile(entries, member.name, extensions, member.offset);
+    }
+    return _values(entries);
+}
+
+/** Address of the points of a morphology in its container, max for chunked or compact ones **/
+uint64_t _pointsAddress(const HighFive::Group& group) {
+    uint64_t position = std::numeric_limits<uint64_t>::max();
+    if (group.exist("points")) {
+        const haddr_t address = H5Dget_offset(group.getDataSet("points").getId());
+        if (address != HADDR_UNDEF)
+            position = static_cast<uint64_t>(address);
+    }
+    return position;
+}
+
+/**
+   Morphologies are the groups with a structure dataset, they can be nested in other groups
+   (ex: /00/00/<name>). They are named after their path in the container.
+**/
+void _listContainer(const HighFive::Group& parent,
+                    const std::string& prefix,
+                    std::vector<Entry>& result) {
+    for (const std::string& child : parent.listObjectNames()) {
+        std::unique_ptr<HighFive::Group> groupPtr;
+        try {
+            groupPtr.reset(new HighFive::Group(parent.getGroup(child)));
+        } catch (const HighFive::Exception&) {
+            continue;  // not a group
+        }
+        const HighFive::Group& group = *groupPtr;
+
+        const std::string name = prefix + child;
+        if (!group.exist("structure")) {
+            _listContainer(group, name + "/", result);
+            continue;
+        }
+
+        result.push_back({name, name, 0, _pointsAddress(group)});
+    }
+}
+
+constexpr const char* INDEX_MAGIC = "morphio-collection-index";
+constexpr int INDEX_VERSION = 2;
+constexpr size_t INDEX_COLUMNS = 14;
+
+std::string _defaultIndexPath(std::string collectionPath) {
+    while (collectionPath.size() > 1 && collectionPath.back() == '/') {
+        collectionPath.pop_back();
+    }
+    return collectionPath + ".morphio-index";
+}
+
+/**
+   What an index depends on besides the morphologies: it is stale once the collection is
+   modified, which changes its size or modification time, or opened with other extensions
+**/
+std::string _indexStamp(const struct stat& info, const std::vector<std::string>& extensions) {
+    std::ostringstream stamp;
+    stamp << info.st_size << ' ' << info.st_mtime;
+    for (const auto& extension : extensions) {
+        stamp << ' ' << extension;
+    }
+    return stamp.str();
+}
+
+/**
+   The index is a text file: a header line, the stamp line, then one line per morphology with
+   the fields of its CollectionEntry separated by tabulations, in on-disk order.
+
+   Return false if there is no index at indexPath or if it is stale
+**/
+bool _readIndex(const std::string& indexPath,
+                const std::string& stamp,
+                std::vector<CollectionEntry>& entries) {
+    std::ifstream file(indexPath);
+    std::string line;
+    if (!file || !std::getline(file, line) ||
+        line != std::string(INDEX_MAGIC) + ' ' + std::to_string(INDEX_VERSION) ||
+        !std::getline(file, line) || line != stamp)
+        return false;
+
+    const auto corrupted = [&indexPath]() {
+        return RawDataError("Corrupted collection index " + indexPath);
+    };
+    std::vector<std::string> fields;
+    while (std::getline(file, line)) {
+        fields.clear();
+        std::istringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, '\t')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != INDEX_COLUMNS)
+            throw corrupted();
+
+        CollectionEntry entry;
+        try {
+            entry.name = fields[0];
+            entry.location = fields[1];
+            entry.format = fields[2];
+            entry.offset = std::stoull(fields[3]);
+            entry.size = std::stoull(fields[4]);
+            entry.modificationTime = std::stoll(fields[5]);
+            entry.nSections = static_cast<uint32_t>(std::stoul(fields[6]));
+            entry.nPoints = std::stoull(fields[7]);
+            for (size_t i = 0; i < 3; ++i) {
+                entry.boundingBoxMin[i] = static_cast<floatType>(std::stod(fields[8 + i]));
+                entry.boundingBoxMax[i] = static_cast<floatType>(std::stod(fields[11 + i]));
+            }
+        } catch (const std::exception&) {
+            throw corrupted();
+        }
+        entries.push_back(std::move(entry));
+    }
+    if (file.bad())
+        throw corrupted();
+    return true;
+}
+
+void _writeIndex(const std::string& indexPath,
+                 const std::string& stamp,
+                 const std::vector<CollectionEntry>& entries) {
+    // Written aside then renamed: collections opened meanwhile never see a partial index
+    const std::string tmpPath = indexPath + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file.precision(std::numeric_limits<floatType>::max_digits10);
+        file << INDEX_MAGIC << ' ' << INDEX_VERSION << '\n' << stamp << '\n';
+        for (const auto& entry : entries) {
+            file << entry.name << '\t' << entry.location << '\t' << entry.format << '\t'
+                 << entry.offset << '\t' << entry.size << '\t' << entry.modificationTime
+                 << '\t' << entry.nSections << '\t' << entry.nPoints;
+            for (const Point* point : {&entry.boundingBoxMin, &entry.boundingBoxMax}) {
+                for (const floatType value : *point) {
+                    file << '\t' << value;
+                }
+            }
+            file << '\n';
+        }
+        if (!file) {
+            unlink(tmpPath.c_str());
+            throw RawDataError("Could not write the collection index " + indexPath);
+        }
+    }
+    if (std::rename(tmpPath.c_str(), indexPath.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        throw RawDataError("Could not write the collection index " + indexPath);
+    }
+}
+
+/** The bounding box of the points of the soma and the neurites, zero when there are none **/
+void _boundingBox(const Morphology& morphology, Point& lower, Point& upper) {
+    const auto somaPoints = morphology.soma().points();
+    const auto& points = morphology.points();
+    bool first = true;
+    const auto extend = [&](const Point& point) {
+        for (size_t i = 0; i < 3; ++i) {
+            lower[i] = first ? point[i] : std::min(lower[i], point[i]);
+            upper[i] = first ? point[i] : std::max(upper[i], point[i]);
+        }
+        first = false;
+    };
+    lower = upper = Point{};
+    std::for_each(somaPoints.begin(), somaPoints.end(), extend);
+    std::for_each(points.begin(), points.end(), extend);
+}
+}  // namespace
+
+struct Collection::Impl {
+    std::string _path;
+    bool _isContainer = false;
+    std::vector<std::string> _names;
+
+    // Morphology name -> file name in the directory, group name in the container, or member
+    // path in the archive
+    std::unordered_map<std::string, std::string> _index;
+
+    std::vector<std::string> _extensions;
+    std::string _indexPath;
+    // Set when the collection has an index, in the order of _names
+    bool _hasIndex = false;
+    std::vector<CollectionEntry> _entries;
+    std::unordered_map<std::string, size_t> _entryIndex;
+
+    // Set for tar archives, which are read without any lock
+    std::unique_ptr<readers::tar::Archive> _archive;
+
+    // HDF5 objects are only used with the HDF5 lock held
+    std::unique_ptr<HighFive::File> _container;
+
+    // Everything below is guarded by _mutex, taken after the HDF5 lock when both are needed
+    mutable std::mutex _mutex;
+
+    // Open HDF5 files of a directory, most recently used first
+    size_t _maxOpenFiles = 0;
+    mutable std::list<std::pair<std::string, HighFive::File>> _openFiles;
+
+    // Loaded morphologies, most recently used first
+    using CacheEntry = std::pair<std::string, std::shared_ptr<Property::Properties>>;
+    size_t _cacheSize = 0;
+    mutable std::list<CacheEntry> _cache;
+    mutable std::unordered_map<std::string, std::list<CacheEntry>::iterator> _cacheIndex;
+
+    ~Impl() {
+        std::lock_guard<std::recursive_mutex> lock(readers::h5::hdf5Mutex());
+        _openFiles.clear();
+        _container.reset();
+    }
+
+    /** The name of a morphology without the leading '/' of an absolute group path **/
+    std::string key(const std::string& morphName) const {
+        return _isContainer && !morphName.empty() && morphName[0] == '/' ? morphName.substr(1)
+                                                                          : morphName;
+    }
+
+    const std::string& location(const std::string& morphName) const {
+        const auto it = _index.find(key(morphName));
+        if (it == _index.end())
+            throw RawDataError("Morphology '" + morphName + "' is not part of the collection " +
+                               _path);
+        return it->second;
+    }
+
+    /** Use the entries of an index, in on-disk order, instead of the listing **/
+    void setEntries(std::vector<CollectionEntry> entries) {
+        _names.clear();
+        _index.clear();
+        _entryIndex.clear();
+        _names.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            _names.push_back(entries[i].name);
+            _index.emplace(entries[i].name, entries[i].location);
+            _entryIndex.emplace(entries[i].name, i);
+        }
+        _entries = std::move(entries);
+        _hasIndex = true;
+    }
+
+    /** Everything the index records about a morphology, which is loaded **/
+    CollectionEntry describe(const std::string& morphName) const {
+        CollectionEntry entry;
+        entry.name = morphName;
+        entry.location = location(morphName);
+        if (_isContainer) {
+            entry.format = "h5";
+            std::lock_guard<std::recursive_mutex> lock(readers::h5::hdf5Mutex());
+            entry.offset = _pointsAddress(_container->getGroup(entry.location));
+        } else {
+            entry.format = _lowerCase(entry.location.substr(entry.location.find_last_of('.') + 1));
+            if (_archive) {
+                const readers::tar::Member& member = *_archive->find(entry.location);
+                entry.offset = member.offset;
+                entry.size = member.size;
+            } else {
+                struct stat info {};
+                if (stat((_path + "/" + entry.location).c_str(), &info) == 0) {
+                    entry.size = static_cast<uint64_t>(info.st_size);
+                    entry.modificationTime = info.st_mtime;
+                }
+            }
+        }
+
+        const Morphology morphology = load(morphName, NO_MODIFIER);
+        entry.nSections = static_cast<uint32_t>(morphology.sectionTypes().size());
+        entry.nPoints = morphology.points().size();
+        _boundingBox(morphology, entry.boundingBoxMin, entry.boundingBoxMax);
+        return entry;
+    }
+
+    /**
+       Check an entry of the index against its morphology: editing a file of a directory in
+       place, or rewriting an archive with the same size and modification time, does not make
+       the whole index stale
+    **/
+    void checkEntry(const CollectionEntry& entry) const {
+        bool fresh = true;
+        if (_archive) {
+            fresh = _archive->hasHeader({entry.location, entry.offset, entry.size});
+        } else if (!_isContainer) {
+            struct stat info {};
+            fresh = stat((_path + "/" + entry.location).c_str(), &info) == 0 &&
+                    static_cast<uint64_t>(info.st_size) == entry.size &&
+                    info.st_mtime == entry.modificationTime;
+        }
+        if (!fresh)
+            throw modified(entry.name);
+    }
+
+    RawDataError modified(const std::string& morphName) const {
+        return RawDataError("Morphology '" + morphName + "' was modified since the index of " +
+                            "the collection " + _path + " was written: write it again with " +
+                            "writeIndex");
+    }
+
+    /** Must be called with the HDF5 lock and _mutex held **/
+    const HighFive::File& openFile(const std::string& filePath) const {
+        for (auto it = _openFiles.begin(); it != _openFiles.end(); ++it) {
+            if (it->first == filePath) {
+                _openFiles.splice(_openFiles.begin(), _openFiles, it);
+                return _openFiles.front().second;
+            }
+        }
+
+        try {
+            _openFiles.emplace_front(filePath,
+                                     HighFive::File(filePath, HighFive::File::ReadOnly));
+        } catch (const HighFive::FileException& exc) {
+            throw RawDataError("Could not open morphology file " + filePath + ": " + exc.what());
+        }
+        while (_openFiles.size() > std::max<size_t>(_maxOpenFiles, 1)) {
+            _openFiles.pop_back();
+        }
+        return _openFiles.front().second;
+    }
+
+    /**
+       Only the raw HDF5 reads hold the locks: modifiers are applied, and SWC and ASC files
+       are parsed, without them
+    **/
+    Morphology load(const std::string& morphName, unsigned int options) const {
+        const std::string& fileName = location(morphName);
+        if (_archive) {
+            const readers::tar::Member& member = *_archive->find(fileName);
+            // The byte range comes from the index, which does not see a rewritten archive
+            if (_hasIndex && !_archive->hasHeader(member))
+                throw modified(morphName);
+            const auto content = _archive->read(member);
+            const std::string extension = fileName.substr(fileName.find_last_of('.') + 1);
+            return Morphology::fromBuffer(content.data(), content.size(), extension, options);
+        }
+
+        const std::string filePath = _path + "/" + fileName;
+        if (!_isContainer && _lowerCase(fileName.substr(fileName.find_last_of('.'))) != ".h5")
+            return Morphology(filePath, options);
+
+        Property::Properties properties;
+        {
+            std::lock_guard<std::recursive_mutex> h5Lock(readers::h5::hdf5Mutex());
+            HighFive::SilenceHDF5 silence;
+            if (_isContainer) {
+                properties = readers::h5::load(_container->getGroup(fileName));
+            } else {
+                std::lock_guard<std::mutex> lock(_mutex);
+                properties = readers::h5::load(openFile(filePath).getGroup("/"));
+            }
+        }
+        return Morphology(std::move(properties), options);
+    }
+
+    std::shared_ptr<Property::Properties> cached(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _cacheIndex.find(key);
+        if (it == _cacheIndex.end())
+            return nullptr;
+        _cache.splice(_cache.begin(), _cache, it->second);
+        return it->second->second;
+    }
+
+    void store(const std::string& key,
+               const std::shared_ptr<Property::Properties>& properties) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_cacheIndex.count(key))
+            return;  // loaded concurrently by another thread
+        _cache.emplace_front(key, properties);
+        _cacheIndex[key] = _cache.begin();
+        while (_cache.size() > _cacheSize) {
+            _cacheIndex.erase(_cache.back().first);
+            _cache.pop_back();
+        }
+    }
+};
+
+Collection::Collection(const std::string& collectionPath,
+                       size_t cacheSize,
+                       size_t maxOpenFiles,
+                       std::vector<std::string> extensions,
+                       const std::string& indexPath)
+    : _impl(std::make_shared<Impl>()) {
+    _impl->_path = collectionPath;
+    _impl->_cacheSize = cacheSize;
+    _impl->_maxOpenFiles = maxOpenFiles;
+
+    struct stat info {};
+    if (stat(collectionPath.c_str(), &info) != 0)
+        throw RawDataError("Collection: " + collectionPath + " does not exist.");
+
+    for (auto& extension : extensions) {
+        extension = _lowerCase(extension);
+    }
+    _impl->_indexPath = indexPath.empty() ? _defaultIndexPath(collectionPath) : indexPath;
+
+    std::vector<CollectionEntry> indexed;
+    const bool hasIndex = _readIndex(_impl->_indexPath,
+                                     _indexStamp(info, extensions),
+                                     indexed);
+    _impl->_extensions = std::move(extensions);
+
+    std::vector<Entry> entries;
+    if (S_ISDIR(info.st_mode)) {
+        if (!hasIndex)
+            entries = _listDirectory(collectionPath, _impl->_extensions);
+    } else if (readers::tar::Archive::isArchive(collectionPath)) {
+        if (hasIndex) {
+            std::vector<readers::tar::Member> members;
+            members.reserve(indexed.size());
+            for (const auto& entry : indexed) {
+                members.push_back({entry.location, entry.offset, entry.size});
+            }
+            _impl->_archive.reset(new readers::tar::Archive(collectionPath, std::move(members)));
+        } else {
+            _impl->_archive.reset(new readers::tar::Archive(collectionPath));
+            entries = _listArchive(*_impl->_archive, _impl->_extensions);
+        }
+    } else {
+        _impl->_isContainer = true;
+        std::lock_guard<std::recursive_mutex> lock(readers::h5::hdf5Mutex());
+        try {
+            HighFive::SilenceHDF5 silence;
+            _impl->_container.reset(
+                new HighFive::File(collectionPath, HighFive::File::ReadOnly));
+            if (!hasIndex)
+                _listContainer(*_impl->_container, "", entries);
+        } catch (const HighFive::Exception& exc) {
+            throw RawDataError("Could not open morphology container " + collectionPath + ": " +
+                               exc.what());
+        }
+    }
+
+    if (hasIndex) {
+        _impl->setEntries(std::move(indexed));
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return std::tie(a.position, a.name) < std::tie(b.position, b.name);
+    });
+
+    _impl->_names.reserve(entries.size());
+    for (Entry& entry : entries) {
+        _impl->_names.push_back(entry.name);
+        _impl->_index.emplace(std::move(entry.name), std::move(entry.fileName));
+    }
+}
+
+Collection::~Collection() = default;
+
+Morphology Collection::load(const std::string& morphName, unsigned int options) const {
+    if (_impl->_cacheSize == 0)
+        return _impl->load(morphName, options);
+
+    const std::string key = morphName + '\n' + std::to_string(options);
+    if (auto properties = _impl->cached(key))
+        return Morphology(std::move(properties));
+
+    Morphology morphology = _impl->load(morphName, options);
+    _impl->store(key, morphology._properties);
+    return morphology;
+}
+
+bool Collection::contains(const std::string& morphName) const {
+    try {
+        _impl->location(morphName);
+        return true;
+    } catch (const RawDataError&) {
+        return false;
+    }
+}
+
+const std::vector<std::string>& Collection::names() const noexcept {
+    return _impl->_names;
+}
+
+size_t Collection::size() const noexcept {
+    return _impl->_names.size();
+}
+
+std::string Collection::path(const std::string& morphName) const {
+    const std::string& fileName = _impl->location(morphName);
+    return _impl->_isContainer || _impl->_archive ? _impl->_path
+                                                  : _impl->_path + "/" + fileName;
+}
+
+void Collection::writeIndex(const std::string& indexPath) {
+    struct stat info {};
+    if (stat(_impl->_path.c_str(), &info) != 0)
+        throw RawDataError("Collection: " + _impl->_path + " does not exist.");
+
+    std::vector<CollectionEntry> entries;
+    entries.reserve(_impl->_names.size());
+    for (const auto& name : _impl->_names) {
+        if (name.find_first_of("\t\n") != std::string::npos)
+            throw RawDataError("Cannot index the morphology '" + name +
+                               "': its name has a tabulation or a new line");
+        entries.push_back(_impl->describe(name));
+    }
+
+    _writeIndex(indexPath.empty() ? _impl->_indexPath : indexPath,
+                _indexStamp(info, _impl->_extensions),
+                entries);
+    _impl->setEntries(std::move(entries));
+}
+
+bool Collection::hasIndex() const noexcept {
+    return _impl->_hasIndex;
+}
+
+const CollectionEntry& Collection::entry(const std::string& morphName, bool validate) const {
+    if (!hasIndex())
+        throw RawDataError("The collection " + _impl->_path +
+                           " has no index: write it with writeIndex");
+    const auto it = _impl->_entryIndex.find(_impl->key(morphName));
+    if (it == _impl->_entryIndex.end())
+        throw RawDataError("Morphology '" + morphName + "' is not part of the collection " +
+                           _impl->_path);
+    const CollectionEntry& entry = _impl->_entries[it->second];
+    if (validate)
+        _impl->checkEntry(entry);
+    return entry;
+}
+
+std::vector<std::string> Collection::select(
+    const std::function<bool(const CollectionEntry&)>& predicate, bool validate) const {
+    if (!hasIndex())
+        throw RawDataError("The collection " + _impl->_path +
+                           " has no index: write it with writeIndex");
+    std::vector<std::string> names;
+    for (const auto& entry : _impl->_entries) {
+        if (predicate(entry)) {
+            if (validate)
+                _impl->checkEntry(entry);
+            names.push_back(entry.name);
+        }
+    }
+    return names;
+}
+
+}  // namespace morphio
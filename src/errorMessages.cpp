@@ -1,10 +1,17 @@
+#include <atomic>
 #include <cmath>
 #include <morphio/errorMessages.h>
+#include <mutex>
 #include <sstream>
 
 namespace morphio {
-static int MORPHIO_MAX_N_WARNINGS = 100;
-static bool MORPHIO_RAISE_WARNINGS = false;
+static std::atomic<int> MORPHIO_MAX_N_WARNINGS{100};
+static std::atomic<bool> MORPHIO_RAISE_WARNINGS{false};
+
+// Warnings can be emitted from several threads at once: the mutex guards the set of
+// ignored warnings, the count of printed warnings and their output
+static std::mutex _warningsMutex;
+static std::set<Warning> _ignoredWarnings;
 
 /**
    Controls the maximum number of warning to be printed on screen
@@ -23,10 +30,11 @@ void set_raise_warnings(bool is_raise) {
 }
 
 void set_ignored_warning(Warning warning, bool ignore) {
+    std::lock_guard<std::mutex> lock(_warningsMutex);
     if (ignore)
-        readers::_ignoredWarnings.insert(warning);
+        _ignoredWarnings.insert(warning);
     else
-        readers::_ignoredWarnings.erase(warning);
+        _ignoredWarnings.erase(warning);
 }
 
 void set_ignored_warning(const std::vector<Warning>& warnings, bool ignore) {
@@ -37,15 +45,17 @@ void set_ignored_warning(const std::vector<Warning>& warnings, bool ignore) {
 void printError(Warning warning, const std::string& msg) {
     static int error = 0;
 
-    if (readers::ErrorMessages::isIgnored(warning) || MORPHIO_MAX_N_WARNINGS == 0)
+    const int maxWarnings = MORPHIO_MAX_N_WARNINGS;
+    if (readers::ErrorMessages::isIgnored(warning) || maxWarnings == 0)
         return;
 
     if (MORPHIO_RAISE_WARNINGS)
         throw MorphioError(msg);
 
-    if (MORPHIO_MAX_N_WARNINGS < 0 || error <= MORPHIO_MAX_N_WARNINGS) {
+    std::lock_guard<std::mutex> lock(_warningsMutex);
+    if (maxWarnings < 0 || error <= maxWarnings) {
         std::cerr << msg << '\n';
-        if (error == MORPHIO_MAX_N_WARNINGS) {
+        if (error == maxWarnings) {
             std::cerr << "Maximum number of warning reached. Next warnings "
                          "won't be displayed.\n"
                          "You can change this number by calling:\n"
@@ -58,10 +68,27 @@ void printError(Warning warning, const std::string& msg) {
 }
 
 namespace readers {
+namespace {
+// Warnings ignored by a ScopedIgnoredWarning of the current thread
+thread_local std::set<Warning> _threadIgnoredWarnings;
+}  // namespace
+
 bool ErrorMessages::isIgnored(Warning warning) {
+    if (_threadIgnoredWarnings.find(warning) != _threadIgnoredWarnings.end())
+        return true;
+    std::lock_guard<std::mutex> lock(_warningsMutex);
     return _ignoredWarnings.find(warning) != _ignoredWarnings.end();
 }
 
+ScopedIgnoredWarning::ScopedIgnoredWarning(Warning warning)
+    : _warning(warning)
+    , _inserted(_threadIgnoredWarnings.insert(warning).second) {}
+
+ScopedIgnoredWarning::~ScopedIgnoredWarning() {
+    if (_inserted)
+        _threadIgnoredWarnings.erase(_warning);
+}
+
 std::string ErrorMessages::errorMsg(long unsigned int lineNumber,
                                     ErrorLevel errorLevel,
                                     std::string msg) const {
@@ -208,7 +235,8 @@ std::string ErrorMessages::ERROR_UNCOMPATIBLE_FLAGS(morphio::Option flag1,
 ////////////////////////////////////////////////////////////////////////////////
 
 std::string ErrorMessages::ERROR_WRONG_EXTENSION(const std::string& filename) const {
-    return "Filename: " + filename + " must have one of the following extensions: swc, asc or h5";
+    return "Filename: " + filename +
+           " must have one of the following extensions: swc, asc, h5 or morphio";
 }
 
 std::string ErrorMessages::ERROR_VECTOR_LENGTH_MISMATCH(const std::string& vec1,
@@ -267,21 +295,41 @@ std::string ErrorMessages::WARNING_DISCONNECTED_NEURITE(const Sample& sample) co
 
 std::string ErrorMessages::WARNING_APPENDING_EMPTY_SECTION(
     std::shared_ptr<morphio::mut::Section> section) {
+    return WARNING_APPENDING_EMPTY_SECTION(section->id());
+}
+
+std::string ErrorMessages::WARNING_APPENDING_EMPTY_SECTION(uint32_t sectionId) const {
     return errorMsg(0,
                     ErrorLevel::WARNING,
-                    "Warning: appending empty section with id: " + std::to_string(section->id()));
+                    "Warning: appending empty section with id: " + std::to_string(sectionId));
 }
 
 std::string ErrorMessages::WARNING_WRONG_DUPLICATE(
     const std::shared_ptr<morphio::mut::Section>& current,
     const std::shared_ptr<morphio::mut::Section>& parent) const {
-    std::string msg("Warning: while appending section: " + std::to_string(current->id()) +
-                    " to parent: " + std::to_string(parent->id()));
-
-    if (parent->points().empty())
+    const morphio::mut::Section& constCurrent = *current;
+    const morphio::mut::Section& constParent = *parent;
+    return WARNING_WRONG_DUPLICATE(current->id(),
+                                   parent->id(),
+                                   constCurrent.points(),
+                                   constCurrent.diameters(),
+                                   constParent.points(),
+                                   constParent.diameters());
+}
+
+std::string ErrorMessages::WARNING_WRONG_DUPLICATE(uint32_t currentId,
+                                                   uint32_t parentId,
+                                                   range<const Point> currentPoints,
+                                                   range<const floatType> currentDiameters,
+                                                   range<const Point> parentPoints,
+                                                   range<const floatType> parentDiameters) const {
+    std::string msg("Warning: while appending section: " + std::to_string(currentId) +
+                    " to parent: " + std::to_string(parentId));
+
+    if (parentPoints.empty())
         return errorMsg(0, ErrorLevel::WARNING, msg + "\nThe parent section is empty.");
 
-    if (current->points().empty())
+    if (currentPoints.empty())
         return errorMsg(0,
                         ErrorLevel::WARNING,
                         msg +
@@ -289,10 +337,10 @@ std::string ErrorMessages::WARNING_WRONG_DUPLICATE(
                             "least contains "
                             "parent section last point");
 
-    auto p0 = parent->points()[parent->points().size() - 1];
-    auto p1 = current->points()[0];
-    auto d0 = parent->diameters()[parent->diameters().size() - 1];
-    auto d1 = current->diameters()[0];
+    auto p0 = parentPoints[parentPoints.size() - 1];
+    auto p1 = currentPoints[0];
+    auto d0 = parentDiameters[parentDiameters.size() - 1];
+    auto d1 = currentDiameters[0];
 
     std::ostringstream oss;
     oss << msg
@@ -0,0 +1,95 @@
+#include <fcntl.h>   // open
+#include <unistd.h>  // read, close
+
+#include <atomic>
+#include <cstdlib>  // std::strtoull
+#include <cstring>  // std::strstr
+
+#include <morphio/io_policy.h>
+
+#include "io_policy.h"
+
+namespace morphio {
+
+namespace {
+std::atomic<IOPolicy> policy{IO_DEFAULT};
+std::atomic<bool> statsEnabled{false};
+
+thread_local IOStats lastStats;
+thread_local uint64_t bytesMapped = 0;
+
+uint64_t _counter(const char* content, const char* name) {
+    const char* field = std::strstr(content, name);
+    return field ? std::strtoull(field + std::strlen(name), nullptr, 10) : 0;
+}
+
+/**
+   Read the I/O counters of the calling thread. The read of /proc is accounted for once it
+   returned: the next sample includes it, with `sampleSize` bytes
+**/
+bool _sample(uint64_t& bytesRead, uint64_t& readCalls, uint64_t& sampleSize) {
+    const int fd = open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    char content[512];
+    const ssize_t size = read(fd, content, sizeof(content) - 1);
+    close(fd);
+    if (size <= 0)
+        return false;
+    content[size] = '\0';
+
+    bytesRead = _counter(content, "rchar:");
+    readCalls = _counter(content, "syscr:");
+    sampleSize = static_cast<uint64_t>(size);
+    return true;
+}
+}  // namespace
+
+void setIOPolicy(IOPolicy newPolicy) {
+    policy = newPolicy;
+}
+
+IOPolicy getIOPolicy() {
+    return policy;
+}
+
+void enableIOStats(bool enable) {
+    statsEnabled = enable;
+}
+
+IOStats lastIOStats() {
+    return lastStats;
+}
+
+namespace io_policy {
+
+StatsScope::StatsScope()
+    : _enabled(statsEnabled) {
+    if (!_enabled)
+        return;
+    _bytesMapped = bytesMapped;
+    uint64_t sampleSize = 0;
+    _enabled = _sample(_bytesRead, _readCalls, sampleSize);
+    // Exclude the read of the sample itself
+    _bytesRead += sampleSize;
+    _readCalls += 1;
+}
+
+StatsScope::~StatsScope() {
+    if (!_enabled)
+        return;
+    uint64_t bytesRead = 0, readCalls = 0, sampleSize = 0;
+    if (!_sample(bytesRead, readCalls, sampleSize))
+        return;
+    lastStats.bytesRead = bytesRead - _bytesRead;
+    lastStats.readCalls = readCalls - _readCalls;
+    lastStats.bytesMapped = bytesMapped - _bytesMapped;
+}
+
+void recordMapping(uint64_t size) {
+    bytesMapped += size;
+}
+
+}  // namespace io_policy
+}  // namespace morphio
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+
+namespace morphio {
+namespace io_policy {
+/**
+   Measure the IOStats of the calling thread from construction to destruction, and store them
+   as its last ones. Does nothing when statistics are not collected.
+**/
+class StatsScope
+{
+  public:
+    StatsScope();
+    ~StatsScope();
+
+    StatsScope(const StatsScope&) = delete;
+    StatsScope& operator=(const StatsScope&) = delete;
+
+  private:
+    bool _enabled;
+    uint64_t _bytesRead = 0;
+    uint64_t _readCalls = 0;
+    uint64_t _bytesMapped = 0;
+};
+
+/** Account for `size` bytes of a file mapped in memory by the calling thread **/
+void recordMapping(uint64_t size);
+}  // namespace io_policy
+}  // namespace morphio
@@ -0,0 +1,143 @@
+#include <algorithm>  // std::min
+#include <atomic>
+#include <exception>  // std::exception_ptr
+#include <memory>     // std::unique_ptr
+#include <thread>
+
+#include <morphio/exceptions.h>
+#include <morphio/loading.h>
+
+#include "readers/fileAccess.h"
+
+namespace morphio {
+
+void loadMany(const std::vector<std::string>& paths,
+              unsigned int options,
+              unsigned int nThreads,
+              const std::function<void(size_t, Morphology&&)>& callback,
+              const LoadOptions& loadOptions) {
+    if (nThreads == 0)
+        nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    nThreads = static_cast<unsigned int>(std::min<size_t>(nThreads, paths.size()));
+
+    // Workers grab the next path as soon as they are done with the previous one, so a slow
+    // file never holds back the others. HDF5 reads are serialized by the reader itself.
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(paths.size());
+    const auto work = [&]() {
+        for (size_t i = next++; i < paths.size(); i = next++) {
+            try {
+                callback(i, Morphology(paths[i], options, loadOptions));
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    try {
+        for (unsigned int i = 1; i < nThreads; ++i) {
+            threads.emplace_back(work);
+        }
+    } catch (...) {
+        // Could not start all the threads: run with the ones available
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+std::vector<Morphology> loadMany(const std::vector<std::string>& paths,
+                                 unsigned int options,
+                                 unsigned int nThreads,
+                                 const LoadOptions& loadOptions) {
+    std::vector<std::unique_ptr<Morphology>> loaded(paths.size());
+    loadMany(
+        paths,
+        options,
+        nThreads,
+        [&loaded](size_t i, Morphology&& morphology) {
+            loaded[i].reset(new Morphology(std::move(morphology)));
+        },
+        loadOptions);
+
+    std::vector<Morphology> morphologies;
+    morphologies.reserve(paths.size());
+    for (auto& morphology : loaded) {
+        morphologies.push_back(std::move(*morphology));
+    }
+    return morphologies;
+}
+
+std::future<Morphology> loadAsync(const std::string& path,
+                                  unsigned int options,
+                                  const LoadOptions& loadOptions) {
+    readers::adviseReadahead(path);
+    return std::async(std::launch::async, [path, options, loadOptions]() {
+        return Morphology(path, options, loadOptions);
+    });
+}
+
+Prefetcher::Prefetcher(std::vector<std::string> paths,
+                       unsigned int options,
+                       size_t depth,
+                       const LoadOptions& loadOptions)
+    : _paths(std::move(paths))
+    , _options(options)
+    , _depth(std::max<size_t>(depth, 1))
+    , _loadOptions(loadOptions) {
+    _fill();
+}
+
+Prefetcher::~Prefetcher() {
+    // The futures of std::async wait for the running loads when destroyed
+}
+
+bool Prefetcher::hasNext() const noexcept {
+    return !_cancelled && _position < _paths.size();
+}
+
+size_t Prefetcher::position() const noexcept {
+    return _position;
+}
+
+void Prefetcher::cancel() noexcept {
+    _cancelled = true;
+}
+
+void Prefetcher::_fill() {
+    const size_t loadEnd = std::min(_paths.size(), _position + _depth);
+    const size_t hintEnd = std::min(_paths.size(), loadEnd + _depth);
+    for (_nextHint = std::max(_nextHint, loadEnd); _nextHint < hintEnd; ++_nextHint) {
+        readers::adviseReadahead(_paths[_nextHint]);
+    }
+
+    for (; _nextLoad < loadEnd; ++_nextLoad) {
+        const std::string& path = _paths[_nextLoad];
+        const unsigned int options = _options;
+        const LoadOptions loadOptions = _loadOptions;
+        _loading.push_back(std::async(std::launch::async, [path, options, loadOptions]() {
+            return Morphology(path, options, loadOptions);
+        }));
+    }
+}
+
+Morphology Prefetcher::next() {
+    if (!hasNext())
+        throw MorphioError("Prefetcher: there is no next morphology");
+
+    std::future<Morphology> loading = std::move(_loading.front());
+    _loading.pop_front();
+    ++_position;
+    _fill();
+    return loading.get();
+}
+
+}  // namespace morphio
@@ -0,0 +1,598 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <type_traits>
+
+#include <morphio/enums.h>
+#include <morphio/errorMessages.h>
+#include <morphio/modifiers.h>
+
+#include "section_kernels.h"
+
+namespace morphio {
+namespace modifiers {
+namespace {
+
+/**
+   Children of every section in file order, stored contiguously: the children of
+   section `i` are `_ids[_begin[i]:_begin[i + 1]]`. The root sections are the children
+   of the extra slot `size()`.
+
+   Sections whose parent is out of range can not be reached from a root and are
+   therefore dropped, like mut::Morphology does when copying a morphology.
+**/
+class Connectivity
+{
+  public:
+    explicit Connectivity(const std::vector<Property::Section::Type>& sections)
+        : _size(static_cast<uint32_t>(sections.size()))
+        , _begin(sections.size() + 3, 0) {
+        for (const auto& section : sections) {
+            if (_isValid(section[1]))
+                ++_begin[_slot(section[1]) + 2];
+        }
+        std::partial_sum(_begin.begin(), _begin.end(), _begin.begin());
+
+        _ids.resize(_begin.back());
+        for (uint32_t i = 0; i < _size; ++i) {
+            if (_isValid(sections[i][1]))
+                _ids[_begin[_slot(sections[i][1]) + 1]++] = i;
+        }
+    }
+
+    uint32_t size() const noexcept {
+        return _size;
+    }
+
+    std::vector<uint32_t> roots() const {
+        return {_ids.begin() + _begin[_size], _ids.begin() + _begin[_size + 1]};
+    }
+
+    range<const uint32_t> children(uint32_t id) const {
+        return {_ids.data() + _begin[id], _begin[id + 1] - _begin[id]};
+    }
+
+  private:
+    bool _isValid(int parent) const noexcept {
+        return parent >= -1 && parent < static_cast<int>(_size);
+    }
+
+    uint32_t _slot(int parent) const noexcept {
+        return parent == -1 ? _size : static_cast<uint32_t>(parent);
+    }
+
+    uint32_t _size;
+    std::vector<uint32_t> _begin;
+    std::vector<uint32_t> _ids;
+};
+
+std::vector<uint32_t> _depthFirstOrder(const Connectivity& connectivity,
+                                       const std::vector<uint32_t>& roots) {
+    std::vector<uint32_t> order;
+    order.reserve(connectivity.size());
+
+    std::vector<uint32_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+
+        const auto children = connectivity.children(id);
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return order;
+}
+
+std::vector<uint32_t> _breadthFirstOrder(const Connectivity& connectivity) {
+    std::vector<uint32_t> order;
+    order.reserve(connectivity.size());
+
+    for (uint32_t root : connectivity.roots()) {
+        std::queue<uint32_t> queue;
+        queue.push(root);
+        while (!queue.empty()) {
+            const uint32_t id = queue.front();
+            queue.pop();
+            order.push_back(id);
+            for (uint32_t child : connectivity.children(id))
+                queue.push(child);
+        }
+    }
+    return order;
+}
+
+/**
+   Position of every section in `order`, -1 for sections that are not part of it
+**/
+std::vector<int> _positions(const std::vector<uint32_t>& order, size_t size) {
+    std::vector<int> positions(size, -1);
+    for (size_t i = 0; i < order.size(); ++i) {
+        positions[order[i]] = static_cast<int>(i);
+    }
+    return positions;
+}
+
+/**
+   [begin, end) point range of section `id`: sections are stored contiguously in
+   file order, the last one running up to the end of the point arrays.
+**/
+std::pair<size_t, size_t> _pointRange(const std::vector<Property::Section::Type>& sections,
+                                      uint32_t id,
+                                      size_t nPoints) {
+    const auto begin = static_cast<size_t>(sections[id][0]);
+    const size_t end = id + 1 < sections.size() ? static_cast<size_t>(sections[id + 1][0])
+                                                : nPoints;
+    return {std::min(begin, nPoints), std::min(std::max(begin, end), nPoints)};
+}
+
+/**
+   Report the warnings that copying the morphology into a mut::Morphology reports.
+   Section IDs are the depth first IDs the mut::Morphology would have assigned.
+**/
+void _checkSections(const Property::Properties& properties, const Connectivity& connectivity) {
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& points = properties._pointLevel._points;
+    const auto& diameters = properties._pointLevel._diameters;
+    const readers::ErrorMessages err;
+
+    const std::vector<uint32_t> order = _depthFirstOrder(connectivity, connectivity.roots());
+    const std::vector<int> positions = _positions(order, sections.size());
+    // Looked up once: the warning state is behind a global lock shared by the loading threads
+    const bool checkDuplicates = !readers::ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE);
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const uint32_t id = order[i];
+        const auto current = _pointRange(sections, id, points.size());
+        if (current.first == current.second) {
+            printError(Warning::APPENDING_EMPTY_SECTION,
+                       err.WARNING_APPENDING_EMPTY_SECTION(static_cast<uint32_t>(i)));
+            continue;
+        }
+
+        const int parentId = sections[id][1];
+        if (parentId == -1 || !checkDuplicates)
+            continue;
+
+        const auto parent = _pointRange(sections,
+                                        static_cast<uint32_t>(parentId),
+                                        points.size());
+        // Weird edge case where parent is empty: skipping it
+        if (parent.first == parent.second ||
+            points[parent.second - 1] == points[current.first])
+            continue;
+
+        const auto pointRange = [&](std::pair<size_t, size_t> r) {
+            return range<const Point>(points.data() + r.first, r.second - r.first);
+        };
+        const auto diameterRange = [&](std::pair<size_t, size_t> r) {
+            return range<const floatType>(diameters.data() + r.first, r.second - r.first);
+        };
+        printError(Warning::WRONG_DUPLICATE,
+                   err.WARNING_WRONG_DUPLICATE(static_cast<uint32_t>(i),
+                                               static_cast<uint32_t>(
+                                                   positions[static_cast<size_t>(parentId)]),
+                                               pointRange(current),
+                                               diameterRange(current),
+                                               pointRange(parent),
+                                               diameterRange(parent)));
+    }
+}
+
+/**
+   The single pass behind every neurite modifier.
+
+   First the output layout is computed: the new section order, and for every output
+   section the input points it keeps. Then the point arrays are gathered; this loop
+   has no dependency between sections.
+**/
+void _compact(Property::Properties& properties,
+              const Connectivity& connectivity,
+              unsigned int modifierFlags) {
+    auto& sectionLevel = properties._sectionLevel;
+    auto& pointLevel = properties._pointLevel;
+    const auto& sections = sectionLevel._sections;
+
+    std::vector<uint32_t> roots = connectivity.roots();
+    if (modifierFlags & NRN_ORDER) {
+        std::stable_sort(roots.begin(), roots.end(), [&](uint32_t a, uint32_t b) {
+            return sectionLevel._sectionTypes[a] < sectionLevel._sectionTypes[b];
+        });
+    }
+
+    const std::vector<uint32_t> order = _depthFirstOrder(connectivity, roots);
+    const std::vector<int> positions = _positions(order, sections.size());
+    const size_t nPoints = pointLevel._points.size();
+    const bool hasPerimeters = !pointLevel._perimeters.empty();
+
+    // Output layout: kept input point range, and whether only its ends are kept
+    struct Kept {
+        size_t first;
+        size_t last;
+        bool endsOnly;
+    };
+    std::vector<Kept> kept(order.size());
+    std::vector<Property::Section::Type> newSections(order.size());
+    std::vector<SectionType> newTypes(order.size());
+    size_t total = 0;
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const uint32_t id = order[i];
+        const int parent = sections[id][1];
+        auto r = _pointRange(sections, id, nPoints);
+
+        if ((modifierFlags & NO_DUPLICATES) && parent != -1 && r.first < r.second)
+            ++r.first;
+
+        const bool endsOnly = (modifierFlags & TWO_POINTS_SECTIONS) && r.second - r.first > 2;
+        kept[i] = {r.first, r.second, endsOnly};
+        newSections[i] = {static_cast<int>(total),
+                          parent == -1 ? -1 : positions[static_cast<size_t>(parent)]};
+        newTypes[i] = sectionLevel._sectionTypes[id];
+        total += endsOnly ? 2 : r.second - r.first;
+    }
+
+    const auto gather = [&kept, &newSections, total](const auto& from) {
+        std::remove_const_t<std::remove_reference_t<decltype(from)>> to(total);
+        for (size_t i = 0; i < kept.size(); ++i) {
+            const Kept& k = kept[i];
+            const auto out = to.begin() + newSections[i][0];
+            if (k.endsOnly) {
+                out[0] = from[k.first];
+                out[1] = from[k.last - 1];
+            } else {
+                std::copy(from.begin() + static_cast<std::ptrdiff_t>(k.first),
+                          from.begin() + static_cast<std::ptrdiff_t>(k.last),
+                          out);
+            }
+        }
+        return to;
+    };
+
+    Property::PointLevel compacted;
+    compacted._points = gather(pointLevel._points);
+    compacted._diameters = gather(pointLevel._diameters);
+    if (hasPerimeters)
+        compacted._perimeters = gather(pointLevel._perimeters);
+
+    sectionLevel._sections = std::move(newSections);
+    sectionLevel._sectionTypes = std::move(newTypes);
+    sectionLevel._children.clear();
+    pointLevel = std::move(compacted);
+}
+
+void _reorderMitochondria(Property::Properties& properties) {
+    auto& sectionLevel = properties._mitochondriaSectionLevel;
+    auto& pointLevel = properties._mitochondriaPointLevel;
+    const auto& sections = sectionLevel._sections;
+    const Connectivity connectivity(sections);
+
+    const std::vector<uint32_t> order = _breadthFirstOrder(connectivity);
+    const std::vector<int> positions = _positions(order, sections.size());
+    const size_t nPoints = pointLevel._diameters.size();
+
+    Property::MitochondriaPointLevel reordered;
+    std::vector<Property::MitoSection::Type> newSections;
+    newSections.reserve(order.size());
+
+    for (uint32_t id : order) {
+        const int parent = sections[id][1];
+        const auto r = _pointRange(sections, id, nPoints);
+        const auto first = static_cast<std::ptrdiff_t>(r.first);
+        const auto last = static_cast<std::ptrdiff_t>(r.second);
+
+        newSections.push_back({static_cast<int>(reordered._diameters.size()),
+                               parent == -1 ? -1 : positions[static_cast<size_t>(parent)]});
+        reordered._sectionIds.insert(reordered._sectionIds.end(),
+                                     pointLevel._sectionIds.begin() + first,
+                                     pointLevel._sectionIds.begin() + last);
+        reordered._relativePathLengths.insert(reordered._relativePathLengths.end(),
+                                              pointLevel._relativePathLengths.begin() + first,
+                                              pointLevel._relativePathLengths.begin() + last);
+        reordered._diameters.insert(reordered._diameters.end(),
+                                    pointLevel._diameters.begin() + first,
+                                    pointLevel._diameters.begin() + last);
+    }
+
+    sectionLevel._sections = std::move(newSections);
+    sectionLevel._children.clear();
+    pointLevel = std::move(reordered);
+}
+
+floatType _dot(const Point& left, const Point& right) {
+    return left[0] * right[0] + left[1] * right[1] + left[2] * right[2];
+}
+
+void _appendRange(const Property::PointLevel& from,
+                  SectionRange range,
+                  Property::PointLevel& to) {
+    const auto first = static_cast<std::ptrdiff_t>(range.first);
+    const auto last = static_cast<std::ptrdiff_t>(range.second);
+    to._points.insert(to._points.end(), from._points.begin() + first, from._points.begin() + last);
+    to._diameters.insert(to._diameters.end(),
+                         from._diameters.begin() + first,
+                         from._diameters.begin() + last);
+    if (!from._perimeters.empty())
+        to._perimeters.insert(to._perimeters.end(),
+                              from._perimeters.begin() + first,
+                              from._perimeters.begin() + last);
+}
+
+/**
+   Rewrite the points of every section for which `parameterOf(type)` is not null
+   with `kernel`, the other sections are copied as is. Connectivity is unchanged.
+**/
+template <typename ParameterOf, typename Kernel>
+void _rewriteSections(Property::Properties& properties, ParameterOf parameterOf, Kernel kernel) {
+    auto& sections = properties._sectionLevel._sections;
+    const auto& types = properties._sectionLevel._sectionTypes;
+    const Property::PointLevel& from = properties._pointLevel;
+    const size_t nPoints = from._points.size();
+
+    Property::PointLevel to;
+    to._points.reserve(nPoints);
+    to._diameters.reserve(nPoints);
+    to._perimeters.reserve(from._perimeters.size());
+
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        const auto range = _pointRange(sections, i, nPoints);
+        sections[i][0] = static_cast<int>(to._points.size());
+
+        const floatType* parameter = parameterOf(types[i]);
+        if (parameter == nullptr)
+            _appendRange(from, range, to);
+        else
+            kernel(from, range, *parameter, to);
+    }
+
+    properties._pointLevel = std::move(to);
+}
+
+}  // namespace
+
+void _resampleSection(const Property::PointLevel& from,
+                      SectionRange range,
+                      floatType spacing,
+                      Property::PointLevel& to) {
+    const size_t first = range.first;
+    const size_t last = range.second;
+    const auto& points = from._points;
+    const auto& diameters = from._diameters;
+    const auto& perimeters = from._perimeters;
+    const bool hasPerimeters = !perimeters.empty();
+
+    if (last - first < 2) {
+        _appendRange(from, range, to);
+        return;
+    }
+
+    // Cumulative path length at each point
+    std::vector<floatType> pathLengths(last - first, 0);
+    for (size_t i = first + 1; i < last; ++i) {
+        pathLengths[i - first] = pathLengths[i - first - 1] + distance(points[i - 1], points[i]);
+    }
+    const floatType length = pathLengths.back();
+    if (length == 0) {
+        _appendRange(from, range, to);
+        return;
+    }
+
+    const auto nSegments = std::max<size_t>(1, static_cast<size_t>(std::ceil(length / spacing)));
+    const floatType step = length / static_cast<floatType>(nSegments);
+
+    to._points.push_back(points[first]);
+    to._diameters.push_back(diameters[first]);
+    if (hasPerimeters)
+        to._perimeters.push_back(perimeters[first]);
+
+    size_t segment = 0;
+    for (size_t k = 1; k < nSegments; ++k) {
+        const floatType target = step * static_cast<floatType>(k);
+        while (segment + 2 < pathLengths.size() && pathLengths[segment + 1] < target)
+            ++segment;
+
+        const floatType segmentLength = pathLengths[segment + 1] - pathLengths[segment];
+        const floatType t = segmentLength > 0
+                                ? std::min<floatType>(1, (target - pathLengths[segment]) /
+                                                             segmentLength)
+                                : 0;
+        const size_t a = first + segment;
+        to._points.push_back(points[a] + (points[a + 1] - points[a]) * t);
+        to._diameters.push_back(diameters[a] + (diameters[a + 1] - diameters[a]) * t);
+        if (hasPerimeters)
+            to._perimeters.push_back(perimeters[a] + (perimeters[a + 1] - perimeters[a]) * t);
+    }
+
+    to._points.push_back(points[last - 1]);
+    to._diameters.push_back(diameters[last - 1]);
+    if (hasPerimeters)
+        to._perimeters.push_back(perimeters[last - 1]);
+}
+
+void _simplifySection(const Property::PointLevel& from,
+                      SectionRange range,
+                      floatType tolerance,
+                      Property::PointLevel& to) {
+    const size_t first = range.first;
+    const size_t size = range.second - range.first;
+    const auto& points = from._points;
+    const auto& diameters = from._diameters;
+
+    if (size < 3) {
+        _appendRange(from, range, to);
+        return;
+    }
+
+    std::vector<char> keep(size, 0);
+    keep.front() = keep.back() = 1;
+
+    // Iterative Ramer-Douglas-Peucker: (first, last) point of the chords to check
+    std::vector<std::pair<size_t, size_t>> chords{{0, size - 1}};
+    while (!chords.empty()) {
+        const size_t a = chords.back().first;
+        const size_t b = chords.back().second;
+        chords.pop_back();
+
+        const Point& start = points[first + a];
+        const Point chord = points[first + b] - start;
+        const floatType chordLength2 = _dot(chord, chord);
+        const floatType startDiameter = diameters[first + a];
+        const floatType diameterChange = diameters[first + b] - startDiameter;
+
+        size_t worst = a;
+        floatType worstError = tolerance;
+        for (size_t i = a + 1; i < b; ++i) {
+            const Point& point = points[first + i];
+            floatType t = chordLength2 > 0 ? _dot(point - start, chord) / chordLength2 : 0;
+            t = std::min<floatType>(1, std::max<floatType>(0, t));
+
+            const floatType error = std::max(
+                distance(point, start + chord * t),
+                std::abs(diameters[first + i] - (startDiameter + diameterChange * t)) / 2);
+            if (error > worstError) {
+                worstError = error;
+                worst = i;
+            }
+        }
+
+        if (worst != a) {
+            keep[worst] = 1;
+            chords.emplace_back(a, worst);
+            chords.emplace_back(worst, b);
+        }
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (keep[i])
+            _appendRange(from, {first + i, first + i + 1}, to);
+    }
+}
+
+void _checkSpacing(floatType spacing) {
+    if (!(spacing > 0))
+        throw MorphioError("Resample: the spacing must be strictly positive, got " +
+                           std::to_string(spacing));
+}
+
+void _checkSpacing(const SectionTypeParameters& spacings) {
+    for (const auto& kv : spacings) {
+        _checkSpacing(kv.second);
+    }
+}
+
+void _checkTolerance(floatType tolerance) {
+    if (!(tolerance >= 0))
+        throw MorphioError("Simplify: the tolerance must be positive or zero, got " +
+                           std::to_string(tolerance));
+}
+
+void _checkTolerance(const SectionTypeParameters& tolerances) {
+    for (const auto& kv : tolerances) {
+        _checkTolerance(kv.second);
+    }
+}
+
+void two_points_sections(Property::Properties& properties) {
+    _compact(properties, Connectivity(properties._sectionLevel._sections), TWO_POINTS_SECTIONS);
+}
+
+void no_duplicate_point(Property::Properties& properties) {
+    _compact(properties, Connectivity(properties._sectionLevel._sections), NO_DUPLICATES);
+}
+
+void soma_sphere(Property::Properties& properties) {
+    auto& soma = properties._somaLevel;
+    floatType size = static_cast<morphio::floatType>(soma._points.size());
+
+    if (size < 2)
+        return;
+
+    floatType x = 0, y = 0, z = 0, r = 0;
+    for (const Point& point : soma._points) {
+        x += point[0] / size;
+        y += point[1] / size;
+        z += point[2] / size;
+    }
+
+    for (const Point& point : soma._points) {
+#ifdef MORPHIO_USE_DOUBLE
+        r += sqrt(pow(point[0] - x, 2) + pow(point[1] - y, 2) + pow(point[2] - z, 2)) / size;
+#else
+        r += sqrtf(powf(point[0] - x, 2) + powf(point[1] - y, 2) + powf(point[2] - z, 2)) / size;
+#endif
+    }
+
+    soma._points = {{x, y, z}};
+    soma._diameters = {r};
+}
+
+void nrn_order(Property::Properties& properties) {
+    _compact(properties, Connectivity(properties._sectionLevel._sections), NRN_ORDER);
+}
+
+void resample(Property::Properties& properties, floatType spacing) {
+    _checkSpacing(spacing);
+    _rewriteSections(
+        properties, [&spacing](SectionType) { return &spacing; }, _resampleSection);
+}
+
+void resample(Property::Properties& properties, const SectionTypeParameters& spacings) {
+    _checkSpacing(spacings);
+    _rewriteSections(
+        properties,
+        [&spacings](SectionType type) -> const floatType* {
+            const auto it = spacings.find(type);
+            return it == spacings.end() ? nullptr : &it->second;
+        },
+        _resampleSection);
+}
+
+void simplify(Property::Properties& properties, floatType tolerance) {
+    _checkTolerance(tolerance);
+    _rewriteSections(
+        properties, [&tolerance](SectionType) { return &tolerance; }, _simplifySection);
+}
+
+void simplify(Property::Properties& properties, const SectionTypeParameters& tolerances) {
+    _checkTolerance(tolerances);
+    _rewriteSections(
+        properties,
+        [&tolerances](SectionType type) -> const floatType* {
+            const auto it = tolerances.find(type);
+            return it == tolerances.end() ? nullptr : &it->second;
+        },
+        _simplifySection);
+}
+
+bool isCompact(const Property::Properties& properties) {
+    const auto& sections = properties._sectionLevel._sections;
+    const Connectivity connectivity(sections);
+    const std::vector<uint32_t> order = _depthFirstOrder(connectivity, connectivity.roots());
+    if (order.size() != sections.size() || (!sections.empty() && sections[0][0] != 0))
+        return false;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (order[i] != i || (i > 0 && sections[i][0] < sections[i - 1][0]))
+            return false;
+    }
+    return true;
+}
+
+void apply(Property::Properties& properties, unsigned int modifierFlags) {
+    // Points loaded lazily are not read: compact sections are kept as they are
+    if (properties._lazyPointLevel) {
+        _reorderMitochondria(properties);
+        return;
+    }
+
+    const Connectivity connectivity(properties._sectionLevel._sections);
+    _checkSections(properties, connectivity);
+
+    if (modifierFlags & SOMA_SPHERE)
+        soma_sphere(properties);
+
+    _compact(properties, connectivity, modifierFlags);
+    _reorderMitochondria(properties);
+}
+
+}  // namespace modifiers
+}  // namespace morphio
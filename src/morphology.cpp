@@ -1,54 +1,137 @@
+#include <algorithm>  // std::transform
 #include <fstream>
+#include <functional>  // std::function
 #include <memory>
 #include <streambuf>
 
 #include <morphio/endoplasmic_reticulum.h>
+#include <morphio/io_policy.h>
 #include <morphio/mitochondria.h>
+#include <morphio/modifiers.h>
 #include <morphio/morphology.h>
 #include <morphio/section.h>
 #include <morphio/soma.h>
+#include <morphio/vector_types.h>  // distance
 
 #include <morphio/mut/morphology.h>
 
+#include "io_policy.h"
+#include "morphology_loading.h"
+#include "parse_cache.h"
+#include "readers/fileAccess.h"
+#include "readers/gzip.h"
 #include "readers/morphologyASC.h"
+#include "readers/morphologyBinary.h"
 #include "readers/morphologyHDF5.h"
 #include "readers/morphologySWC.h"
+#include "serialization.h"
 
 namespace morphio {
-void buildChildren(std::shared_ptr<Property::Properties> properties);
-SomaType getSomaType(long unsigned int nSomaPoints);
-Property::Properties loadURI(const std::string& source, unsigned int options);
 
-Morphology::Morphology(const Property::Properties& properties, unsigned int options)
-    : _properties(std::make_shared<Property::Properties>(properties)) {
-    buildChildren(_properties);
-
-    if (_properties->_cellLevel.fileFormat() != "swc")
+Morphology::Morphology(Property::Properties properties,
+                       unsigned int options,
+                       const LoadOptions& loadOptions)
+    : _properties(std::make_shared<Property::Properties>(std::move(properties))) {
+    // The binary format stores the soma type that was computed when it was written
+    const std::string fileFormat = _properties->_cellLevel.fileFormat();
+    if (fileFormat != "swc" && fileFormat != "morphio")
         _properties->_cellLevel._somaType = getSomaType(soma().points().size());
 
-    // For SWC and ASC, sanitization and modifier application are already taken care of by
-    // their respective loaders
-    if (properties._cellLevel.fileFormat() == "h5") {
-        mut::Morphology mutable_morph(*this);
-        if (options) {
-            mutable_morph.applyModifiers(options);
-        }
-        _properties = std::make_shared<Property::Properties>(mutable_morph.buildReadOnly());
-        buildChildren(_properties);
+    const bool simplify = loadOptions.simplifyTolerance != 0;
+    const bool resample = loadOptions.resampleSpacing != 0;
+
+    // The modifiers, and the reordering of sections, need all the points: nothing is left to
+    // load lazily
+    if (_properties->_lazyPointLevel && (options != NO_MODIFIER || simplify || resample ||
+                                         !modifiers::isCompact(*_properties))) {
+        _properties->_pointLevel = _properties->_lazyPointLevel->all();
+        _properties->_lazyPointLevel.reset();
     }
+
+    // For SWC and ASC, sanitization and modifier application are already taken care of by
+    // their respective loaders. A MorphIO binary file was written from a built morphology: its
+    // compact sections are kept as they are when there is no modifier, instead of being copied
+    // by the compaction.
+    const bool built = fileFormat == "morphio" && options == NO_MODIFIER &&
+                       modifiers::isCompact(*_properties);
+    if ((fileFormat == "h5" || fileFormat == "morphio") && !built)
+        modifiers::apply(*_properties, options);
+
+    if (simplify)
+        modifiers::simplify(*_properties, loadOptions.simplifyTolerance);
+    if (resample)
+        modifiers::resample(*_properties, loadOptions.resampleSpacing);
+
+    buildChildren(_properties);
 }
 
-Morphology::Morphology(const HighFive::Group& group, unsigned int options)
-    : Morphology(readers::h5::load(group), options) {}
+Morphology::Morphology(std::shared_ptr<Property::Properties> properties)
+    : _properties(std::move(properties)) {}
 
-Morphology::Morphology(const std::string& source, unsigned int options)
-    : Morphology(loadURI(source, options), options) {}
+Morphology::Morphology(const HighFive::Group& group,
+                       unsigned int options,
+                       const LoadOptions& loadOptions)
+    : Morphology(readers::h5::load(group, loadOptions), options, loadOptions) {}
+
+Morphology::Morphology(const std::string& source,
+                       unsigned int options,
+                       const LoadOptions& loadOptions)
+    : Morphology(loadURI(source, options, loadOptions), options, loadOptions) {}
 
 Morphology::Morphology(mut::Morphology morphology) {
     _properties = std::make_shared<Property::Properties>(morphology.buildReadOnly());
     buildChildren(_properties);
 }
 
+Morphology Morphology::fromArrays(Points points,
+                                  std::vector<floatType> diameters,
+                                  std::vector<floatType> perimeters,
+                                  std::vector<uint32_t> sectionOffsets,
+                                  std::vector<int32_t> sectionParents,
+                                  std::vector<SectionType> sectionTypes,
+                                  Points somaPoints,
+                                  std::vector<floatType> somaDiameters,
+                                  unsigned int options) {
+    Morphology morphology(propertiesFromArrays(std::move(points),
+                                               std::move(diameters),
+                                               std::move(perimeters),
+                                               std::move(sectionOffsets),
+                                               std::move(sectionParents),
+                                               std::move(sectionTypes),
+                                               std::move(somaPoints),
+                                               std::move(somaDiameters)),
+                          NO_MODIFIER);
+    if (options) {
+        modifiers::apply(*morphology._properties, options);
+        buildChildren(morphology._properties);
+    }
+    return morphology;
+}
+
+Morphology Morphology::fromBuffer(const char* data,
+                                  size_t size,
+                                  const std::string& format,
+                                  unsigned int options,
+                                  const LoadOptions& loadOptions) {
+    return Morphology(loadBuffer(data, size, format, options, loadOptions), options, loadOptions);
+}
+
+std::vector<char> Morphology::serialize() const {
+    if (_properties->_lazyPointLevel) {
+        Property::Properties properties = *_properties;
+        properties._pointLevel = _properties->_lazyPointLevel->all();
+        return serialization::encode(properties);
+    }
+    return serialization::encode(*_properties);
+}
+
+Morphology Morphology::deserialize(const char* data, size_t size) {
+    Morphology morphology(
+        std::make_shared<Property::Properties>(serialization::decode(data, size)));
+    buildChildren(morphology._properties);
+    return morphology;
+}
+
 Morphology::Morphology(Morphology&&) noexcept = default;
 Morphology& Morphology::operator=(Morphology&&) noexcept = default;
 
@@ -110,8 +193,14 @@ const std::vector<typename Property::Type>& Morphology::get() const {
     return _properties->get<Property>();
 }
 
-const Points& Morphology::points() const noexcept {
-    return get<Property::Point>();
+const Property::PointLevel& Morphology::_pointLevel() const {
+    if (_properties->_lazyPointLevel)
+        return _properties->_lazyPointLevel->all();
+    return _properties->_pointLevel;
+}
+
+const Points& Morphology::points() const {
+    return _pointLevel()._points;
 }
 
 std::vector<uint32_t> Morphology::sectionOffsets() const {
@@ -122,16 +211,19 @@ std::vector<uint32_t> Morphology::sectionOffsets() const {
                    indices_and_parents.end(),
                    indices.begin(),
                    [](const Property::Section::Type& pair) { return pair[0]; });
-    indices[size] = static_cast<uint32_t>(points().size());
+    // Without reading the points loaded lazily
+    indices[size] = static_cast<uint32_t>(_properties->_lazyPointLevel
+                                              ? _properties->_lazyPointLevel->size()
+                                              : points().size());
     return indices;
 }
 
 const std::vector<morphio::floatType>& Morphology::diameters() const {
-    return get<Property::Diameter>();
+    return _pointLevel()._diameters;
 }
 
 const std::vector<morphio::floatType>& Morphology::perimeters() const {
-    return get<Property::Perimeter>();
+    return _pointLevel()._perimeters;
 }
 
 const std::vector<SectionType>& Morphology::sectionTypes() const {
@@ -154,6 +246,105 @@ const MorphologyVersion& Morphology::version() const {
     return _properties->version();
 }
 
+std::vector<int32_t> Morphology::sectionParents() const {
+    const auto& sections = get<Property::Section>();
+    std::vector<int32_t> parents(sections.size());
+    std::transform(sections.begin(),
+                   sections.end(),
+                   parents.begin(),
+                   [](const Property::Section::Type& section) { return section[1]; });
+    return parents;
+}
+
+std::vector<uint32_t> Morphology::sectionPointCounts() const {
+    std::vector<uint32_t> offsets = sectionOffsets();
+    std::vector<uint32_t> counts(offsets.size() - 1);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = offsets[i + 1] - offsets[i];
+    }
+    return counts;
+}
+
+std::vector<floatType> Morphology::sectionLengths() const {
+    const std::vector<uint32_t> offsets = sectionOffsets();
+    const Points& points_ = points();
+    std::vector<floatType> lengths(offsets.size() - 1, 0);
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        for (uint32_t j = offsets[i] + 1; j < offsets[i + 1]; ++j) {
+            lengths[i] += distance(points_[j - 1], points_[j]);
+        }
+    }
+    return lengths;
+}
+
+std::vector<uint32_t> Morphology::rootSectionIds() const {
+    const auto& sections = get<Property::Section>();
+    std::vector<uint32_t> roots;
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        if (sections[i][1] < 0)
+            roots.push_back(i);
+    }
+    return roots;
+}
+
+std::pair<std::vector<uint32_t>, std::vector<uint32_t>> Morphology::sectionChildren() const {
+    const auto& sections = get<Property::Section>();
+    const auto count = static_cast<uint32_t>(sections.size());
+
+    // Counting sort of the sections by parent: children stay in increasing order
+    std::vector<uint32_t> offsets(count + 1, 0);
+    for (const auto& section : sections) {
+        if (section[1] >= 0)
+            ++offsets[static_cast<uint32_t>(section[1]) + 1];
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<uint32_t> ids(offsets[count]);
+    std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (sections[i][1] >= 0)
+            ids[next[static_cast<uint32_t>(sections[i][1])]++] = i;
+    }
+    return {std::move(offsets), std::move(ids)};
+}
+
+std::vector<uint32_t> Morphology::sectionIdsDepthFirst() const {
+    const auto children = sectionChildren();
+    const std::vector<uint32_t>& offsets = children.first;
+    const std::vector<uint32_t>& ids = children.second;
+
+    std::vector<uint32_t> order;
+    order.reserve(offsets.size() - 1);
+    const std::vector<uint32_t> roots = rootSectionIds();
+    std::vector<uint32_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+        for (uint32_t i = offsets[id + 1]; i-- > offsets[id];) {
+            stack.push_back(ids[i]);
+        }
+    }
+    return order;
+}
+
+std::vector<uint32_t> Morphology::sectionIdsBreadthFirst() const {
+    const auto children = sectionChildren();
+    const std::vector<uint32_t>& offsets = children.first;
+    const std::vector<uint32_t>& ids = children.second;
+
+    std::vector<uint32_t> order = rootSectionIds();
+    order.reserve(offsets.size() - 1);
+    // The sections appended to order are the queue
+    for (size_t next = 0; next < order.size(); ++next) {
+        const uint32_t id = order[next];
+        order.insert(order.end(), ids.begin() + offsets[id], ids.begin() + offsets[id + 1]);
+    }
+    return order;
+}
+
 depth_iterator Morphology::depth_begin() const {
     return depth_iterator(*this);
 }
@@ -203,7 +394,79 @@ void buildChildren(std::shared_ptr<Property::Properties> properties) {
     }
 }
 
-Property::Properties loadURI(const std::string& source, unsigned int options) {
+/**
+   Validate the flat arrays of Morphology::fromArrays in a single pass and move them
+   into a Property::Properties
+**/
+Property::Properties propertiesFromArrays(Points points,
+                                          std::vector<floatType> diameters,
+                                          std::vector<floatType> perimeters,
+                                          std::vector<uint32_t> sectionOffsets,
+                                          std::vector<int32_t> sectionParents,
+                                          std::vector<SectionType> sectionTypes,
+                                          Points somaPoints,
+                                          std::vector<floatType> somaDiameters) {
+    const size_t nPoints = points.size();
+    const size_t nSections = sectionTypes.size();
+
+    const auto checkSize = [](const std::string& name, size_t size, size_t expected) {
+        if (size != expected)
+            throw RawDataError("Morphology from arrays: '" + name + "' has size " +
+                               std::to_string(size) + " while " + std::to_string(expected) +
+                               " was expected");
+    };
+    checkSize("diameters", diameters.size(), nPoints);
+    if (!perimeters.empty())
+        checkSize("perimeters", perimeters.size(), nPoints);
+    checkSize("sectionParents", sectionParents.size(), nSections);
+    if (sectionOffsets.size() != nSections + 1)
+        checkSize("sectionOffsets", sectionOffsets.size(), nSections);
+    checkSize("somaDiameters", somaDiameters.size(), somaPoints.size());
+
+    if (nSections == 0 && nPoints > 0)
+        throw RawDataError("Morphology from arrays: there are points but no sections");
+    if (nSections > 0 && sectionOffsets[0] != 0)
+        throw RawDataError("Morphology from arrays: the first section offset must be 0");
+    if (sectionOffsets.size() > nSections && sectionOffsets.back() != nPoints)
+        throw RawDataError("Morphology from arrays: the last section offset must be the number "
+                           "of points");
+
+    Property::Properties properties;
+    auto& sections = properties._sectionLevel._sections;
+    sections.reserve(nSections);
+
+    for (size_t i = 0; i < nSections; ++i) {
+        const uint32_t offset = sectionOffsets[i];
+        if (offset > nPoints || (i > 0 && offset < sectionOffsets[i - 1]))
+            throw RawDataError("Morphology from arrays: section " + std::to_string(i) +
+                               " offset " + std::to_string(offset) +
+                               " is out of range or smaller than the previous one");
+
+        const int32_t parent = sectionParents[i];
+        if (parent < -1 || parent >= static_cast<int32_t>(i))
+            throw RawDataError("Morphology from arrays: section " + std::to_string(i) +
+                               " has parent " + std::to_string(parent) +
+                               ", it must be -1 or the ID of a preceding section");
+
+        const SectionType type = sectionTypes[i];
+        if (type <= SECTION_SOMA || type >= SECTION_OUT_OF_RANGE_START)
+            throw RawDataError(readers::ErrorMessages().ERROR_UNSUPPORTED_SECTION_TYPE(0, type));
+
+        sections.push_back({static_cast<int>(offset), parent});
+    }
+
+    properties._sectionLevel._sectionTypes = std::move(sectionTypes);
+    properties._pointLevel._points = std::move(points);
+    properties._pointLevel._diameters = std::move(diameters);
+    properties._pointLevel._perimeters = std::move(perimeters);
+    properties._somaLevel._points = std::move(somaPoints);
+    properties._somaLevel._diameters = std::move(somaDiameters);
+    return properties;
+}
+
+Property::Properties loadURI(const std::string& source,
+                             unsigned int options,
+                             const LoadOptions& loadOptions) {
     const size_t pos = source.find_last_of(".");
     if (pos == std::string::npos)
         throw(UnknownFileType("File has no extension"));
@@ -216,17 +479,128 @@ Property::Properties loadURI(const std::string& source, unsigned int options) {
 
     std::string extension = source.substr(pos);
 
-    auto loader = [&source, &options, &extension]() {
-        if (extension == ".h5" || extension == ".H5")
-            return readers::h5::load(source);
-        if (extension == ".asc" || extension == ".ASC")
-            return readers::asc::load(source, options);
-        if (extension == ".swc" || extension == ".SWC")
-            return readers::swc::load(source, options);
-        throw(UnknownFileType("Unhandled file type: only SWC, ASC and H5 are supported"));
+    // SWC and ASC files can be gzip compressed: the readers decompress them on the fly
+    const bool compressed = readers::isGzip(source);
+    if (compressed) {
+        const size_t innerPos = pos == 0 ? std::string::npos : source.find_last_of('.', pos - 1);
+        if (innerPos != std::string::npos)
+            extension = source.substr(innerPos, pos - innerPos);
+        if (extension != ".swc" && extension != ".SWC" && extension != ".asc" &&
+            extension != ".ASC")
+            throw(UnknownFileType(
+                "Unhandled file type: only SWC and ASC files can be gzip compressed"));
+    }
+
+    const io_policy::StatsScope stats;
+    IOPolicy policy = loadOptions.ioPolicy;
+    if (policy == IO_READAHEAD) {
+        readers::adviseReadahead(source);
+        policy = IO_DEFAULT;
+    }
+    // Compressed files are decompressed on the fly, never read whole
+    if (compressed) {
+        policy = IO_DEFAULT;
+    }
+
+    // Read the whole file in memory then call parse(data, size)
+    using BufferParser = std::function<Property::Properties(const char*, size_t)>;
+    auto inMemory = [&source, policy](const BufferParser& parse) {
+        if (policy == IO_MMAP) {
+            const readers::Mapping mapping(source);
+            return parse(mapping.data(), mapping.size());
+        }
+        const std::vector<char> content = readers::readFile(source);
+        return parse(content.data(), content.size());
+    };
+
+    auto loader = [&source, &options, &loadOptions, &extension, &inMemory, policy, compressed]() {
+        if (extension == ".h5" || extension == ".H5") {
+            if (policy == IO_DEFAULT)
+                return readers::h5::load(source, loadOptions);
+            return inMemory([&source, &loadOptions](const char* data, size_t size) {
+                return readers::h5::loadBuffer(data, size, source, loadOptions);
+            });
+        }
+        if (extension == ".asc" || extension == ".ASC") {
+            const BufferParser parseBuffer = [&source, options, &loadOptions](const char* data,
+                                                                              size_t size) {
+                return readers::asc::loadBuffer(data, size, source, options, loadOptions);
+            };
+            return parse_cache::loadOrParse(
+                source,
+                options,
+                loadOptions,
+                [&]() {
+                    if (policy == IO_DEFAULT)
+                        return readers::asc::load(source, options, loadOptions);
+                    return inMemory(parseBuffer);
+                },
+                // The reader decompresses compressed files itself
+                compressed ? nullptr : parseBuffer);
+        }
+        if (extension == ".swc" || extension == ".SWC") {
+            const BufferParser parseBuffer = [&source, options, &loadOptions](const char* data,
+                                                                              size_t size) {
+                return readers::swc::loadBuffer(data, size, source, options, loadOptions);
+            };
+            return parse_cache::loadOrParse(
+                source,
+                options,
+                loadOptions,
+                [&]() {
+                    if (policy == IO_DEFAULT)
+                        return readers::swc::load(source, options, loadOptions);
+                    return inMemory(parseBuffer);
+                },
+                compressed ? nullptr : parseBuffer);
+        }
+        if (extension == ".morphio" || extension == ".MORPHIO") {
+            // Always mapped, unless the file must be read with a single request
+            if (policy != IO_SLURP)
+                return readers::binary::load(source, loadOptions);
+            return inMemory([&source, &loadOptions](const char* data, size_t size) {
+                try {
+                    return serialization::decode(data, size, loadOptions);
+                } catch (const RawDataError& exc) {
+                    throw RawDataError("File: " + source + ": " + exc.what());
+                }
+            });
+        }
+        throw(UnknownFileType(
+            "Unhandled file type: only SWC, ASC, H5 and MORPHIO are supported"));
     };
 
     return loader();
 }
 
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& format,
+                                unsigned int options,
+                                const LoadOptions& loadOptions) {
+    std::string lowerFormat(format);
+    std::transform(lowerFormat.begin(), lowerFormat.end(), lowerFormat.begin(), my_tolower);
+    if (!lowerFormat.empty() && lowerFormat[0] == '.')
+        lowerFormat.erase(0, 1);
+
+    // Only used in error messages
+    const std::string uri = "<" + lowerFormat + " buffer>";
+
+    if (lowerFormat == "h5")
+        return readers::h5::loadBuffer(data, size, uri, loadOptions);
+    if (lowerFormat == "asc")
+        return readers::asc::loadBuffer(data, size, uri, options, loadOptions);
+    if (lowerFormat == "swc")
+        return readers::swc::loadBuffer(data, size, uri, options, loadOptions);
+    if (lowerFormat == "morphio") {
+        try {
+            return serialization::decode(data, size, loadOptions);
+        } catch (const RawDataError& e) {
+            throw RawDataError(uri + ": " + e.what());
+        }
+    }
+    throw(UnknownFileType("Unhandled format: " + format +
+                          ", only SWC, ASC, H5 and MORPHIO are supported"));
+}
+
 }  // namespace morphio
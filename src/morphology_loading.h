@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>  // std::shared_ptr
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/properties.h>
+
+/**
+   The steps of the loading of a morphology implemented in morphology.cpp, shared with the
+   other places building properties: the mutable morphology and morphio::stream
+**/
+namespace morphio {
+/** Fill the children maps of the sections and mitochondrial sections **/
+void buildChildren(std::shared_ptr<Property::Properties> properties);
+
+/** The soma type of a soma of nSomaPoints points, for the formats not storing it **/
+SomaType getSomaType(long unsigned int nSomaPoints);
+
+/** Load the properties of the morphology at source, a path or an archive member **/
+Property::Properties loadURI(const std::string& source,
+                             unsigned int options,
+                             const LoadOptions& loadOptions);
+
+/** Load the properties of a morphology from the content of a file in memory **/
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& format,
+                                unsigned int options,
+                                const LoadOptions& loadOptions);
+
+/** The properties of Morphology::fromArrays, see there for the arguments **/
+Property::Properties propertiesFromArrays(Points points,
+                                          std::vector<floatType> diameters,
+                                          std::vector<floatType> perimeters,
+                                          std::vector<uint32_t> sectionOffsets,
+                                          std::vector<int32_t> sectionParents,
+                                          std::vector<SectionType> sectionTypes,
+                                          Points somaPoints,
+                                          std::vector<floatType> somaDiameters);
+}  // namespace morphio
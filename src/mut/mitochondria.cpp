@@ -9,6 +9,17 @@
 namespace morphio {
 namespace mut {
 
+Mitochondria::Mitochondria(Mitochondria&& mitochondria) noexcept
+    : _counter(mitochondria._counter)
+    , _children(std::move(mitochondria._children))
+    , _parent(std::move(mitochondria._parent))
+    , _rootSections(std::move(mitochondria._rootSections))
+    , _sections(std::move(mitochondria._sections)) {
+    for (const auto& kv : _sections) {
+        kv.second->_mitochondria = this;
+    }
+}
+
 Mitochondria::MitoSectionP Mitochondria::appendRootSection(const morphio::MitoSection& section_,
                                                            bool recursive) {
     const auto ptr = std::make_shared<MitoSection>(this, _counter, section_);
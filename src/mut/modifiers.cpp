@@ -3,36 +3,57 @@
 #include <morphio/mut/modifiers.h>
 #include <morphio/mut/morphology.h>
 
+#include "../section_kernels.h"
+
 namespace morphio {
 namespace mut {
 namespace modifiers {
 
+/**
+   Throw before modifying anything if a section whose number of points `resized` would change
+   has writable views
+**/
+template <typename Resized>
+static void _throwIfWritableViews(morphio::mut::Morphology& morpho, Resized resized) {
+    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
+        const Section& section = **it;
+        if (resized(section))
+            section.throwIfWritableViews();
+    }
+}
+
 void two_points_sections(morphio::mut::Morphology& morpho) {
+    _throwIfWritableViews(morpho, [](const Section& section) {
+        return section.points().size() > 2;
+    });
     for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
         std::shared_ptr<Section> section = *it;
-        size_t size = section->points().size();
+        const Property::PointLevel& from = static_cast<const Section&>(*section).properties();
+        size_t size = from._points.size();
         if (size < 2)
             continue;
-        section->points() = {section->points()[0], section->points()[size - 1]};
-        section->diameters() = {section->diameters()[0], section->diameters()[size - 1]};
-        if (!section->perimeters().empty())
-            section->perimeters() = {section->perimeters()[0], section->perimeters()[size - 1]};
+        Property::PointLevel to({from._points[0], from._points[size - 1]},
+                                {from._diameters[0], from._diameters[size - 1]});
+        if (!from._perimeters.empty())
+            to._perimeters = {from._perimeters[0], from._perimeters[size - 1]};
+        section->setProperties(std::move(to));
     }
 }
 
 void no_duplicate_point(morphio::mut::Morphology& morpho) {
+    _throwIfWritableViews(morpho, [](const Section& section) {
+        return !section.points().empty() && !section.isRoot();
+    });
     for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
         std::shared_ptr<Section> section = *it;
-        size_t size = section->points().size();
+        const Property::PointLevel& from = static_cast<const Section&>(*section).properties();
+        size_t size = from._points.size();
 
         if (size < 1 || (*it)->isRoot())
             continue;
 
-        section->points().erase(section->points().begin());
-        section->diameters().erase(section->diameters().begin());
-
-        if (!section->perimeters().empty())
-            section->perimeters().erase(section->perimeters().begin());
+        Property::PointLevel to(from, SectionRange{1, size});
+        section->setProperties(std::move(to));
     }
 }
 
@@ -42,6 +63,7 @@ void soma_sphere(morphio::mut::Morphology& morpho) {
 
     if (size < 2)
         return;
+    soma->throwIfWritableViews();
 
     floatType x = 0, y = 0, z = 0, r = 0;
     for (const Point& point : soma->points()) {
@@ -62,7 +84,8 @@ void soma_sphere(morphio::mut::Morphology& morpho) {
     soma->diameters() = {r};
 }
 
-static bool NRN_order_comparator(std::shared_ptr<Section> a, std::shared_ptr<Section> b) {
+static bool NRN_order_comparator(const std::shared_ptr<const Section>& a,
+                                 const std::shared_ptr<const Section>& b) {
     return a->type() < b->type();
 }
 
@@ -72,6 +95,74 @@ void nrn_order(morphio::mut::Morphology& morpho) {
                      NRN_order_comparator);
 }
 
+/**
+   Replace the points of every section for which `parameterOf(type)` is not null
+**/
+template <typename ParameterOf, typename Kernel>
+static void _rewriteSections(morphio::mut::Morphology& morpho,
+                             ParameterOf parameterOf,
+                             Kernel kernel) {
+    // All sections are rewritten once none of the resized ones has writable views
+    std::vector<std::pair<std::shared_ptr<Section>, Property::PointLevel>> rewritten;
+    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
+        const std::shared_ptr<Section>& section = *it;
+        // const access: untouched sections must not be flagged as modified
+        const Section& constSection = *section;
+        const floatType* parameter = parameterOf(constSection.type());
+        if (parameter == nullptr)
+            continue;
+
+        const Property::PointLevel& from = constSection.properties();
+        Property::PointLevel to;
+        kernel(from, SectionRange{0, from._points.size()}, *parameter, to);
+        if (to._points.size() != from._points.size())
+            constSection.throwIfWritableViews();
+        rewritten.emplace_back(section, std::move(to));
+    }
+
+    for (auto& kv : rewritten) {
+        kv.first->setProperties(std::move(kv.second));
+    }
+}
+
+void resample(morphio::mut::Morphology& morpho, floatType spacing) {
+    morphio::modifiers::_checkSpacing(spacing);
+    _rewriteSections(
+        morpho, [&spacing](SectionType) { return &spacing; }, morphio::modifiers::_resampleSection);
+}
+
+void resample(morphio::mut::Morphology& morpho,
+              const morphio::modifiers::SectionTypeParameters& spacings) {
+    morphio::modifiers::_checkSpacing(spacings);
+    _rewriteSections(
+        morpho,
+        [&spacings](SectionType type) -> const floatType* {
+            const auto it = spacings.find(type);
+            return it == spacings.end() ? nullptr : &it->second;
+        },
+        morphio::modifiers::_resampleSection);
+}
+
+void simplify(morphio::mut::Morphology& morpho, floatType tolerance) {
+    morphio::modifiers::_checkTolerance(tolerance);
+    _rewriteSections(
+        morpho,
+        [&tolerance](SectionType) { return &tolerance; },
+        morphio::modifiers::_simplifySection);
+}
+
+void simplify(morphio::mut::Morphology& morpho,
+              const morphio::modifiers::SectionTypeParameters& tolerances) {
+    morphio::modifiers::_checkTolerance(tolerances);
+    _rewriteSections(
+        morpho,
+        [&tolerances](SectionType type) -> const floatType* {
+            const auto it = tolerances.find(type);
+            return it == tolerances.end() ? nullptr : &it->second;
+        },
+        morphio::modifiers::_simplifySection);
+}
+
 }  // namespace modifiers
 
 }  // namespace mut
@@ -1,7 +1,9 @@
 #include <assert.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/mito_section.h>
@@ -12,6 +14,7 @@
 #include <morphio/soma.h>
 #include <morphio/tools.h>
 
+#include "../morphology_loading.h"
 #include "../shared_utils.hpp"
 
 namespace morphio {
@@ -20,8 +23,10 @@ namespace mut {
 void _appendProperties(Property::PointLevel& to, const Property::PointLevel& from, int offset);
 
 using morphio::readers::ErrorMessages;
-Morphology::Morphology(const std::string& uri, unsigned int options)
-    : Morphology(morphio::Morphology(uri, options)) {}
+Morphology::Morphology(const std::string& uri,
+                       unsigned int options,
+                       const LoadOptions& loadOptions)
+    : Morphology(morphio::Morphology(uri, options, loadOptions)) {}
 
 Morphology::Morphology(const morphio::mut::Morphology& morphology, unsigned int options)
     : _counter(0)
@@ -40,6 +45,26 @@ Morphology::Morphology(const morphio::mut::Morphology& morphology, unsigned int
     applyModifiers(options);
 }
 
+Morphology::Morphology(morphio::mut::Morphology&& morphology) noexcept
+    : _err(std::move(morphology._err))
+    , _counter(morphology._counter)
+    , _soma(std::move(morphology._soma))
+    , _cellProperties(std::move(morphology._cellProperties))
+    , _rootSections(std::move(morphology._rootSections))
+    , _sections(std::move(morphology._sections))
+    , _mitochondria(std::move(morphology._mitochondria))
+    , _endoplasmicReticulum(std::move(morphology._endoplasmicReticulum))
+    , _parent(std::move(morphology._parent))
+    , _children(std::move(morphology._children))
+    , _checkoutSource(morphology._checkoutSource)
+    , _checkoutRoot(morphology._checkoutRoot) {
+    for (const auto& kv : _sections) {
+        kv.second->_morphology = this;
+    }
+    morphology._rootSections.clear();
+    morphology._sections.clear();
+}
+
 Morphology::Morphology(const morphio::Morphology& morphology, unsigned int options)
     : _counter(0)
     , _soma(std::make_shared<Soma>(morphology.soma()))
@@ -63,14 +88,18 @@ Morphology::Morphology(const morphio::Morphology& morphology, unsigned int optio
  **/
 bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
                           const std::shared_ptr<Section>& current) {
+    // Const access: reading the data must not flag it as modified, see buildReadOnly()
+    const Section& parentSection = *parent;
+    const Section& currentSection = *current;
+
     // Weird edge case where parent is empty: skipping it
-    if (parent->points().empty())
+    if (parentSection.points().empty())
         return true;
 
-    if (current->points().empty())
+    if (currentSection.points().empty())
         return false;
 
-    if (parent->points().back() != current->points().front())
+    if (parentSection.points().back() != currentSection.points().front())
         return false;
 
     // // As perimeter is optional, it must either be defined for parent and
@@ -93,7 +122,7 @@ std::shared_ptr<Section> Morphology::appendRootSection(const morphio::Section& s
     _register(ptr);
     _rootSections.push_back(ptr);
 
-    const bool emptySection = ptr->points().empty();
+    const bool emptySection = ptr->_pointProperties._points.empty();
     if (emptySection)
         printError(Warning::APPENDING_EMPTY_SECTION, _err.WARNING_APPENDING_EMPTY_SECTION(ptr));
 
@@ -111,7 +140,7 @@ std::shared_ptr<Section> Morphology::appendRootSection(const std::shared_ptr<Sec
     const std::shared_ptr<Section> section_copy(new Section(this, _counter, *section_));
     _register(section_copy);
     _rootSections.push_back(section_copy);
-    const bool emptySection = section_copy->points().empty();
+    const bool emptySection = section_copy->_pointProperties._points.empty();
     if (emptySection)
         printError(Warning::APPENDING_EMPTY_SECTION,
                    _err.WARNING_APPENDING_EMPTY_SECTION(section_copy));
@@ -131,7 +160,7 @@ std::shared_ptr<Section> Morphology::appendRootSection(const Property::PointLeve
     _register(ptr);
     _rootSections.push_back(ptr);
 
-    bool emptySection = ptr->points().empty();
+    bool emptySection = ptr->_pointProperties._points.empty();
     if (emptySection)
         printError(Warning::APPENDING_EMPTY_SECTION, _err.WARNING_APPENDING_EMPTY_SECTION(ptr));
 
@@ -147,6 +176,58 @@ uint32_t Morphology::_register(const std::shared_ptr<Section>& section_) {
     return section_->id();
 }
 
+Morphology Morphology::fromArrays(Points points,
+                                  std::vector<floatType> diameters,
+                                  std::vector<floatType> perimeters,
+                                  std::vector<uint32_t> sectionOffsets,
+                                  std::vector<int32_t> sectionParents,
+                                  std::vector<SectionType> sectionTypes,
+                                  Points somaPoints,
+                                  std::vector<floatType> somaDiameters,
+                                  unsigned int options) {
+    const Property::Properties properties = propertiesFromArrays(std::move(points),
+                                                                 std::move(diameters),
+                                                                 std::move(perimeters),
+                                                                 std::move(sectionOffsets),
+                                                                 std::move(sectionParents),
+                                                                 std::move(sectionTypes),
+                                                                 std::move(somaPoints),
+                                                                 std::move(somaDiameters));
+
+    Morphology morphology;
+    morphology._soma->_pointProperties = properties._somaLevel;
+    morphology._soma->_somaType = getSomaType(properties._somaLevel._points.size());
+
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& types = properties._sectionLevel._sectionTypes;
+    const size_t nPoints = properties._pointLevel._points.size();
+
+    // IDs are increasing and parents precede their children: every insertion is at the end
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        const size_t last = i + 1 < sections.size() ? static_cast<size_t>(sections[i + 1][0])
+                                                    : nPoints;
+        const std::shared_ptr<Section> section(
+            new Section(&morphology, i, types[i], Property::PointLevel()));
+        section->_pointProperties = Property::PointLevel(
+            properties._pointLevel, {static_cast<size_t>(sections[i][0]), last});
+        morphology._sections.emplace_hint(morphology._sections.end(), i, section);
+
+        const int32_t parent = sections[i][1];
+        if (parent == -1) {
+            morphology._rootSections.push_back(section);
+        } else {
+            morphology._parent.emplace_hint(morphology._parent.end(),
+                                            i,
+                                            static_cast<uint32_t>(parent));
+            morphology._children[static_cast<uint32_t>(parent)].push_back(section);
+        }
+    }
+    morphology._counter = static_cast<uint32_t>(sections.size());
+
+    morphology.applyModifiers(options);
+    return morphology;
+}
+
 Morphology::~Morphology() {
     auto roots = _rootSections;  // Need to iterate on a copy
     for (const auto& root : roots) {
@@ -198,6 +279,127 @@ void Morphology::deleteSection(std::shared_ptr<Section> section_, bool recursive
     }
 }
 
+namespace {
+std::vector<std::shared_ptr<Section>>::const_iterator _findRootSection(
+    const std::vector<std::shared_ptr<Section>>& rootSections, uint32_t rootId) {
+    const auto root = std::find_if(rootSections.begin(),
+                                   rootSections.end(),
+                                   [rootId](const std::shared_ptr<Section>& section) {
+                                       return section->id() == rootId;
+                                   });
+    if (root == rootSections.end())
+        throw SectionBuilderError("Section " + std::to_string(rootId) +
+                                  " is not a root section of the morphology");
+    return root;
+}
+}  // namespace
+
+std::unique_ptr<Morphology> Morphology::checkoutNeurite(uint32_t rootId) const {
+    const std::shared_ptr<Section>& root = *_findRootSection(_rootSections, rootId);
+
+    std::unique_ptr<Morphology> neurite(new Morphology());
+    neurite->_soma = std::make_shared<Soma>(*_soma);
+    neurite->_cellProperties = std::make_shared<Property::CellLevel>(*_cellProperties);
+
+    std::vector<std::shared_ptr<Section>> stack{root};
+    while (!stack.empty()) {
+        const std::shared_ptr<Section> original = stack.back();
+        stack.pop_back();
+
+        const std::shared_ptr<Section> copy(
+            new Section(neurite.get(), original->id(), *original));
+        neurite->_register(copy);
+        if (original == root) {
+            neurite->_rootSections.push_back(copy);
+        } else {
+            const uint32_t parentId = _parent.at(original->id());
+            neurite->_parent[copy->id()] = parentId;
+            neurite->_children[parentId].push_back(copy);
+        }
+
+        const auto children = _children.find(original->id());
+        if (children != _children.end())
+            stack.insert(stack.end(), children->second.rbegin(), children->second.rend());
+    }
+
+    // New sections are numbered after all the sections of this morphology
+    neurite->_counter = std::max(neurite->_counter, _counter);
+    neurite->_checkoutSource = this;
+    neurite->_checkoutRoot = rootId;
+    return neurite;
+}
+
+void Morphology::mergeNeurite(uint32_t rootId, Morphology&& neurite) {
+    if (&neurite == this)
+        throw SectionBuilderError("Neurite merge: cannot merge a morphology into itself");
+    if (neurite._checkoutSource != this || neurite._checkoutRoot != rootId)
+        throw SectionBuilderError("Neurite merge: the neurite was not checked out from section " +
+                                  std::to_string(rootId) + " of this morphology");
+    const auto rootPosition = _rootSections.begin() +
+                              std::distance(_rootSections.cbegin(),
+                                            _findRootSection(_rootSections, rootId));
+
+    // The sections currently in the neurite
+    std::unordered_set<uint32_t> replaced;
+    std::vector<uint32_t> stack{rootId};
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        replaced.insert(id);
+        const auto children = _children.find(id);
+        if (children != _children.end()) {
+            for (const auto& child : children->second)
+                stack.push_back(child->id());
+        }
+    }
+
+    // Sections already in the neurite keep their IDs, the others get new ones
+    std::map<uint32_t, uint32_t> newIds;
+    uint32_t counter = _counter;
+    for (const auto& kv : neurite._sections) {
+        newIds[kv.first] = replaced.count(kv.first) ? kv.first : counter++;
+    }
+
+    // Nothing below can throw: detach the current neurite...
+    for (uint32_t id : replaced) {
+        const auto section = _sections.find(id);
+        section->second->_morphology = nullptr;
+        section->second->_id = 0xffffffff;
+        _sections.erase(section);
+        _parent.erase(id);
+        _children.erase(id);
+    }
+
+    // ... and move in the sections of the checked out one
+    for (const auto& kv : neurite._sections) {
+        const std::shared_ptr<Section>& section = kv.second;
+        section->_morphology = this;
+        section->_id = newIds.at(kv.first);
+        _sections[section->_id] = section;
+    }
+    // Deleting sections may leave entries of unknown sections behind: skip them
+    for (const auto& kv : neurite._parent) {
+        const auto id = newIds.find(kv.first);
+        const auto parentId = newIds.find(kv.second);
+        if (id != newIds.end() && parentId != newIds.end())
+            _parent[id->second] = parentId->second;
+    }
+    for (auto& kv : neurite._children) {
+        const auto id = newIds.find(kv.first);
+        if (id != newIds.end())
+            _children[id->second] = std::move(kv.second);
+    }
+
+    const auto position = _rootSections.erase(rootPosition);
+    _rootSections.insert(position, neurite._rootSections.begin(), neurite._rootSections.end());
+    _counter = counter;
+
+    neurite._rootSections.clear();
+    neurite._sections.clear();
+    neurite._checkoutSource = nullptr;
+    neurite._parent.clear();
+    neurite._children.clear();
+}
 
 void _appendProperties(Property::PointLevel& to, const Property::PointLevel& from, int offset = 0) {
     _appendVector(to._points, from._points, offset);
@@ -240,21 +442,22 @@ void Morphology::removeUnifurcations(const morphio::readers::DebugInfo& debugInf
         if (isUnifurcation) {
             printError(Warning::ONLY_CHILD, err.WARNING_ONLY_CHILD(debugInfo, parentId, sectionId));
             bool duplicate = _checkDuplicatePoint(section_->parent(), section_);
+            parent->throwIfWritableViews();
 
+            const Property::PointLevel& from = section_->_pointProperties;
             addAnnotation(morphio::Property::Annotation(morphio::AnnotationType::SINGLE_CHILD,
                                                         sectionId,
-                                                        section_->properties(),
+                                                        from,
                                                         "",
                                                         debugInfo.getLineNumber(parentId)));
 
-            morphio::_appendVector(parent->points(), section_->points(), duplicate ? 1 : 0);
+            Property::PointLevel& to = parent->_pointProperties;
+            morphio::_appendVector(to._points, from._points, duplicate ? 1 : 0);
 
-            morphio::_appendVector(parent->diameters(), section_->diameters(), duplicate ? 1 : 0);
+            morphio::_appendVector(to._diameters, from._diameters, duplicate ? 1 : 0);
 
-            if (!parent->perimeters().empty())
-                morphio::_appendVector(parent->perimeters(),
-                                       section_->perimeters(),
-                                       duplicate ? 1 : 0);
+            if (!to._perimeters.empty())
+                morphio::_appendVector(to._perimeters, from._perimeters, duplicate ? 1 : 0);
 
             deleteSection(section_, false);
         }
@@ -279,25 +482,38 @@ void Morphology::_raiseIfUnifurcations() {
 }
 
 Property::Properties Morphology::buildReadOnly() const {
-    using std::setw;
-    int sectionIdOnDisk = 0;
-    std::map<uint32_t, int32_t> newIds;
     Property::Properties properties{};
 
     properties._cellLevel = *_cellProperties;
     properties._cellLevel._somaType = _soma->type();
     _appendProperties(properties._somaLevel, _soma->_pointProperties);
 
-    for (auto it = depth_begin(); it != depth_end(); ++it) {
-        const std::shared_ptr<Section>& section_ = *it;
-        unsigned int sectionId = section_->id();
-        int parentOnDisk = (section_->isRoot() ? -1 : newIds[section_->parent()->id()]);
+    // Depth first walk: (section, parent section ID on disk). Sections are numbered in the
+    // order they are written, so the ID on disk of a parent is known when its children are
+    // pushed: no renumbering map is needed.
+    std::vector<std::pair<const Section*, int32_t>> stack;
+    for (auto it = _rootSections.rbegin(); it != _rootSections.rend(); ++it) {
+        stack.emplace_back(it->get(), -1);
+    }
 
-        auto start = static_cast<int>(properties._pointLevel._points.size());
-        properties._sectionLevel._sections.push_back({start, parentOnDisk});
-        properties._sectionLevel._sectionTypes.push_back(section_->type());
-        newIds[sectionId] = sectionIdOnDisk++;
-        _appendProperties(properties._pointLevel, section_->_pointProperties);
+    auto& sectionLevel = properties._sectionLevel;
+    sectionLevel._sections.reserve(_sections.size());
+    sectionLevel._sectionTypes.reserve(_sections.size());
+    while (!stack.empty()) {
+        const Section& section = *stack.back().first;
+        const int32_t parentOnDisk = stack.back().second;
+        stack.pop_back();
+
+        const auto sectionOnDisk = static_cast<int32_t>(sectionLevel._sections.size());
+        sectionLevel._sections.push_back(
+            {static_cast<int>(properties._pointLevel._points.size()), parentOnDisk});
+        sectionLevel._sectionTypes.push_back(section._sectionType);
+        _appendProperties(properties._pointLevel, section._pointProperties);
+
+        const auto& children = section.children();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.emplace_back(it->get(), sectionOnDisk);
+        }
     }
 
     mitochondria()._buildMitochondria(properties);
@@ -369,7 +585,7 @@ void Morphology::write(const std::string& filename) {
     std::string extension;
 
     for (const auto& root : rootSections()) {
-        if (root->points().size() < 2)
+        if (root->_pointProperties._points.size() < 2)
             throw morphio::SectionBuilderError("Root sections must have at least 2 points");
     }
 
@@ -380,6 +596,8 @@ void Morphology::write(const std::string& filename) {
         writer::h5(*this, filename);
     else if (extension == ".asc")
         writer::asc(*this, filename);
+    else if (extension == ".morphio")
+        writer::binary(*this, filename);
     else if (extension == ".swc") {
         _raiseIfUnifurcations();
         writer::swc(*this, filename);
@@ -1,3 +1,4 @@
+#include <algorithm>  // std::copy
 #include <stack>
 
 #include <morphio/errorMessages.h>
@@ -10,7 +11,18 @@ namespace mut {
 using morphio::readers::ErrorMessages;
 
 static inline bool _emptySection(const std::shared_ptr<Section>& section) {
-    return section->points().empty();
+    const Section& constSection = *section;
+    return constSection.points().empty();
+}
+
+/** The points of a section of an immutable morphology, read now if they are loaded lazily **/
+static Property::PointLevel _pointLevel(const morphio::Section& section) {
+    const auto points = section.points();
+    const auto diameters = section.diameters();
+    const auto perimeters = section.perimeters();
+    return {{points.begin(), points.end()},
+            {diameters.begin(), diameters.end()},
+            {perimeters.begin(), perimeters.end()}};
 }
 
 Section::Section(Morphology* morphology,
@@ -26,7 +38,7 @@ Section::Section(Morphology* morphology, unsigned int id_, const morphio::Sectio
     : Section(morphology,
               id_,
               section_.type(),
-              Property::PointLevel(section_._properties->_pointLevel, section_._range)) {}
+              _pointLevel(section_)) {}
 
 Section::Section(Morphology* morphology, unsigned int id_, const Section& section_)
     : _morphology(morphology)
@@ -34,6 +46,33 @@ Section::Section(Morphology* morphology, unsigned int id_, const Section& sectio
     , _id(id_)
     , _sectionType(section_._sectionType) {}
 
+void Section::throwIfWritableViews() const {
+    if (_writableViews > 0)
+        throw morphio::SectionBuilderError(
+            "Cannot change the number of points of section " + std::to_string(_id) +
+            " while writable views on its data are alive");
+}
+
+void Section::setProperties(Property::PointLevel pointLevel) {
+    auto& current = _pointProperties;
+    if (pointLevel._points.size() != current._points.size() ||
+        pointLevel._diameters.size() != current._diameters.size() ||
+        pointLevel._perimeters.size() != current._perimeters.size())
+        throwIfWritableViews();
+
+    if (_writableViews > 0) {
+        std::copy(pointLevel._points.begin(), pointLevel._points.end(), current._points.begin());
+        std::copy(pointLevel._diameters.begin(),
+                  pointLevel._diameters.end(),
+                  current._diameters.begin());
+        std::copy(pointLevel._perimeters.begin(),
+                  pointLevel._perimeters.end(),
+                  current._perimeters.begin());
+    } else {
+        current = std::move(pointLevel);
+    }
+}
+
 void Section::throwIfNoOwningMorphology() const {
     if (!_morphology) {
         throw std::runtime_error("Section does not belong to a morphology, impossible operation");
@@ -185,7 +224,7 @@ std::shared_ptr<Section> Section::appendSection(const Property::PointLevel& poin
 
     auto& _sections = morphology->_sections;
     if (sectionType == SectionType::SECTION_UNDEFINED)
-        sectionType = type();
+        sectionType = _sectionType;
 
     if (sectionType == SECTION_SOMA)
         throw morphio::SectionBuilderError("Cannot create section with type soma");
@@ -19,6 +19,12 @@ Soma::Soma(const morphio::Soma& soma)
     : _somaType(soma.type())
     , _pointProperties(soma._properties->_somaLevel) {}
 
+void Soma::throwIfWritableViews() const {
+    if (_writableViews > 0)
+        throw morphio::SectionBuilderError(
+            "Cannot change the number of soma points while writable views on them are alive");
+}
+
 Point Soma::center() const {
     return centerOfGravity(points());
 }
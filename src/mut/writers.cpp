@@ -12,6 +12,9 @@
 #include <highfive/H5File.hpp>
 #include <highfive/H5Object.hpp>
 
+#include "../readers/morphologyHDF5.h"  // hdf5Mutex
+#include "../serialization.h"
+
 namespace {
 
 /**
@@ -29,7 +32,10 @@ struct base_type<std::vector<T>>: base_type<T> {};
 constexpr int FLOAT_PRECISION_PRINT = 9;
 
 bool hasPerimeterData(const morphio::mut::Morphology& morpho) {
-    return !morpho.rootSections().empty() && !morpho.rootSections().front()->perimeters().empty();
+    if (morpho.rootSections().empty())
+        return false;
+    const morphio::mut::Section& root = *morpho.rootSections().front();
+    return !root.perimeters().empty();
 }
 
 void writeLine(std::ofstream& myfile,
@@ -58,8 +64,9 @@ std::string version_string() {
 /**
    Only skip duplicate if it has the same diameter
  **/
-bool _skipDuplicate(const std::shared_ptr<morphio::mut::Section>& section) {
-    return section->diameters().front() == section->parent()->diameters().back();
+bool _skipDuplicate(const std::shared_ptr<const morphio::mut::Section>& section) {
+    const morphio::mut::Section& parent = *section->parent();
+    return section->diameters().front() == parent.diameters().back();
 }
 
 }  // anonymous namespace
@@ -111,7 +118,7 @@ void swc(const Morphology& morphology, const std::string& filename) {
     }
 
     for (auto it = morphology.depth_begin(); it != morphology.depth_end(); ++it) {
-        const std::shared_ptr<Section>& section = *it;
+        const std::shared_ptr<const Section> section = *it;
         const auto& points = section->points();
         const auto& diameters = section->diameters();
 
@@ -151,7 +158,7 @@ static void _write_asc_points(std::ofstream& myfile,
 
 static void _write_asc_section(std::ofstream& myfile,
                                const Morphology& morpho,
-                               const std::shared_ptr<Section>& section,
+                               const std::shared_ptr<const Section>& section,
                                size_t indentLevel) {
     std::string indent(indentLevel, ' ');
     _write_asc_points(myfile, section->points(), section->diameters(), indentLevel);
@@ -199,7 +206,7 @@ void asc(const Morphology& morphology, const std::string& filename) {
     }
 
     for (const auto& section : morphology.rootSections()) {
-        myfile << header.at(section->type());
+        myfile << header.at(static_cast<const Section&>(*section).type());
         _write_asc_section(myfile, morphology, section, 2);
         myfile << ")\n\n";
     }
@@ -302,7 +309,7 @@ void h5(const Morphology& morpho, const std::string& filename) {
         printError(Warning::WRITE_NO_SOMA, readers::ErrorMessages().WARNING_WRITE_NO_SOMA());
     }
 
-
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::hdf5Mutex());
     HighFive::File h5_file(filename,
                            HighFive::File::ReadWrite | HighFive::File::Create |
                                HighFive::File::Truncate);
@@ -343,7 +350,7 @@ void h5(const Morphology& morpho, const std::string& filename) {
     offset += morpho.soma()->points().size();
 
     for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
-        const std::shared_ptr<Section>& section = *it;
+        const std::shared_ptr<const Section> section = *it;
         int parentOnDisk = (section->isRoot() ? 0 : newIds[section->parent()->id()]);
 
         const auto& points = section->points();
@@ -388,6 +395,17 @@ void h5(const Morphology& morpho, const std::string& filename) {
     endoplasmicReticulumH5(h5_file, morpho.endoplasmicReticulum());
 }
 
+void binary(const Morphology& morpho, const std::string& filename) {
+    Property::Properties properties = morpho.buildReadOnly();
+    properties._cellLevel._version = MorphologyVersion{"morphio", 1, 0};
+    const std::vector<char> buffer = serialization::encode(properties);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+        throw WriterError("Could not write the morphology file " + filename);
+}
+
 }  // end namespace writer
 }  // end namespace mut
 }  // end namespace morphio
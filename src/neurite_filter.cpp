@@ -0,0 +1,201 @@
+#include <algorithm>  // std::find, std::min
+#include <cstddef>    // std::ptrdiff_t
+
+#include "neurite_filter.h"
+
+namespace morphio {
+namespace neurite_filter {
+
+namespace {
+/**
+   Return the root of the tree of each section. Parents are not required to come before their
+   children: the ancestors are walked once and memoized
+**/
+std::vector<size_t> _roots(const std::vector<Property::Section::Type>& sections) {
+    const size_t count = sections.size();
+    const size_t unknown = count;
+    std::vector<size_t> roots(count, unknown);
+    std::vector<size_t> path;
+    for (size_t i = 0; i < count; ++i) {
+        size_t current = i;
+        path.clear();
+        while (roots[current] == unknown) {
+            path.push_back(current);
+            const int parent = sections[current][1];
+            // path.size() > count: a cycle, reported later by the readers
+            if (parent < 0 || static_cast<size_t>(parent) >= count || path.size() > count) {
+                roots[current] = current;
+                break;
+            }
+            current = static_cast<size_t>(parent);
+        }
+        for (size_t id : path) {
+            roots[id] = roots[current];
+        }
+    }
+    return roots;
+}
+
+/** The end of the points of a section: the offset of the next one **/
+size_t _end(const std::vector<Property::Section::Type>& sections, size_t i, size_t nPoints) {
+    return i + 1 < sections.size() ? static_cast<size_t>(sections[i + 1][0]) : nPoints;
+}
+
+template <typename T>
+void _append(const std::vector<T>& from, size_t begin, size_t end, std::vector<T>& to) {
+    end = std::min(end, from.size());
+    if (begin < end)
+        to.insert(to.end(),
+                  from.begin() + static_cast<std::ptrdiff_t>(begin),
+                  from.begin() + static_cast<std::ptrdiff_t>(end));
+}
+
+int32_t _newId(const std::vector<int32_t>& ids, int64_t id) {
+    return id >= 0 && static_cast<uint64_t>(id) < ids.size() ? ids[static_cast<size_t>(id)] : -1;
+}
+
+void _remapMitochondria(Property::Properties& properties, const std::vector<int32_t>& ids) {
+    const auto& sections = properties._mitochondriaSectionLevel._sections;
+    const auto& pointLevel = properties._mitochondriaPointLevel;
+    const size_t nPoints = pointLevel._sectionIds.size();
+    const std::vector<size_t> roots = _roots(sections);
+
+    std::vector<bool> dropped(sections.size(), false);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const size_t end = std::min(_end(sections, i, nPoints), nPoints);
+        for (size_t point = static_cast<size_t>(sections[i][0]); point < end; ++point) {
+            if (_newId(ids, pointLevel._sectionIds[point]) < 0) {
+                dropped[roots[i]] = true;
+                break;
+            }
+        }
+    }
+
+    std::vector<int32_t> mitoIds(sections.size(), -1);
+    int32_t nextId = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!dropped[roots[i]])
+            mitoIds[i] = nextId++;
+    }
+
+    std::vector<Property::MitoSection::Type> keptSections;
+    Property::MitochondriaPointLevel kept;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (mitoIds[i] < 0)
+            continue;
+        const auto begin = static_cast<size_t>(sections[i][0]);
+        const size_t end = _end(sections, i, nPoints);
+        keptSections.push_back({static_cast<int>(kept._sectionIds.size()),
+                                _newId(mitoIds, sections[i][1])});
+        for (size_t point = begin; point < std::min(end, nPoints); ++point) {
+            kept._sectionIds.push_back(
+                static_cast<uint32_t>(_newId(ids, pointLevel._sectionIds[point])));
+        }
+        _append(pointLevel._relativePathLengths, begin, end, kept._relativePathLengths);
+        _append(pointLevel._diameters, begin, end, kept._diameters);
+    }
+
+    properties._mitochondriaSectionLevel._sections = std::move(keptSections);
+    properties._mitochondriaSectionLevel._children.clear();
+    properties._mitochondriaPointLevel = std::move(kept);
+}
+
+void _remapEndoplasmicReticulum(Property::Properties& properties,
+                                const std::vector<int32_t>& ids) {
+    const auto& reticulum = properties._endoplasmicReticulumLevel;
+    Property::EndoplasmicReticulumLevel kept;
+    for (size_t i = 0; i < reticulum._sectionIndices.size(); ++i) {
+        const int32_t id = _newId(ids, reticulum._sectionIndices[i]);
+        if (id < 0)
+            continue;
+        kept._sectionIndices.push_back(static_cast<uint32_t>(id));
+        _append(reticulum._volumes, i, i + 1, kept._volumes);
+        _append(reticulum._surfaceAreas, i, i + 1, kept._surfaceAreas);
+        _append(reticulum._filamentCounts, i, i + 1, kept._filamentCounts);
+    }
+    properties._endoplasmicReticulumLevel = std::move(kept);
+}
+}  // namespace
+
+bool isLoaded(const LoadOptions& loadOptions, SectionType type) {
+    const auto& types = loadOptions.neuriteTypes;
+    return types.empty() || std::find(types.begin(), types.end(), type) != types.end();
+}
+
+std::vector<int32_t> sectionIds(const std::vector<Property::Section::Type>& sections,
+                                const std::vector<SectionType>& types,
+                                const LoadOptions& loadOptions) {
+    const std::vector<size_t> roots = _roots(sections);
+    std::vector<int32_t> ids(sections.size(), -1);
+    int32_t nextId = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const size_t root = roots[i];
+        if (root < types.size() && isLoaded(loadOptions, types[root]))
+            ids[i] = nextId++;
+    }
+    return ids;
+}
+
+void remapAttachments(Property::Properties& properties, const std::vector<int32_t>& ids) {
+    _remapMitochondria(properties, ids);
+    _remapEndoplasmicReticulum(properties, ids);
+
+    auto& markers = properties._cellLevel._markers;
+    std::vector<Property::Marker> keptMarkers;
+    for (auto& marker : markers) {
+        // Markers outside of the neurites are kept
+        if (marker._sectionId >= 0) {
+            marker._sectionId = _newId(ids, marker._sectionId);
+            if (marker._sectionId < 0)
+                continue;
+        }
+        keptMarkers.push_back(std::move(marker));
+    }
+    markers = std::move(keptMarkers);
+
+    auto& annotations = properties._cellLevel._annotations;
+    std::vector<Property::Annotation> keptAnnotations;
+    for (auto& annotation : annotations) {
+        const int32_t id = _newId(ids, annotation._sectionId);
+        if (id < 0)
+            continue;
+        annotation._sectionId = static_cast<uint32_t>(id);
+        keptAnnotations.push_back(std::move(annotation));
+    }
+    annotations = std::move(keptAnnotations);
+}
+
+void apply(Property::Properties& properties, const LoadOptions& loadOptions) {
+    if (loadOptions.neuriteTypes.empty())
+        return;
+
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& types = properties._sectionLevel._sectionTypes;
+    const auto& pointLevel = properties._pointLevel;
+    const size_t nPoints = pointLevel._points.size();
+    const bool hasPerimeters = !pointLevel._perimeters.empty();
+    const std::vector<int32_t> ids = sectionIds(sections, types, loadOptions);
+
+    Property::SectionLevel keptSections;
+    Property::PointLevel kept;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (ids[i] < 0)
+            continue;
+        const auto begin = static_cast<size_t>(sections[i][0]);
+        const size_t end = _end(sections, i, nPoints);
+        keptSections._sections.push_back(
+            {static_cast<int>(kept._points.size()), _newId(ids, sections[i][1])});
+        keptSections._sectionTypes.push_back(types[i]);
+        _append(pointLevel._points, begin, end, kept._points);
+        _append(pointLevel._diameters, begin, end, kept._diameters);
+        if (hasPerimeters)
+            _append(pointLevel._perimeters, begin, end, kept._perimeters);
+    }
+
+    properties._sectionLevel = std::move(keptSections);
+    properties._pointLevel = std::move(kept);
+    remapAttachments(properties, ids);
+}
+
+}  // namespace neurite_filter
+}  // namespace morphio
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace neurite_filter {
+/** Whether the neurites whose root section has this type are loaded with loadOptions **/
+bool isLoaded(const LoadOptions& loadOptions, SectionType type);
+
+/**
+   Return the id of each section once the neurites not loaded with loadOptions are skipped,
+   -1 for the sections of the skipped ones
+
+   The sections are (offset, parent) pairs, the roots having a negative parent.
+**/
+std::vector<int32_t> sectionIds(const std::vector<Property::Section::Type>& sections,
+                                 const std::vector<SectionType>& types,
+                                 const LoadOptions& loadOptions);
+
+/**
+   Renumber what is attached to the sections with the ids returned by sectionIds: the
+   mitochondria, endoplasmic reticulum, markers and annotations on skipped sections are dropped.
+   A mitochondrion crossing a skipped section is dropped whole.
+**/
+void remapAttachments(Property::Properties& properties, const std::vector<int32_t>& ids);
+
+/**
+   Skip the neurites not loaded with loadOptions from properties already loaded whole
+**/
+void apply(Property::Properties& properties, const LoadOptions& loadOptions);
+}  // namespace neurite_filter
+}  // namespace morphio
@@ -0,0 +1,288 @@
+#include <dirent.h>    // opendir, readdir
+#include <sys/stat.h>  // mkdir, stat
+#include <unistd.h>    // getpid, unlink
+#include <utime.h>     // utime
+
+#include <algorithm>  // std::sort
+#include <atomic>
+#include <cerrno>
+#include <climits>  // PATH_MAX
+#include <cstdlib>  // realpath
+#include <cstring>  // std::memcpy
+#include <fstream>
+#include <iterator>  // std::istreambuf_iterator
+#include <mutex>
+#include <sstream>
+#include <tuple>
+
+#include <morphio/exceptions.h>
+#include <morphio/parse_cache.h>
+
+#include "parse_cache.h"
+#include "serialization.h"
+
+namespace morphio {
+
+namespace {
+constexpr char MAGIC[8] = {'\x89', 'M', 'O', 'R', 'P', 'H', 'C', 'E'};
+constexpr char EXTENSION[] = ".cache";
+
+struct EntryHeader {
+    char magic[8];
+    uint64_t contentHash;
+    uint64_t fileSize;
+    uint32_t options;
+    uint32_t skippedPayloads;
+    uint32_t neuriteTypes;
+    uint32_t reserved;
+};
+static_assert(sizeof(EntryHeader) == 40, "The entry header must be 40 bytes");
+
+struct CacheSettings {
+    std::mutex mutex;
+    bool enabled = false;
+    std::string directory;
+    uint64_t maxSize = 0;
+    // Size of the cache as seen by this process: other processes also add entries, it is
+    // recomputed from the directory at each eviction
+    uint64_t size = 0;
+};
+
+CacheSettings& _settings() {
+    static CacheSettings settings;
+    return settings;
+}
+
+/** One bit per payload disabled in the LoadOptions, and one when the neurites are filtered **/
+uint32_t _skippedPayloads(const LoadOptions& loadOptions) noexcept {
+    return static_cast<uint32_t>(!loadOptions.perimeters) |
+           static_cast<uint32_t>(!loadOptions.mitochondria) << 1 |
+           static_cast<uint32_t>(!loadOptions.endoplasmicReticulum) << 2 |
+           static_cast<uint32_t>(!loadOptions.markers) << 3 |
+           static_cast<uint32_t>(!loadOptions.annotations) << 4 |
+           static_cast<uint32_t>(!loadOptions.lineNumbers) << 5 |
+           static_cast<uint32_t>(!loadOptions.neuriteTypes.empty()) << 6;
+}
+
+/** One bit per neurite type loaded, none when they all are **/
+uint32_t _neuriteTypes(const LoadOptions& loadOptions) noexcept {
+    uint32_t types = 0;
+    for (const SectionType type : loadOptions.neuriteTypes) {
+        if (type >= 0 && type < SECTION_ALL)
+            types |= 1u << type;
+    }
+    return types;
+}
+
+bool _isEntry(const std::string& fileName) {
+    const size_t length = sizeof(EXTENSION) - 1;
+    return fileName.size() > length && fileName[0] != '.' &&
+           fileName.compare(fileName.size() - length, length, EXTENSION) == 0;
+}
+
+/**
+   Remove the least recently used entries until the cache is below 3/4 of maxSize, so that
+   evictions do not happen at every store. Return the size of the cache
+**/
+uint64_t _evict(const std::string& directory, uint64_t maxSize) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+        return 0;
+
+    // (last use, size, path) of every entry
+    std::vector<std::tuple<time_t, uint64_t, std::string>> entries;
+    uint64_t size = 0;
+    while (const dirent* dirEntry = readdir(dir)) {
+        if (!_isEntry(dirEntry->d_name))
+            continue;
+        const std::string path = directory + "/" + dirEntry->d_name;
+        struct stat info {};
+        if (stat(path.c_str(), &info) != 0)
+            continue;  // removed by another process
+        entries.emplace_back(info.st_mtime, static_cast<uint64_t>(info.st_size), path);
+        size += static_cast<uint64_t>(info.st_size);
+    }
+    closedir(dir);
+
+    if (size <= maxSize)
+        return size;
+
+    std::sort(entries.begin(), entries.end());
+    for (const auto& entry : entries) {
+        if (size <= maxSize / 4 * 3)
+            break;
+        unlink(std::get<2>(entry).c_str());
+        size -= std::get<1>(entry);
+    }
+    return size;
+}
+
+bool _readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+std::string _realPath(const std::string& path) {
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved) == nullptr)
+        return path;
+    return resolved;
+}
+
+/**
+   Entries are named after the path, size, modification time of the file, the options, the
+   disabled payloads and the neurite types loaded: the content hash stored in the entry catches
+   files modified within the mtime resolution
+**/
+std::string _entryName(const std::string& path,
+                       const struct stat& info,
+                       const EntryHeader& header) {
+    std::ostringstream key;
+    key << _realPath(path) << '\n'
+        << info.st_size << '\n'
+        << info.st_mtime << '\n'
+        << header.options << '\n'
+        << sizeof(floatType) << '\n'
+        << header.skippedPayloads << '\n'
+        << header.neuriteTypes;
+    const std::string keyString = key.str();
+
+    std::ostringstream name;
+    name << std::hex << serialization::checksum(keyString.data(), keyString.size()) << EXTENSION;
+    return name.str();
+}
+
+std::unique_ptr<Property::Properties> _loadEntry(const std::string& entryPath,
+                                                 const EntryHeader& expected) {
+    std::string entry;
+    if (!_readFile(entryPath, entry) || entry.size() < sizeof(EntryHeader))
+        return nullptr;
+
+    EntryHeader header;
+    std::memcpy(&header, entry.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.contentHash != expected.contentHash || header.fileSize != expected.fileSize ||
+        header.options != expected.options || header.skippedPayloads != expected.skippedPayloads ||
+        header.neuriteTypes != expected.neuriteTypes)
+        return nullptr;
+
+    try {
+        std::unique_ptr<Property::Properties> properties(new Property::Properties(
+            serialization::decode(entry.data() + sizeof(header), entry.size() - sizeof(header))));
+        utime(entryPath.c_str(), nullptr);  // the modification time tracks the last use
+        return properties;
+    } catch (const RawDataError&) {
+        unlink(entryPath.c_str());
+        return nullptr;
+    }
+}
+
+void _storeEntry(const std::string& directory,
+                 const std::string& entryName,
+                 const EntryHeader& header,
+                 const Property::Properties& properties,
+                 uint64_t maxSize) {
+    static std::atomic<uint64_t> counter{0};
+    const std::vector<char> encoded = serialization::encode(properties);
+
+    // Written aside then renamed: readers in other processes never see a partial entry
+    const std::string tmpPath = directory + "/." + std::to_string(getpid()) + "-" +
+                                std::to_string(counter++) + "-" + entryName;
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+        if (!file) {
+            unlink(tmpPath.c_str());
+            return;
+        }
+    }
+    if (rename(tmpPath.c_str(), (directory + "/" + entryName).c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    CacheSettings& settings = _settings();
+    std::lock_guard<std::mutex> lock(settings.mutex);
+    if (settings.directory != directory)
+        return;  // the cache was changed meanwhile
+    settings.size += sizeof(header) + encoded.size();
+    if (settings.size > maxSize)
+        settings.size = _evict(directory, maxSize);
+}
+}  // namespace
+
+void enableParseCache(const std::string& directory, uint64_t maxSize) {
+    // Create the missing directories, from the outermost
+    for (size_t pos = directory.find('/', 1); ; pos = directory.find('/', pos + 1)) {
+        const std::string parent = directory.substr(0, pos);
+        if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+            throw RawDataError("Could not create the parse cache directory " + parent + ": " +
+                               std::strerror(errno));
+        if (pos == std::string::npos)
+            break;
+    }
+
+    const uint64_t size = _evict(directory, maxSize);
+    CacheSettings& settings = _settings();
+    std::lock_guard<std::mutex> lock(settings.mutex);
+    settings.enabled = true;
+    settings.directory = directory;
+    settings.maxSize = maxSize;
+    settings.size = size;
+}
+
+void disableParseCache() {
+    CacheSettings& settings = _settings();
+    std::lock_guard<std::mutex> lock(settings.mutex);
+    settings.enabled = false;
+    settings.directory.clear();
+}
+
+namespace parse_cache {
+
+Property::Properties loadOrParse(
+    const std::string& path,
+    unsigned int options,
+    const LoadOptions& loadOptions,
+    const std::function<Property::Properties()>& parse,
+    const std::function<Property::Properties(const char*, size_t)>& parseBuffer) {
+    std::string directory;
+    uint64_t maxSize = 0;
+    {
+        CacheSettings& settings = _settings();
+        std::lock_guard<std::mutex> lock(settings.mutex);
+        if (!settings.enabled)
+            return parse();
+        directory = settings.directory;
+        maxSize = settings.maxSize;
+    }
+
+    struct stat info {};
+    std::string content;
+    if (stat(path.c_str(), &info) != 0 || !_readFile(path, content))
+        return parse();
+
+    EntryHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.contentHash = serialization::checksum(content.data(), content.size());
+    header.fileSize = content.size();
+    header.options = options;
+    header.skippedPayloads = _skippedPayloads(loadOptions);
+    header.neuriteTypes = _neuriteTypes(loadOptions);
+
+    const std::string entryName = _entryName(path, info, header);
+    if (auto cached = _loadEntry(directory + "/" + entryName, header))
+        return std::move(*cached);
+
+    Property::Properties properties = parseBuffer ? parseBuffer(content.data(), content.size())
+                                                  : parse();
+    _storeEntry(directory, entryName, header, properties, maxSize);
+    return properties;
+}
+
+}  // namespace parse_cache
+}  // namespace morphio
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>  // std::function
+#include <string>      // std::string
+
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace parse_cache {
+/**
+   Return the properties of the file at `path` loaded with `options` and `loadOptions` from the
+   parse cache, or parse the file and store the result in the cache
+
+   On a miss, the content read to check the cache is parsed with parseBuffer(data, size): the
+   file is read once. parse() reads the file itself: it is called when the cache is disabled,
+   or when parseBuffer is empty (ex: for compressed files).
+**/
+Property::Properties loadOrParse(
+    const std::string& path,
+    unsigned int options,
+    const LoadOptions& loadOptions,
+    const std::function<Property::Properties()>& parse,
+    const std::function<Property::Properties(const char*, size_t)>& parseBuffer);
+}  // namespace parse_cache
+}  // namespace morphio
@@ -11,6 +11,32 @@
 namespace morphio {
 namespace Property {
 
+namespace {
+/** The range of a section in an attribute of the block holding it **/
+template <typename T>
+range<const T> _blockRange(LazyPointLevel& lazyPointLevel,
+                           const SectionRange& sectionRange,
+                           std::vector<T> PointLevel::*attribute) {
+    size_t offset = 0;
+    const auto& data = lazyPointLevel.block(sectionRange, offset).*attribute;
+    if (data.empty())
+        return {};
+    return {data.data() + offset, sectionRange.second - sectionRange.first};
+}
+}  // namespace
+
+range<const Point::Type> LazyPointLevel::points(const SectionRange& range) {
+    return _blockRange(*this, range, &PointLevel::_points);
+}
+
+range<const Diameter::Type> LazyPointLevel::diameters(const SectionRange& range) {
+    return _blockRange(*this, range, &PointLevel::_diameters);
+}
+
+range<const Perimeter::Type> LazyPointLevel::perimeters(const SectionRange& range) {
+    return _blockRange(*this, range, &PointLevel::_perimeters);
+}
+
 PointLevel::PointLevel(std::vector<Point::Type> points,
                        std::vector<Diameter::Type> diameters,
                        std::vector<Perimeter::Type> perimeters)
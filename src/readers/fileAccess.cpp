@@ -0,0 +1,86 @@
+#include <fcntl.h>     // open, posix_fadvise
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // pread, close
+
+#include <morphio/exceptions.h>
+
+#include "../io_policy.h"
+#include "fileAccess.h"
+
+namespace morphio {
+namespace readers {
+
+Mapping::Mapping(const std::string& uri) {
+    const int fd = open(uri.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw RawDataError("File: " + uri + " does not exist.");
+
+    struct stat info {};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        _size = static_cast<size_t>(info.st_size);
+        _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    // Empty files cannot be mapped, they are left unmapped
+    if (_data == MAP_FAILED) {
+        _data = nullptr;
+        throw RawDataError("File: " + uri + " could not be mapped in memory");
+    }
+    if (_size == 0)
+        return;
+#ifdef MADV_WILLNEED
+    // The whole file is read right away
+    madvise(_data, _size, MADV_WILLNEED);
+#endif
+    io_policy::recordMapping(_size);
+}
+
+Mapping::~Mapping() {
+    if (_data != nullptr)
+        munmap(_data, _size);
+}
+
+std::vector<char> readFile(const std::string& uri) {
+    const int fd = open(uri.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw RawDataError("File: " + uri + " does not exist.");
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw RawDataError("File: " + uri + " could not be read");
+    }
+
+    std::vector<char> content(static_cast<size_t>(info.st_size));
+    size_t offset = 0;
+    while (offset < content.size()) {
+        const ssize_t count = pread(
+            fd, content.data() + offset, content.size() - offset, static_cast<off_t>(offset));
+        if (count < 0) {
+            close(fd);
+            throw RawDataError("File: " + uri + " could not be read");
+        }
+        if (count == 0) {
+            content.resize(offset);  // truncated meanwhile
+            break;
+        }
+        offset += static_cast<size_t>(count);
+    }
+    close(fd);
+    return content;
+}
+
+void adviseReadahead(const std::string& uri) {
+    const int fd = open(uri.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+#ifdef POSIX_FADV_WILLNEED
+    // The prefetched pages outlive the descriptor, they are in the page cache
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+    close(fd);
+}
+
+}  // namespace readers
+}  // namespace morphio
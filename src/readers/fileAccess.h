@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>  // size_t
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+namespace morphio {
+namespace readers {
+
+/** Read-only mapping of a whole file. The data of an empty file is nullptr **/
+class Mapping
+{
+  public:
+    /**
+       @throw RawDataError if the file cannot be opened or mapped
+    **/
+    explicit Mapping(const std::string& uri);
+    ~Mapping();
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    const char* data() const noexcept {
+        return static_cast<const char*>(_data);
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+  private:
+    void* _data = nullptr;
+    size_t _size = 0;
+};
+
+/**
+   Read a whole file with as few read requests as possible: a single one unless the system
+   returns less than asked
+
+   @throw RawDataError if the file cannot be read
+**/
+std::vector<char> readFile(const std::string& uri);
+
+/**
+   Ask the kernel to prefetch the whole file in the page cache, without waiting for it. Errors
+   are ignored: it is only a hint
+**/
+void adviseReadahead(const std::string& uri);
+
+}  // namespace readers
+}  // namespace morphio
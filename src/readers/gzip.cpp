@@ -0,0 +1,54 @@
+#include <zlib.h>
+
+#include <morphio/exceptions.h>
+
+#include "gzip.h"
+
+namespace morphio {
+namespace readers {
+
+namespace {
+constexpr unsigned int CHUNK_SIZE = 1 << 16;
+}
+
+bool isGzip(const std::string& uri) {
+    const size_t pos = uri.find_last_of('.');
+    if (pos == std::string::npos)
+        return false;
+    const std::string extension = uri.substr(pos);
+    return extension == ".gz" || extension == ".GZ";
+}
+
+GzipBuffer::GzipBuffer(const std::string& uri)
+    : _uri(uri)
+    , _file(gzopen(uri.c_str(), "rb"))
+    , _chunk(CHUNK_SIZE) {
+    if (_file == nullptr)
+        throw RawDataError("Could not open the compressed file " + uri);
+    gzbuffer(_file, CHUNK_SIZE);
+}
+
+GzipBuffer::~GzipBuffer() {
+    gzclose(_file);
+}
+
+GzipBuffer::int_type GzipBuffer::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    const int count = gzread(_file, _chunk.data(), CHUNK_SIZE);
+    if (count <= 0) {
+        // A truncated file ends with a Z_BUF_ERROR rather than a clean end of file
+        int error = Z_OK;
+        const char* message = gzerror(_file, &error);
+        if (error != Z_OK)
+            throw RawDataError("Could not decompress " + _uri + ": " + message);
+        return traits_type::eof();
+    }
+
+    setg(_chunk.data(), _chunk.data(), _chunk.data() + count);
+    return traits_type::to_int_type(*gptr());
+}
+
+}  // namespace readers
+}  // namespace morphio
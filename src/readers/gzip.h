@@ -0,0 +1,44 @@
+#pragma once
+
+#include <streambuf>  // std::streambuf
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+struct gzFile_s;
+
+namespace morphio {
+namespace readers {
+
+/**
+   Return true if the file has the extension of gzip compressed files: .gz
+**/
+bool isGzip(const std::string& uri);
+
+/**
+   Read only stream buffer decompressing a gzip file on the fly, one chunk at a time: the
+   decompressed content is never held whole in memory, nor written to disk.
+**/
+class GzipBuffer: public std::streambuf
+{
+  public:
+    /**
+       @throw RawDataError if the file cannot be opened
+    **/
+    explicit GzipBuffer(const std::string& uri);
+    ~GzipBuffer() override;
+
+    GzipBuffer(const GzipBuffer&) = delete;
+    GzipBuffer& operator=(const GzipBuffer&) = delete;
+
+  protected:
+    /** @throw RawDataError if the compressed data is corrupted **/
+    int_type underflow() override;
+
+  private:
+    std::string _uri;
+    gzFile_s* _file;
+    std::vector<char> _chunk;
+};
+
+}  // namespace readers
+}  // namespace morphio
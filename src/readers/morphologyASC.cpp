@@ -6,6 +6,8 @@
 #include <morphio/mut/section.h>
 
 
+#include "../neurite_filter.h"
+#include "gzip.h"
 #include "lex.cpp"
 
 namespace morphio {
@@ -54,8 +56,9 @@ bool skip_sexp(size_t id) {
 class NeurolucidaParser
 {
   public:
-    explicit NeurolucidaParser(const std::string& uri)
+    NeurolucidaParser(const std::string& uri, const LoadOptions& loadOptions)
         : uri_(uri)
+        , loadOptions_(loadOptions)
         , lex_(uri, false)
         , debugInfo_(uri)
         , err_(uri) {}
@@ -63,11 +66,7 @@ class NeurolucidaParser
     NeurolucidaParser(NeurolucidaParser const&) = delete;
     NeurolucidaParser& operator=(NeurolucidaParser const&) = delete;
 
-    morphio::mut::Morphology& parse() {
-        std::ifstream ifs(uri_);
-        std::string input((std::istreambuf_iterator<char>(ifs)),
-                          (std::istreambuf_iterator<char>()));
-
+    morphio::mut::Morphology& parse(const std::string& input) {
         lex_.start_parse(input);
 
         parse_root_sexps();
@@ -134,11 +133,13 @@ class NeurolucidaParser
         properties._points = points;
         properties._diameters = diameters;
         if (header.token == Token::STRING) {
-            Property::Marker marker;
-            marker._pointLevel = properties;
-            marker._label = header.label;
-            marker._sectionId = header.parent_id;
-            nb_.addMarker(marker);
+            if (loadOptions_.markers) {
+                Property::Marker marker;
+                marker._pointLevel = properties;
+                marker._label = header.label;
+                marker._sectionId = header.parent_id;
+                nb_.addMarker(marker);
+            }
             return_id = -1;
         } else if (header.token == Token::CELLBODY) {
             if (!nb_.soma()->points().empty())
@@ -162,8 +163,9 @@ class NeurolucidaParser
                 else
                     section = nb_.appendRootSection(properties, section_type);
                 return_id = static_cast<int>(section->id());
-                debugInfo_.setLineNumber(section->id(),
-                                         static_cast<unsigned int>(lex_.current_section_start_));
+                if (loadOptions_.lineNumbers)
+                    debugInfo_.setLineNumber(
+                        section->id(), static_cast<unsigned int>(lex_.current_section_start_));
             }
         }
         points.clear();
@@ -282,10 +284,12 @@ class NeurolucidaParser
                 return true;
             } else if (is_end_of_branch(id)) {
                 if (id == Token::INCOMPLETE) {
-                    Property::Marker marker;
-                    marker._label = to_string(Token::INCOMPLETE);
-                    marker._sectionId = section_id;
-                    nb_.addMarker(marker);
+                    if (loadOptions_.markers) {
+                        Property::Marker marker;
+                        marker._label = to_string(Token::INCOMPLETE);
+                        marker._sectionId = section_id;
+                        nb_.addMarker(marker);
+                    }
                     if (!is_end_of_section(Token(peek_id))) {
                         throw RawDataError(err_.ERROR_UNEXPECTED_TOKEN(
                             lex_.line_num(),
@@ -338,6 +342,36 @@ class NeurolucidaParser
         }
     }
 
+    /**
+       Whether the LoadOptions keep the neurite of this header: the soma and the markers are
+       always kept
+    **/
+    bool is_loaded(const Header& header) const {
+        const auto type = TokenSectionTypeMap.find(header.token);
+        return type == TokenSectionTypeMap.end() ||
+               neurite_filter::isLoaded(loadOptions_, type->second);
+    }
+
+    /**
+       Advance to the closing paren of the neurite being parsed, without building its sections
+    **/
+    void skip_neurite() {
+        size_t depth = 0;
+        while (true) {
+            const size_t id = lex_.current()->id;
+            if (id == +Token::RPAREN) {
+                if (depth == 0)
+                    return;
+                --depth;
+            } else if (id == +Token::LPAREN) {
+                ++depth;
+            }
+            lex_.consume();
+            if (lex_.ended())
+                throw RawDataError(err_.ERROR_EOF_UNBALANCED_PARENS(lex_.line_num()));
+        }
+    }
+
     void parse_root_sexps() {
         // parse the top level blocks, and if they are a neurite, otherwise skip
         while (!lex_.ended()) {
@@ -345,7 +379,10 @@ class NeurolucidaParser
                 lex_.consume();
                 Header header = parse_root_sexp_header();
                 if (lex_.current()->id != +Token::RPAREN) {
-                    parse_neurite_section(header);
+                    if (is_loaded(header))
+                        parse_neurite_section(header);
+                    else
+                        skip_neurite();
                 }
             }
 
@@ -357,6 +394,7 @@ class NeurolucidaParser
     morphio::mut::Morphology nb_;
 
     std::string uri_;
+    LoadOptions loadOptions_;
     NeurolucidaLexer lex_;
 
   public:
@@ -366,10 +404,14 @@ class NeurolucidaParser
     ErrorMessages err_;
 };
 
-Property::Properties load(const std::string& uri, unsigned int options) {
-    NeurolucidaParser parser(uri);
+namespace {
+Property::Properties _load(const std::string& uri,
+                           const std::string& input,
+                           unsigned int options,
+                           const LoadOptions& loadOptions) {
+    NeurolucidaParser parser(uri, loadOptions);
 
-    morphio::mut::Morphology& nb_ = parser.parse();
+    morphio::mut::Morphology& nb_ = parser.parse(input);
     nb_.applyModifiers(options);
 
     Property::Properties properties = nb_.buildReadOnly();
@@ -377,6 +419,32 @@ Property::Properties load(const std::string& uri, unsigned int options) {
     properties._cellLevel._version = {"asc", 1, 0};
     return properties;
 }
+}  // namespace
+
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          const LoadOptions& loadOptions) {
+    // The lexer works on the whole content: compressed files are decompressed in memory
+    if (isGzip(uri)) {
+        GzipBuffer buffer(uri);
+        const std::string input((std::istreambuf_iterator<char>(&buffer)),
+                                (std::istreambuf_iterator<char>()));
+        return _load(uri, input, options, loadOptions);
+    }
+
+    std::ifstream ifs(uri);
+    const std::string input((std::istreambuf_iterator<char>(ifs)),
+                            (std::istreambuf_iterator<char>()));
+    return _load(uri, input, options, loadOptions);
+}
+
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                unsigned int options,
+                                const LoadOptions& loadOptions) {
+    return _load(uri, std::string(data, size), options, loadOptions);
+}
 
 }  // namespace asc
 }  // namespace readers
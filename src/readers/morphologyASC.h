@@ -4,7 +4,20 @@
 namespace morphio {
 namespace readers {
 namespace asc {
-Property::Properties load(const std::string& uri, unsigned int options);
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          const LoadOptions& loadOptions = {});
+
+/**
+   Parse the Neurolucida content of a memory buffer, uri is only used in error messages
+
+   The lexer works on a std::string: the buffer is copied once, as files are read whole.
+**/
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                unsigned int options,
+                                const LoadOptions& loadOptions = {});
 }  // namespace asc
 }  // namespace readers
 }  // namespace morphio
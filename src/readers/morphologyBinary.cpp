@@ -0,0 +1,25 @@
+#include <memory>  // std::make_shared
+
+#include <morphio/exceptions.h>
+
+#include "../serialization.h"
+#include "fileAccess.h"
+#include "morphologyBinary.h"
+
+namespace morphio {
+namespace readers {
+namespace binary {
+
+Property::Properties load(const std::string& uri, const LoadOptions& loadOptions) {
+    // The points stay in the mapping, which the properties keep alive
+    const auto mapping = std::make_shared<const Mapping>(uri);
+    try {
+        return serialization::decodeInPlace(mapping->data(), mapping->size(), mapping, loadOptions);
+    } catch (const RawDataError& exc) {
+        throw RawDataError("File: " + uri + ": " + exc.what());
+    }
+}
+
+}  // namespace binary
+}  // namespace readers
+}  // namespace morphio
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+namespace binary {
+/**
+   Load a file of the MorphIO binary format (.morphio)
+
+   The file is memory-mapped and decoded without any parsing. The points, diameters and
+   perimeters of the neurites stay in the mapping, viewed by Properties::_lazyPointLevel; the
+   other arrays are copied out of it.
+**/
+Property::Properties load(const std::string& uri, const LoadOptions& loadOptions = {});
+}  // namespace binary
+}  // namespace readers
+}  // namespace morphio
@@ -18,12 +18,20 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>  // std::min, std::upper_bound
 #include <cassert>
+#include <type_traits>  // std::is_same
 
 #include "morphologyHDF5.h"
 
+#include "../neurite_filter.h"
 #include "utilsHDF5.h"
 
+#include <H5Dpublic.h>  // H5Dread
+#include <H5FDcore.h>    // H5Pset_fapl_core
+#include <H5Ppublic.h>  // H5Pset_file_image
+#include <H5Spublic.h>  // H5Sselect_hyperslab
+
 #include <highfive/H5Utility.hpp>  // HighFive::SilenceHDF5
 
 namespace {
@@ -62,47 +70,281 @@ const std::string _d_filament_count("filament_count");
 const std::string _g_v2root("neuron1");
 //} v2
 
+/**
+   File access property opening an HDF5 file image held in memory with the core driver,
+   instead of a file on disk
+**/
+class FileImage
+{
+  public:
+    FileImage(const char* data, size_t size)
+        : _data(data)
+        , _size(size) {}
+
+    void apply(hid_t list) const {
+        // HDF5 takes a copy of the image: the buffer does not need to outlive the file
+        if (H5Pset_fapl_core(list, 1 << 20, false) < 0 ||
+            H5Pset_file_image(list, const_cast<char*>(_data), _size) < 0)
+            throw morphio::RawDataError("Could not set up the HDF5 file image");
+    }
+
+  private:
+    const char* _data;
+    size_t _size;
+};
+
+/**
+   Read the [begin, end) rows of a dataset of floats with a single multi-hyperslab selection,
+   one I/O request for the HDF5 library instead of one per range. The rows, sorted and
+   disjoint, are stored one after the other in data.
+**/
+void _readRows(const HighFive::DataSet& dataset,
+               const std::string& name,
+               const std::vector<std::pair<size_t, size_t>>& rows,
+               morphio::floatType* data,
+               const std::string& uri) {
+    const auto dims = dataset.getSpace().getDimensions();
+    const hsize_t columns = dims.size() > 1 ? dims[1] : 1;
+    const int rank = static_cast<int>(dims.size());
+
+    const hid_t fileSpace = H5Dget_space(dataset.getId());
+    herr_t status = H5Sselect_none(fileSpace);
+    hsize_t rowCount = 0;
+    for (const auto& range : rows) {
+        const hsize_t start[2] = {range.first, 0};
+        const hsize_t count[2] = {range.second - range.first, columns};
+        if (H5Sselect_hyperslab(fileSpace, H5S_SELECT_OR, start, nullptr, count, nullptr) < 0)
+            status = -1;
+        rowCount += count[0];
+    }
+
+    if (status >= 0 && rowCount > 0) {
+        const hsize_t memoryDims[2] = {rowCount, columns};
+        const hid_t memorySpace = H5Screate_simple(rank, memoryDims, nullptr);
+        const hid_t type = std::is_same<morphio::floatType, double>::value ? H5T_NATIVE_DOUBLE
+                                                                          : H5T_NATIVE_FLOAT;
+        status = H5Dread(dataset.getId(), type, memorySpace, fileSpace, H5P_DEFAULT, data);
+        H5Sclose(memorySpace);
+    }
+    H5Sclose(fileSpace);
+    if (status < 0)
+        throw morphio::RawDataError("Reading morphology '" + uri +
+                                    "': could not read the rows of " + name);
+}
+
 }  // namespace
 
 namespace morphio {
 namespace readers {
 namespace h5 {
 
-MorphologyHDF5::MorphologyHDF5(const HighFive::Group& group)
+MorphologyHDF5::MorphologyHDF5(const HighFive::Group& group, const LoadOptions& loadOptions)
     : _group(group)
+    , _loadOptions(loadOptions)
     , _uri("HDF5 Group") {}
 
-Property::Properties load(const std::string& uri) {
+std::recursive_mutex& hdf5Mutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+namespace {
+// Points read at once by the morphologies loaded lazily, rounded up to whole sections
+constexpr size_t LAZY_BLOCK_POINTS = 1 << 16;
+
+/**
+   The point level of the neurites read from the file kept open, one block of consecutive
+   sections at a time
+**/
+class LazyPoints: public Property::LazyPointLevel
+{
+  public:
+    /**
+       sections: the sections of the point level, fileRows: the [begin, end) rows of the file
+       holding it, one after the other
+    **/
+    LazyPoints(const HighFive::DataSet& points,
+               const HighFive::DataSet* perimeters,
+               const std::vector<Property::Section::Type>& sections,
+               std::vector<std::pair<size_t, size_t>> fileRows,
+               std::string uri)
+        : _points(new HighFive::DataSet(points))
+        , _perimeters(perimeters ? new HighFive::DataSet(*perimeters) : nullptr)
+        , _fileRows(std::move(fileRows))
+        , _uri(std::move(uri)) {
+        for (const auto& rows : _fileRows) {
+            _size += rows.second - rows.first;
+        }
+
+        // Blocks start with a section: the points of a section are in a single block
+        for (const auto& section : sections) {
+            const auto offset = static_cast<size_t>(section[0]);
+            if (_blockStarts.empty() || offset >= _blockStarts.back() + LAZY_BLOCK_POINTS)
+                _blockStarts.push_back(offset);
+        }
+        _blocks.resize(_blockStarts.size());
+        _blockStarts.push_back(_size);
+    }
+
+    ~LazyPoints() override {
+        // Closing the file is a call to the HDF5 library
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+        _points.reset();
+        _perimeters.reset();
+    }
+
+    size_t size() const noexcept override {
+        return _size;
+    }
+
+    const Property::PointLevel& block(const SectionRange& range, size_t& offset) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_all) {
+            offset = range.first;
+            return *_all;
+        }
+
+        // The last block starting at or before the range
+        const auto next = std::upper_bound(_blockStarts.begin(),
+                                           _blockStarts.end() - 1,
+                                           range.first);
+        const auto index = static_cast<size_t>(next - _blockStarts.begin()) - 1;
+        if (next == _blockStarts.begin() || range.second > _blockStarts[index + 1])
+            throw RawDataError("Error reading morphology " + _uri +
+                               ": the section offsets must be increasing to load it lazily");
+
+        auto& block = _blocks[index];
+        if (!block)
+            block = _read(_blockStarts[index], _blockStarts[index + 1]);
+        offset = range.first - _blockStarts[index];
+        return *block;
+    }
+
+    const Property::PointLevel& all() override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_all)
+            _all = _read(0, _size);
+        return *_all;
+    }
+
+    void release(size_t end) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i + 1 < _blockStarts.size() && _blockStarts[i + 1] <= end; ++i) {
+            _blocks[i].reset();
+        }
+    }
+
+  private:
+    /** Read the points [begin, end) of the point level **/
+    std::unique_ptr<Property::PointLevel> _read(size_t begin, size_t end) {
+        std::vector<std::pair<size_t, size_t>> rows;
+        size_t offset = 0;
+        for (const auto& fileRows : _fileRows) {
+            const size_t count = fileRows.second - fileRows.first;
+            const size_t first = std::max(begin, offset);
+            const size_t last = std::min(end, offset + count);
+            if (first < last)
+                rows.emplace_back(fileRows.first + first - offset, fileRows.first + last - offset);
+            offset += count;
+        }
+
+        constexpr size_t pointColumns = 4;
+        std::vector<std::array<floatType, pointColumns>> data(end - begin);
+        std::unique_ptr<Property::PointLevel> pointLevel(new Property::PointLevel());
+        std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+        if (!data.empty())
+            _readRows(*_points, _d_points, rows, data.front().data(), _uri);
+
+        pointLevel->_points.reserve(data.size());
+        pointLevel->_diameters.reserve(data.size());
+        for (const auto& p : data) {
+            pointLevel->_points.push_back({p[0], p[1], p[2]});
+            pointLevel->_diameters.push_back(p[3]);
+        }
+
+        if (_perimeters) {
+            pointLevel->_perimeters.resize(data.size());
+            if (!data.empty())
+                _readRows(*_perimeters, _d_perimeters, rows, pointLevel->_perimeters.data(), _uri);
+        }
+        return pointLevel;
+    }
+
+    std::unique_ptr<HighFive::DataSet> _points;
+    std::unique_ptr<HighFive::DataSet> _perimeters;
+    std::vector<std::pair<size_t, size_t>> _fileRows;
+    std::string _uri;
+    size_t _size = 0;
+
+    std::mutex _mutex;
+    // The first point of each block, then the number of points
+    std::vector<size_t> _blockStarts;
+    std::vector<std::unique_ptr<Property::PointLevel>> _blocks;
+    std::unique_ptr<Property::PointLevel> _all;
+};
+}  // namespace
+
+Property::Properties load(const std::string& uri, const LoadOptions& loadOptions) {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
     try {
         HighFive::SilenceHDF5 silence;
         auto file = HighFive::File(uri, HighFive::File::ReadOnly);
-        return MorphologyHDF5(file.getGroup("/")).load();
+        return MorphologyHDF5(file.getGroup("/"), loadOptions).load();
 
     } catch (const HighFive::FileException& exc) {
         throw RawDataError("Could not open morphology file " + uri + ": " + exc.what());
     }
 }
 
-Property::Properties load(const HighFive::Group& group) {
-    return MorphologyHDF5(group).load();
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                const LoadOptions& loadOptions) {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+    try {
+        HighFive::SilenceHDF5 silence;
+        HighFive::FileAccessProps properties;
+        properties.add(FileImage(data, size));
+        // With a file image, the name is not opened: it only identifies the file for HDF5
+        auto file = HighFive::File(uri, HighFive::File::ReadOnly, properties);
+        return MorphologyHDF5(file.getGroup("/"), loadOptions).load();
+
+    } catch (const HighFive::FileException& exc) {
+        throw RawDataError("Could not open morphology buffer " + uri + ": " + exc.what());
+    }
+}
+
+Property::Properties load(const HighFive::Group& group, const LoadOptions& loadOptions) {
+    std::lock_guard<std::recursive_mutex> lock(hdf5Mutex());
+    return MorphologyHDF5(group, loadOptions).load();
 }
 
 Property::Properties MorphologyHDF5::load() {
     _readMetadata(_uri);
 
     int firstSectionOffset = _readSections();
+    _lazy = _loadOptions.lazy && firstSectionOffset != SOMA_ONLY;
 
     _readPoints(firstSectionOffset);
 
     if (_properties._cellLevel.minorVersion() >= 1) {
-        _readPerimeters(firstSectionOffset);
+        if (_loadOptions.perimeters)
+            _readPerimeters(firstSectionOffset);
 
         if (_properties._cellLevel.minorVersion() >= 2) {
-            _readMitochondria();
-            _readEndoplasmicReticulum();
+            if (_loadOptions.mitochondria)
+                _readMitochondria();
+            if (_loadOptions.endoplasmicReticulum)
+                _readEndoplasmicReticulum();
         }
     }
 
+    if (_lazy)
+        _loadLazily(firstSectionOffset);
+
+    if (_filterNeurites)
+        neurite_filter::remapAttachments(_properties, _sectionIds);
+
     return _properties;
 }
 
@@ -171,14 +413,34 @@ void MorphologyHDF5::_readPoints(int firstSectionOffset) {
                            "': incorrect number of columns for points");
     }
 
-    std::vector<std::array<floatType, pointColumns>> hd5fData(numberPoints);
+    std::vector<std::array<floatType, pointColumns>> hd5fData;
+
+    if (_filterNeurites || _lazy) {
+        // Only the rows of the soma, and of the neurites kept unless they are read lazily
+        std::vector<std::pair<size_t, size_t>> rows;
+        const auto somaRows = std::min(static_cast<size_t>(firstSectionOffset), numberPoints);
+        if (somaRows > 0)
+            rows.emplace_back(0, somaRows);
+        if (!_lazy)
+            rows.insert(rows.end(), _neuriteRows.begin(), _neuriteRows.end());
 
-    if (!hd5fData.empty()) {
-        pointsDataSet.read(hd5fData.front().data());
+        size_t rowCount = 0;
+        for (const auto& range : rows) {
+            rowCount += range.second - range.first;
+        }
+        hd5fData.resize(rowCount);
+        if (!hd5fData.empty()) {
+            _readRows(pointsDataSet, _d_points, rows, hd5fData.front().data(), _uri);
+        }
+    } else {
+        hd5fData.resize(numberPoints);
+        if (!hd5fData.empty()) {
+            pointsDataSet.read(hd5fData.front().data());
+        }
     }
 
     const bool hasSoma = firstSectionOffset != 0;
-    const bool hasNeurites = static_cast<size_t>(firstSectionOffset) < numberPoints;
+    const bool hasNeurites = static_cast<size_t>(firstSectionOffset) < hd5fData.size();
     const size_t somaPointCount = hasNeurites ? static_cast<size_t>(firstSectionOffset)
                                               : hd5fData.size();
 
@@ -274,9 +536,71 @@ int MorphologyHDF5::_readSections() {
         types.emplace_back(type);
     }
 
+    if (!_loadOptions.neuriteTypes.empty())
+        _filterSections(firstSectionOffset);
+
     return firstSectionOffset;
 }
 
+void MorphologyHDF5::_loadLazily(int firstSectionOffset) {
+    const auto points = _group.getDataSet(_d_points);
+    const size_t numberPoints = points.getSpace().getDimensions()[0];
+    if (!_filterNeurites && static_cast<size_t>(firstSectionOffset) < numberPoints)
+        _neuriteRows.emplace_back(static_cast<size_t>(firstSectionOffset), numberPoints);
+
+    std::unique_ptr<HighFive::DataSet> perimeters;
+    if (_lazyPerimeters)
+        perimeters.reset(new HighFive::DataSet(_group.getDataSet(_d_perimeters)));
+
+    _properties._lazyPointLevel = std::make_shared<LazyPoints>(
+        points, perimeters.get(), _properties.get<Property::Section>(), _neuriteRows, _uri);
+}
+
+void MorphologyHDF5::_filterSections(int firstSectionOffset) {
+    auto& sections = _properties.get_mut<Property::Section>();
+    auto& types = _properties.get_mut<Property::SectionType>();
+    const size_t numberPoints = _group.getDataSet(_d_points).getSpace().getDimensions()[0];
+    const auto firstRow = static_cast<size_t>(firstSectionOffset);
+
+    _sectionIds = neurite_filter::sectionIds(sections, types, _loadOptions);
+
+    std::vector<Property::Section::Type> keptSections;
+    std::vector<SectionType> keptTypes;
+    int offset = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (_sectionIds[i] < 0)
+            continue;
+
+        const size_t begin = firstRow + static_cast<size_t>(sections[i][0]);
+        const size_t end = i + 1 < sections.size()
+                               ? firstRow + static_cast<size_t>(sections[i + 1][0])
+                               : numberPoints;
+        if (begin > end || end > numberPoints ||
+            (!_neuriteRows.empty() && begin < _neuriteRows.back().second))
+            throw RawDataError("Error reading morphology " + _uri +
+                               ": the section offsets must be increasing to filter neurites");
+
+        const int parent = sections[i][1];
+        keptSections.push_back(
+            {offset,
+             parent >= 0 && static_cast<size_t>(parent) < sections.size()
+                 ? _sectionIds[static_cast<size_t>(parent)]
+                 : parent});
+        keptTypes.push_back(types[i]);
+
+        // Consecutive sections are read as a single range
+        if (!_neuriteRows.empty() && _neuriteRows.back().second == begin)
+            _neuriteRows.back().second = end;
+        else if (begin < end)
+            _neuriteRows.emplace_back(begin, end);
+        offset += static_cast<int>(end - begin);
+    }
+
+    sections = std::move(keptSections);
+    types = std::move(keptTypes);
+    _filterNeurites = true;
+}
+
 void MorphologyHDF5::_readPerimeters(int firstSectionOffset) {
     assert(_properties._cellLevel.majorVersion() == 1 &&
            _properties._cellLevel.minorVersion() > 0 &&
@@ -294,7 +618,22 @@ void MorphologyHDF5::_readPerimeters(int firstSectionOffset) {
         return;
     }
 
+    if (_lazy) {
+        _lazyPerimeters = true;
+        return;
+    }
+
     auto& perimeters = _properties.get_mut<Property::Perimeter>();
+    if (_filterNeurites) {
+        perimeters.resize(_properties.get<Property::Point>().size());
+        if (!perimeters.empty())
+            _readRows(_group.getDataSet(_d_perimeters),
+                      _d_perimeters,
+                      _neuriteRows,
+                      perimeters.data(),
+                      _uri);
+        return;
+    }
     _read("/", _d_perimeters, 1, perimeters);
     perimeters.erase(perimeters.begin(), perimeters.begin() + firstSectionOffset);
 }
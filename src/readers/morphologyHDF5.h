@@ -1,7 +1,9 @@
 #pragma once
-#include <memory>  // std::unique_ptr
-#include <string>  // std::string
-#include <vector>  // std::vector
+#include <memory>   // std::unique_ptr
+#include <mutex>    // std::recursive_mutex
+#include <string>   // std::string
+#include <utility>  // std::pair
+#include <vector>   // std::vector
 
 #include <morphio/errorMessages.h>
 #include <morphio/properties.h>
@@ -13,13 +15,27 @@
 namespace morphio {
 namespace readers {
 namespace h5 {
-Property::Properties load(const std::string& uri);
-Property::Properties load(const HighFive::Group& group);
+/**
+   The HDF5 library is not thread safe: every call to it must hold this lock. It is
+   recursive so that code holding it can call the loaders below, which take it too.
+**/
+std::recursive_mutex& hdf5Mutex();
+
+Property::Properties load(const std::string& uri, const LoadOptions& loadOptions = {});
+
+/**
+   Load an HDF5 file image held in memory, uri is only used in error messages
+**/
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                const LoadOptions& loadOptions = {});
+Property::Properties load(const HighFive::Group& group, const LoadOptions& loadOptions = {});
 
 class MorphologyHDF5
 {
   public:
-    MorphologyHDF5(const HighFive::Group& group);
+    MorphologyHDF5(const HighFive::Group& group, const LoadOptions& loadOptions = {});
     virtual ~MorphologyHDF5() = default;
     Property::Properties load();
 
@@ -28,6 +44,8 @@ class MorphologyHDF5
     void _readMetadata(const std::string& source);
     void _readPoints(int);
     int _readSections();
+    void _filterSections(int firstSectionOffset);
+    void _loadLazily(int firstSectionOffset);
     void _readPerimeters(int);
     void _readMitochondria();
     void _readEndoplasmicReticulum();
@@ -39,7 +57,18 @@ class MorphologyHDF5
                T& data);
 
     HighFive::Group _group;
+    LoadOptions _loadOptions;
     Property::Properties _properties;
+
+    // Set when the neurites are filtered: the new id of each section of the file, -1 for the
+    // skipped ones, and the [begin, end) rows of the points of the kept ones
+    bool _filterNeurites = false;
+    std::vector<int32_t> _sectionIds;
+    std::vector<std::pair<size_t, size_t>> _neuriteRows;
+
+    // Set when the points of the neurites are loaded lazily, with or without the perimeters
+    bool _lazy = false;
+    bool _lazyPerimeters = false;
     std::string _uri;
 };
 }  // namespace h5
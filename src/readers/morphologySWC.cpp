@@ -2,10 +2,11 @@
 
 #include <cstdint>  // uint32_t
 #include <fstream>
-#include <map>     // std::map
-#include <memory>  // std::shared_ptr
-#include <string>  // std::string
-#include <vector>  // std::vector
+#include <istream>  // std::istream
+#include <map>      // std::map
+#include <memory>   // std::shared_ptr
+#include <string>   // std::string
+#include <vector>   // std::vector
 
 #include <morphio/errorMessages.h>
 #include <morphio/mut/morphology.h>
@@ -13,12 +14,27 @@
 #include <morphio/mut/soma.h>
 #include <morphio/properties.h>
 
+#include "../neurite_filter.h"
+#include "gzip.h"
+
 namespace {
 bool _ignoreLine(const std::string& line) {
     std::size_t pos = line.find_first_not_of("\n\r\t ");
     return pos == std::string::npos || line[pos] == '#';
 }
 
+/**
+   Read only stream buffer over memory, to parse a buffer without copying it
+**/
+class MemoryBuffer: public std::streambuf
+{
+  public:
+    MemoryBuffer(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
 }  // unnamed namespace
 
 namespace morphio {
@@ -34,11 +50,12 @@ const int SWC_UNDEFINED_PARENT = -1;
 class SWCBuilder
 {
   public:
-    explicit SWCBuilder(const std::string& _uri)
+    SWCBuilder(const std::string& _uri, std::istream& stream, const LoadOptions& _loadOptions)
         : uri(_uri)
         , err(_uri)
-        , debugInfo(_uri) {
-        _readSamples();
+        , debugInfo(_uri)
+        , loadOptions(_loadOptions) {
+        _readSamples(stream);
 
         for (const auto& sample_pair : samples) {
             const auto& sample = sample_pair.second;
@@ -48,14 +65,10 @@ class SWCBuilder
         checkSoma();
     }
 
-    void _readSamples() {
-        std::ifstream file(uri.c_str());
-        if (file.fail())
-            throw morphio::RawDataError(err.ERROR_OPENING_FILE());
-
+    void _readSamples(std::istream& stream) {
         unsigned int lineNumber = 0;
         std::string line;
-        while (!std::getline(file, line).fail()) {
+        while (!std::getline(stream, line).fail()) {
             ++lineNumber;
 
             if (line.empty() || _ignoreLine(line))
@@ -184,13 +197,21 @@ class SWCBuilder
 
     template <typename T>
     void appendSample(const std::shared_ptr<T>& somaOrSection, const Sample& sample) {
-        debugInfo.setLineNumber(sample.id, sample.lineNumber);
+        if (loadOptions.lineNumbers)
+            debugInfo.setLineNumber(sample.id, sample.lineNumber);
         somaOrSection->points().push_back(sample.point);
         somaOrSection->diameters().push_back(sample.diameter);
     }
 
+    /**
+       Push the samples of the subtree of id, depth first, without the neurites filtered out by
+       the LoadOptions
+    **/
     void _pushChildren(std::vector<unsigned int>& vec, int32_t id) {
         for (unsigned int childId : children[id]) {
+            const Sample& child = samples[childId];
+            if (isRootPoint(child) && !neurite_filter::isLoaded(loadOptions, child.type))
+                continue;
             vec.push_back(childId);
             _pushChildren(vec, static_cast<int>(childId));
         }
@@ -279,8 +300,7 @@ class SWCBuilder
     Property::Properties _buildProperties(unsigned int options) {
         // The process might occasionally creates empty section before
         // filling them so the warning is ignored
-        bool originalIsIgnored = err.isIgnored(morphio::Warning::APPENDING_EMPTY_SECTION);
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, true);
+        const ScopedIgnoredWarning ignoreEmptySections(morphio::Warning::APPENDING_EMPTY_SECTION);
 
         std::vector<unsigned int> depthFirstSamples;
         _pushChildren(depthFirstSamples, -1);
@@ -314,8 +334,6 @@ class SWCBuilder
         Property::Properties properties = morph.buildReadOnly();
         properties._cellLevel._somaType = somaType();
 
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, originalIsIgnored);
-
         return properties;
     }
 
@@ -367,14 +385,47 @@ class SWCBuilder
     std::string uri;
     ErrorMessages err;
     DebugInfo debugInfo;
+    LoadOptions loadOptions;
 };
 
-Property::Properties load(const std::string& uri, unsigned int options) {
-    auto properties = SWCBuilder(uri)._buildProperties(options);
+namespace {
+Property::Properties _load(const std::string& uri,
+                           std::istream& stream,
+                           unsigned int options,
+                           const LoadOptions& loadOptions) {
+    auto properties = SWCBuilder(uri, stream, loadOptions)._buildProperties(options);
     properties._cellLevel._cellFamily = NEURON;
     properties._cellLevel._version = {"swc", 1, 0};
     return properties;
 }
+}  // namespace
+
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          const LoadOptions& loadOptions) {
+    if (isGzip(uri)) {
+        GzipBuffer buffer(uri);
+        std::istream stream(&buffer);
+        // Rethrow decompression errors instead of ending the input silently
+        stream.exceptions(std::ios::badbit);
+        return _load(uri, stream, options, loadOptions);
+    }
+
+    std::ifstream file(uri.c_str());
+    if (file.fail())
+        throw morphio::RawDataError(ErrorMessages(uri).ERROR_OPENING_FILE());
+    return _load(uri, file, options, loadOptions);
+}
+
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                unsigned int options,
+                                const LoadOptions& loadOptions) {
+    MemoryBuffer buffer(data, size);
+    std::istream stream(&buffer);
+    return _load(uri, stream, options, loadOptions);
+}
 
 }  // namespace swc
 }  // namespace readers
@@ -6,7 +6,18 @@
 namespace morphio {
 namespace readers {
 namespace swc {
-Property::Properties load(const std::string& uri, unsigned int options);
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          const LoadOptions& loadOptions = {});
+
+/**
+   Parse the SWC content of a memory buffer, uri is only used in error messages
+**/
+Property::Properties loadBuffer(const char* data,
+                                size_t size,
+                                const std::string& uri,
+                                unsigned int options,
+                                const LoadOptions& loadOptions = {});
 }  // namespace swc
 
 }  // namespace readers
@@ -0,0 +1,266 @@
+#include <fcntl.h>     // open
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // pread, close
+
+#include <algorithm>  // std::all_of, std::find
+#include <cstring>    // std::memcmp
+#include <stdexcept>  // std::logic_error
+
+#include <morphio/exceptions.h>
+
+#include "tarArchive.h"
+
+namespace morphio {
+namespace readers {
+namespace tar {
+
+namespace {
+constexpr uint64_t BLOCK_SIZE = 512;
+
+// Fields of a header block: (offset, length)
+constexpr size_t NAME = 0, NAME_LENGTH = 100;
+constexpr size_t SIZE = 124, SIZE_LENGTH = 12;
+constexpr size_t CHECKSUM = 148, CHECKSUM_LENGTH = 8;
+constexpr size_t TYPE = 156;
+constexpr size_t MAGIC = 257;
+constexpr size_t PREFIX = 345, PREFIX_LENGTH = 155;
+
+std::string _field(const char* header, size_t offset, size_t length) {
+    const char* begin = header + offset;
+    return std::string(begin, std::find(begin, begin + length, '\0'));
+}
+
+/**
+   Numbers are octal, or base-256 for GNU archives when they do not fit in octal
+
+   Base-256 values wider than 64 bits are rejected.
+**/
+bool _number(const char* header, size_t offset, size_t length, uint64_t& value) {
+    const auto* field = reinterpret_cast<const unsigned char*>(header + offset);
+    value = 0;
+    if (field[0] & 0x80) {
+        value = field[0] & 0x7f;
+        for (size_t i = 1; i < length; ++i) {
+            if (value >> 56 != 0)
+                return false;  // more than 8 significant bytes
+            value = (value << 8) | field[i];
+        }
+        return true;
+    }
+
+    bool hasDigits = false;
+    for (size_t i = 0; i < length && field[i] != '\0'; ++i) {
+        if (field[i] == ' ') {
+            if (hasDigits)
+                break;
+            continue;  // leading padding
+        }
+        if (field[i] < '0' || field[i] > '7')
+            return false;
+        value = value * 8 + (field[i] - '0');
+        hasDigits = true;
+    }
+    return hasDigits;
+}
+
+bool _validHeader(const char* header) {
+    uint64_t expected = 0;
+    if (!_number(header, CHECKSUM, CHECKSUM_LENGTH, expected))
+        return false;
+
+    // The checksum is computed with its own field filled with spaces
+    uint64_t sum = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        sum += (i >= CHECKSUM && i < CHECKSUM + CHECKSUM_LENGTH)
+                   ? static_cast<uint64_t>(' ')
+                   : static_cast<unsigned char>(header[i]);
+    }
+    return sum == expected;
+}
+
+bool _isZeroBlock(const char* header) {
+    return std::all_of(header, header + BLOCK_SIZE, [](char c) { return c == '\0'; });
+}
+
+void _readAt(int fd, const std::string& path, uint64_t offset, char* data, uint64_t size) {
+    while (size > 0) {
+        const ssize_t count = pread(fd, data, size, static_cast<off_t>(offset));
+        if (count <= 0)
+            throw RawDataError("Could not read the tar archive " + path);
+        data += count;
+        offset += static_cast<uint64_t>(count);
+        size -= static_cast<uint64_t>(count);
+    }
+}
+
+/**
+   Pax extended headers are records "<length> <key>=<value>\n": return the path and the size
+   they override
+**/
+void _parsePax(const std::string& records,
+               const std::string& path,
+               std::string& name,
+               uint64_t& size,
+               bool& hasSize) {
+    size_t pos = 0;
+    try {
+        while (pos < records.size()) {
+            const size_t space = records.find(' ', pos);
+            const size_t length = std::stoul(records.substr(pos, space - pos));
+            const size_t equal = records.find('=', space);
+            if (space == std::string::npos || length == 0 || pos + length > records.size() ||
+                equal >= pos + length)
+                break;
+
+            const std::string key = records.substr(space + 1, equal - space - 1);
+            const std::string value = records.substr(equal + 1, pos + length - equal - 2);
+            if (key == "path") {
+                name = value;
+            } else if (key == "size") {
+                size = std::stoull(value);
+                hasSize = true;
+            }
+            pos += length;
+        }
+    } catch (const std::logic_error&) {
+        // std::stoul failure: reported below
+    }
+    if (pos != records.size())
+        throw RawDataError("Corrupted pax header in the tar archive " + path);
+}
+}  // namespace
+
+Archive::Archive(const std::string& path)
+    : _path(path) {
+    _fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0)
+        throw RawDataError("Could not open the tar archive " + path);
+
+    struct stat info {};
+    if (fstat(_fd, &info) != 0) {
+        close(_fd);
+        throw RawDataError("Could not open the tar archive " + path);
+    }
+    const auto fileSize = static_cast<uint64_t>(info.st_size);
+
+    try {
+        // Set by GNU long name and pax headers for the next member
+        std::string longName;
+        uint64_t paxSize = 0;
+        bool hasPaxSize = false;
+
+        char header[BLOCK_SIZE];
+        uint64_t offset = 0;
+        while (offset + BLOCK_SIZE <= fileSize) {
+            _readAt(_fd, path, offset, header, BLOCK_SIZE);
+            if (_isZeroBlock(header))
+                break;  // end of archive
+
+            uint64_t size = 0;
+            if (!_validHeader(header) || !_number(header, SIZE, SIZE_LENGTH, size))
+                throw RawDataError("Corrupted header at offset " + std::to_string(offset) +
+                                   " in the tar archive " + path);
+            const char type = header[TYPE];
+            if (hasPaxSize && type != 'x' && type != 'L')
+                size = paxSize;
+
+            // dataOffset <= fileSize from the loop condition: this cannot overflow
+            const uint64_t dataOffset = offset + BLOCK_SIZE;
+            if (size > fileSize - dataOffset)
+                throw RawDataError("The tar archive " + path + " is truncated");
+
+            if (type == 'L' || type == 'x') {
+                std::string data(size, '\0');
+                _readAt(_fd, path, dataOffset, &data[0], size);
+                if (type == 'L')
+                    longName = data.substr(0, data.find('\0'));
+                else
+                    _parsePax(data, path, longName, paxSize, hasPaxSize);
+            } else {
+                if (type == '0' || type == '\0' || type == '7') {
+                    std::string name = longName;
+                    if (name.empty()) {
+                        name = _field(header, NAME, NAME_LENGTH);
+                        // Only POSIX ustar archives have a prefix, GNU ones use the field
+                        // for other purposes
+                        const std::string prefix = _field(header, PREFIX, PREFIX_LENGTH);
+                        if (std::memcmp(header + MAGIC, "ustar\0", 6) == 0 && !prefix.empty())
+                            name = prefix + "/" + name;
+                    }
+                    while (name.compare(0, 2, "./") == 0) {
+                        name.erase(0, 2);
+                    }
+                    _index[name] = _members.size();
+                    _members.push_back({name, dataOffset, size});
+                }
+                longName.clear();
+                hasPaxSize = false;
+            }
+
+            offset = dataOffset + (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        }
+    } catch (...) {
+        close(_fd);
+        throw;
+    }
+}
+
+Archive::Archive(const std::string& path, std::vector<Member> members)
+    : _path(path)
+    , _members(std::move(members)) {
+    _fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0)
+        throw RawDataError("Could not open the tar archive " + path);
+    for (size_t i = 0; i < _members.size(); ++i) {
+        _index[_members[i].name] = i;
+    }
+}
+
+Archive::~Archive() {
+    close(_fd);
+}
+
+bool Archive::isArchive(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    char header[BLOCK_SIZE];
+    const bool valid = pread(fd, header, BLOCK_SIZE, 0) == static_cast<ssize_t>(BLOCK_SIZE) &&
+                       !_isZeroBlock(header) && _validHeader(header);
+    close(fd);
+    return valid;
+}
+
+const std::vector<Member>& Archive::members() const noexcept {
+    return _members;
+}
+
+const Member* Archive::find(const std::string& name) const {
+    const auto it = _index.find(name);
+    return it == _index.end() ? nullptr : &_members[it->second];
+}
+
+bool Archive::hasHeader(const Member& member) const {
+    if (member.offset < BLOCK_SIZE)
+        return false;
+    char header[BLOCK_SIZE];
+    if (pread(_fd, header, BLOCK_SIZE, static_cast<off_t>(member.offset - BLOCK_SIZE)) !=
+            static_cast<ssize_t>(BLOCK_SIZE) ||
+        !_validHeader(header))
+        return false;
+
+    const char type = header[TYPE];
+    uint64_t size = 0;
+    return (type == '0' || type == '\0' || type == '7') &&
+           _number(header, SIZE, SIZE_LENGTH, size) && size == member.size;
+}
+
+std::vector<char> Archive::read(const Member& member) const {
+    std::vector<char> content(member.size);
+    _readAt(_fd, _path, member.offset, content.data(), member.size);
+    return content;
+}
+
+}  // namespace tar
+}  // namespace readers
+}  // namespace morphio
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+#include <string>   // std::string
+#include <unordered_map>
+#include <vector>  // std::vector
+
+namespace morphio {
+namespace readers {
+namespace tar {
+
+/** A regular file of a tar archive: its path in the archive and its byte range **/
+struct Member {
+    std::string name;
+    uint64_t offset;
+    uint64_t size;
+};
+
+/**
+   An uncompressed tar archive, indexed once then read by member
+
+   The headers are read when the archive is opened. Reading a member is then a single read of
+   its byte range: the archive is never extracted. ustar, GNU long names and pax extended
+   headers are supported. Directories, links and other special members are skipped.
+
+   Members can be read from several threads at once.
+**/
+class Archive
+{
+  public:
+    /**
+       Open and index the archive
+
+       @throw RawDataError if the archive cannot be opened or a header is corrupted
+    **/
+    explicit Archive(const std::string& path);
+
+    /**
+       Open the archive with its members already known (ex: from the index of a collection),
+       without reading the headers
+
+       @throw RawDataError if the archive cannot be opened
+    **/
+    Archive(const std::string& path, std::vector<Member> members);
+    ~Archive();
+
+    Archive(const Archive&) = delete;
+    Archive& operator=(const Archive&) = delete;
+
+    /**
+       Return true if the file starts with a valid tar header
+    **/
+    static bool isArchive(const std::string& path);
+
+    /**
+       Return the regular files of the archive, in archive order
+    **/
+    const std::vector<Member>& members() const noexcept;
+
+    /**
+       Return the member with the given path, nullptr if there is none
+    **/
+    const Member* find(const std::string& name) const;
+
+    /**
+       Return true if the header of the member, read again from the archive, still describes a
+       regular file of the same size: false once the archive was rewritten
+    **/
+    bool hasHeader(const Member& member) const;
+
+    /**
+       Read the content of a member
+
+       @throw RawDataError if the read fails
+    **/
+    std::vector<char> read(const Member& member) const;
+
+  private:
+    std::string _path;
+    int _fd = -1;
+    std::vector<Member> _members;
+    std::unordered_map<std::string, size_t> _index;
+};
+
+}  // namespace tar
+}  // namespace readers
+}  // namespace morphio
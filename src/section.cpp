@@ -35,14 +35,20 @@ upstream_iterator Section::upstream_end() const {
 }
 
 range<const Point> Section::points() const {
+    if (_properties->_lazyPointLevel)
+        return _properties->_lazyPointLevel->points(_range);
     return get<Property::Point>();
 }
 
 range<const floatType> Section::diameters() const {
+    if (_properties->_lazyPointLevel)
+        return _properties->_lazyPointLevel->diameters(_range);
     return get<Property::Diameter>();
 }
 
 range<const floatType> Section::perimeters() const {
+    if (_properties->_lazyPointLevel)
+        return _properties->_lazyPointLevel->perimeters(_range);
     return get<Property::Perimeter>();
 }
 
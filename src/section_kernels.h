@@ -0,0 +1,34 @@
+#pragma once
+
+#include <morphio/modifiers.h>
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace modifiers {
+/**
+   Append the points of `range` of `from` to `to`, resampled uniformly along their path length,
+   see morphio::modifiers::resample. spacing must be strictly positive.
+**/
+void _resampleSection(const Property::PointLevel& from,
+                      SectionRange range,
+                      floatType spacing,
+                      Property::PointLevel& to);
+
+/**
+   Append the points of `range` of `from` to `to`, simplified with the Ramer-Douglas-Peucker
+   algorithm, see morphio::modifiers::simplify. tolerance must be positive or zero.
+**/
+void _simplifySection(const Property::PointLevel& from,
+                      SectionRange range,
+                      floatType tolerance,
+                      Property::PointLevel& to);
+
+/** @throw MorphioError if a spacing is not strictly positive, NaN included **/
+void _checkSpacing(floatType spacing);
+void _checkSpacing(const SectionTypeParameters& spacings);
+
+/** @throw MorphioError if a tolerance is negative or NaN **/
+void _checkTolerance(floatType tolerance);
+void _checkTolerance(const SectionTypeParameters& tolerances);
+}  // namespace modifiers
+}  // namespace morphio
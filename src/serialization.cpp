@@ -0,0 +1,650 @@
+#include <cstdint>  // std::uintptr_t
+#include <cstring>  // std::memcpy
+#include <mutex>
+
+#include <morphio/exceptions.h>
+
+#include "neurite_filter.h"
+#include "serialization.h"
+
+namespace morphio {
+namespace serialization {
+
+namespace {
+constexpr char MAGIC[8] = {'\x89', 'M', 'O', 'R', 'P', 'H', 'I', 'O'};
+constexpr uint32_t FORMAT_MAJOR = 1;
+constexpr uint32_t FORMAT_MINOR = 0;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t ALIGNMENT = 64;
+
+enum BlockId : uint32_t {
+    POINTS = 1,
+    DIAMETERS,
+    PERIMETERS,
+    SECTIONS,
+    SECTION_TYPES,
+    SOMA_POINTS,
+    SOMA_DIAMETERS,
+    SOMA_PERIMETERS,
+    MITO_SECTION_IDS,
+    MITO_PATH_LENGTHS,
+    MITO_DIAMETERS,
+    MITO_SECTIONS,
+    ER_SECTION_INDICES,
+    ER_VOLUMES,
+    ER_SURFACE_AREAS,
+    ER_FILAMENT_COUNTS,
+    CELL,
+    ANNOTATIONS,
+    MARKERS,
+    BLOCK_ID_END
+};
+
+struct Header {
+    char magic[8];
+    uint32_t formatMajor;
+    uint32_t formatMinor;
+    uint32_t byteOrderMark;
+    uint32_t floatSize;
+    uint64_t size;
+    uint32_t nBlocks;
+    uint32_t reserved0;
+    uint64_t tableChecksum;
+    uint64_t reserved1[2];
+};
+static_assert(sizeof(Header) == 64, "The header must be 64 bytes");
+
+struct BlockEntry {
+    uint32_t id;
+    uint32_t elementSize;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t checksum;
+};
+static_assert(sizeof(BlockEntry) == 32, "Block entries must be 32 bytes");
+
+size_t _align(size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+RawDataError _corrupted(const std::string& reason) {
+    return RawDataError("Cannot decode the serialized morphology: " + reason);
+}
+
+/** Byte stream of the blocks holding structures: cell level data, annotations and markers **/
+class StreamWriter
+{
+  public:
+    template <typename T>
+    void write(const T& value) {
+        _write(&value, sizeof(T));
+    }
+
+    void write(const std::string& value) {
+        write<uint64_t>(value.size());
+        _write(value.data(), value.size());
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& values) {
+        write<uint64_t>(values.size());
+        _write(values.data(), values.size() * sizeof(T));
+    }
+
+    void write(const Property::PointLevel& pointLevel) {
+        write(pointLevel._points);
+        write(pointLevel._diameters);
+        write(pointLevel._perimeters);
+    }
+
+    std::vector<char> buffer;
+
+  private:
+    void _write(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+};
+
+class StreamReader
+{
+  public:
+    StreamReader(const char* data, size_t size)
+        : _data(data)
+        , _size(size) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        _read(&value, sizeof(T));
+        return value;
+    }
+
+    std::string readString() {
+        const auto size = _readCount(1);
+        std::string value(size, '\0');
+        _read(&value[0], size);
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> readVector() {
+        std::vector<T> values(_readCount(sizeof(T)));
+        _read(values.data(), values.size() * sizeof(T));
+        return values;
+    }
+
+    Property::PointLevel readPointLevel() {
+        auto points = readVector<Point>();
+        auto diameters = readVector<floatType>();
+        auto perimeters = readVector<floatType>();
+        try {
+            return {std::move(points), std::move(diameters), std::move(perimeters)};
+        } catch (const SectionBuilderError& exc) {
+            throw _corrupted(exc.what());
+        }
+    }
+
+  private:
+    size_t _readCount(size_t elementSize) {
+        const auto count = read<uint64_t>();
+        if (count > (_size - _position) / elementSize)
+            throw _corrupted("truncated block");
+        return static_cast<size_t>(count);
+    }
+
+    void _read(void* value, size_t size) {
+        if (size > _size - _position)
+            throw _corrupted("truncated block");
+        std::memcpy(value, _data + _position, size);
+        _position += size;
+    }
+
+    const char* _data;
+    size_t _size;
+    size_t _position = 0;
+};
+
+struct Block {
+    BlockId id;
+    uint32_t elementSize;
+    const char* data;
+    size_t size;
+};
+
+template <typename T>
+void _addArray(std::vector<Block>& blocks, BlockId id, const std::vector<T>& values) {
+    if (!values.empty())
+        blocks.push_back({id,
+                          static_cast<uint32_t>(sizeof(T)),
+                          reinterpret_cast<const char*>(values.data()),
+                          values.size() * sizeof(T)});
+}
+
+void _addStream(std::vector<Block>& blocks, BlockId id, const std::vector<char>& stream) {
+    blocks.push_back({id, 1, stream.data(), stream.size()});
+}
+
+template <typename T>
+void _checkElementSize(const Block& block) {
+    if (block.elementSize != sizeof(T) || block.size % sizeof(T) != 0)
+        throw _corrupted("block " + std::to_string(block.id) + " has elements of " +
+                         std::to_string(block.elementSize) + " bytes instead of " +
+                         std::to_string(sizeof(T)));
+}
+
+template <typename T>
+void _readArray(const Block& block, std::vector<T>& values) {
+    _checkElementSize<T>(block);
+    values.resize(block.size / sizeof(T));
+    std::memcpy(static_cast<void*>(values.data()), block.data, block.size);
+}
+
+/**
+   The point level of the neurites viewed in place in an encoded buffer
+
+   The whole point level is only copied out of the buffer when all() is called, by the
+   accessors of the whole morphology arrays like Morphology::points().
+**/
+class MappedPointLevel: public Property::LazyPointLevel
+{
+  public:
+    MappedPointLevel(std::shared_ptr<const void> owner,
+                     range<const Point> points,
+                     range<const floatType> diameters,
+                     range<const floatType> perimeters)
+        : _owner(std::move(owner))
+        , _points(points)
+        , _diameters(diameters)
+        , _perimeters(perimeters) {}
+
+    size_t size() const noexcept override {
+        return _points.size();
+    }
+
+    const Property::PointLevel& block(const SectionRange& range, size_t& offset) override {
+        offset = range.first;
+        return all();
+    }
+
+    const Property::PointLevel& all() override {
+        std::call_once(_copied, [this]() {
+            _pointLevel._points.assign(_points.begin(), _points.end());
+            _pointLevel._diameters.assign(_diameters.begin(), _diameters.end());
+            _pointLevel._perimeters.assign(_perimeters.begin(), _perimeters.end());
+        });
+        return _pointLevel;
+    }
+
+    void release(size_t /*end*/) override {}
+
+    range<const Point> points(const SectionRange& range) override {
+        return _points.subspan(range.first, range.second - range.first);
+    }
+
+    range<const floatType> diameters(const SectionRange& range) override {
+        return _diameters.subspan(range.first, range.second - range.first);
+    }
+
+    range<const floatType> perimeters(const SectionRange& range) override {
+        if (_perimeters.empty())
+            return {};
+        return _perimeters.subspan(range.first, range.second - range.first);
+    }
+
+  private:
+    std::shared_ptr<const void> _owner;
+    range<const Point> _points;
+    range<const floatType> _diameters;
+    range<const floatType> _perimeters;
+
+    std::once_flag _copied;
+    Property::PointLevel _pointLevel;
+};
+
+/** The elements of an array block, in place: the block must be aligned **/
+template <typename T>
+void _viewArray(const Block& block, range<const T>& values) {
+    _checkElementSize<T>(block);
+    values = {reinterpret_cast<const T*>(block.data), block.size / sizeof(T)};
+}
+
+void _readCell(const Block& block, Property::CellLevel& cellLevel) {
+    StreamReader reader(block.data, block.size);
+    cellLevel._cellFamily = static_cast<CellFamily>(reader.read<uint32_t>());
+    cellLevel._somaType = static_cast<SomaType>(reader.read<uint32_t>());
+    const auto major = reader.read<uint32_t>();
+    const auto minor = reader.read<uint32_t>();
+    cellLevel._version = MorphologyVersion{reader.readString(), major, minor};
+}
+
+void _readAnnotations(const Block& block, std::vector<Property::Annotation>& annotations) {
+    StreamReader reader(block.data, block.size);
+    for (auto count = reader.read<uint64_t>(); count > 0; --count) {
+        const auto type = static_cast<AnnotationType>(reader.read<uint32_t>());
+        const auto sectionId = reader.read<uint32_t>();
+        const auto lineNumber = reader.read<int32_t>();
+        std::string details = reader.readString();
+        annotations.emplace_back(
+            type, sectionId, reader.readPointLevel(), std::move(details), lineNumber);
+    }
+}
+
+void _readMarkers(const Block& block, std::vector<Property::Marker>& markers) {
+    StreamReader reader(block.data, block.size);
+    for (auto count = reader.read<uint64_t>(); count > 0; --count) {
+        Property::Marker marker;
+        marker._label = reader.readString();
+        marker._sectionId = reader.read<int32_t>();
+        marker._pointLevel = reader.readPointLevel();
+        markers.push_back(std::move(marker));
+    }
+}
+
+void _checkSize(const std::string& name, size_t size, size_t expected) {
+    if (size != expected)
+        throw _corrupted("'" + name + "' has " + std::to_string(size) + " elements instead of " +
+                         std::to_string(expected));
+}
+
+/**
+   Sections must point into the point arrays and have a valid parent, otherwise accessing
+   them would read out of bounds
+**/
+void _checkSections(const std::string& name,
+                    const std::vector<Property::Section::Type>& sections,
+                    size_t nPoints) {
+    const auto nSections = static_cast<int64_t>(sections.size());
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const int offset = sections[i][0];
+        const int parent = sections[i][1];
+        if (offset < 0 || static_cast<size_t>(offset) > nPoints ||
+            (i > 0 && offset < sections[i - 1][0]))
+            throw _corrupted(name + " " + std::to_string(i) + " has an invalid offset");
+        if (parent < -1 || parent >= nSections)
+            throw _corrupted(name + " " + std::to_string(i) + " has an invalid parent");
+    }
+}
+
+bool _skipped(BlockId id, const LoadOptions& loadOptions) noexcept {
+    switch (id) {
+    case PERIMETERS:
+    case SOMA_PERIMETERS:
+        return !loadOptions.perimeters;
+    case MITO_SECTION_IDS:
+    case MITO_PATH_LENGTHS:
+    case MITO_DIAMETERS:
+    case MITO_SECTIONS:
+        return !loadOptions.mitochondria;
+    case ER_SECTION_INDICES:
+    case ER_VOLUMES:
+    case ER_SURFACE_AREAS:
+    case ER_FILAMENT_COUNTS:
+        return !loadOptions.endoplasmicReticulum;
+    case ANNOTATIONS:
+        return !loadOptions.annotations;
+    case MARKERS:
+        return !loadOptions.markers;
+    default:
+        return false;
+    }
+}
+
+void _checkConsistency(const Property::Properties& properties) {
+    // The sizes of the point level viewed in place are checked before it is created
+    const auto& pointLevel = properties._pointLevel;
+    const size_t nPoints = properties._lazyPointLevel ? properties._lazyPointLevel->size()
+                                                      : pointLevel._points.size();
+    _checkSize("diameters", pointLevel._diameters.size(), pointLevel._points.size());
+    if (!pointLevel._perimeters.empty())
+        _checkSize("perimeters", pointLevel._perimeters.size(), pointLevel._points.size());
+
+    const auto& somaLevel = properties._somaLevel;
+    _checkSize("soma diameters", somaLevel._diameters.size(), somaLevel._points.size());
+    if (!somaLevel._perimeters.empty())
+        _checkSize("soma perimeters", somaLevel._perimeters.size(), somaLevel._points.size());
+
+    const auto& sectionLevel = properties._sectionLevel;
+    _checkSize("section types", sectionLevel._sectionTypes.size(), sectionLevel._sections.size());
+    _checkSections("section", sectionLevel._sections, nPoints);
+
+    const auto& mitoPoints = properties._mitochondriaPointLevel;
+    const size_t nMitoPoints = mitoPoints._sectionIds.size();
+    _checkSize("mitochondria path lengths", mitoPoints._relativePathLengths.size(), nMitoPoints);
+    _checkSize("mitochondria diameters", mitoPoints._diameters.size(), nMitoPoints);
+    _checkSections("mitochondrial section",
+                   properties._mitochondriaSectionLevel._sections,
+                   nMitoPoints);
+
+    const auto& er = properties._endoplasmicReticulumLevel;
+    _checkSize("endoplasmic reticulum volumes", er._volumes.size(), er._sectionIndices.size());
+    _checkSize("endoplasmic reticulum surface areas",
+               er._surfaceAreas.size(),
+               er._sectionIndices.size());
+    _checkSize("endoplasmic reticulum filament counts",
+               er._filamentCounts.size(),
+               er._sectionIndices.size());
+}
+}  // namespace
+
+std::vector<char> encode(const Property::Properties& properties) {
+    const auto& cellLevel = properties._cellLevel;
+    StreamWriter cell;
+    cell.write<uint32_t>(cellLevel._cellFamily);
+    cell.write<uint32_t>(cellLevel._somaType);
+    cell.write<uint32_t>(std::get<1>(cellLevel._version));
+    cell.write<uint32_t>(std::get<2>(cellLevel._version));
+    cell.write(std::get<0>(cellLevel._version));
+
+    StreamWriter annotations;
+    annotations.write<uint64_t>(cellLevel._annotations.size());
+    for (const auto& annotation : cellLevel._annotations) {
+        annotations.write<uint32_t>(annotation._type);
+        annotations.write<uint32_t>(annotation._sectionId);
+        annotations.write<int32_t>(annotation._lineNumber);
+        annotations.write(annotation._details);
+        annotations.write(annotation._points);
+    }
+
+    StreamWriter markers;
+    markers.write<uint64_t>(cellLevel._markers.size());
+    for (const auto& marker : cellLevel._markers) {
+        markers.write(marker._label);
+        markers.write<int32_t>(marker._sectionId);
+        markers.write(marker._pointLevel);
+    }
+
+    std::vector<Block> blocks;
+    _addArray(blocks, POINTS, properties._pointLevel._points);
+    _addArray(blocks, DIAMETERS, properties._pointLevel._diameters);
+    _addArray(blocks, PERIMETERS, properties._pointLevel._perimeters);
+    _addArray(blocks, SECTIONS, properties._sectionLevel._sections);
+    _addArray(blocks, SECTION_TYPES, properties._sectionLevel._sectionTypes);
+    _addArray(blocks, SOMA_POINTS, properties._somaLevel._points);
+    _addArray(blocks, SOMA_DIAMETERS, properties._somaLevel._diameters);
+    _addArray(blocks, SOMA_PERIMETERS, properties._somaLevel._perimeters);
+    _addArray(blocks, MITO_SECTION_IDS, properties._mitochondriaPointLevel._sectionIds);
+    _addArray(blocks,
+              MITO_PATH_LENGTHS,
+              properties._mitochondriaPointLevel._relativePathLengths);
+    _addArray(blocks, MITO_DIAMETERS, properties._mitochondriaPointLevel._diameters);
+    _addArray(blocks, MITO_SECTIONS, properties._mitochondriaSectionLevel._sections);
+    _addArray(blocks, ER_SECTION_INDICES, properties._endoplasmicReticulumLevel._sectionIndices);
+    _addArray(blocks, ER_VOLUMES, properties._endoplasmicReticulumLevel._volumes);
+    _addArray(blocks, ER_SURFACE_AREAS, properties._endoplasmicReticulumLevel._surfaceAreas);
+    _addArray(blocks, ER_FILAMENT_COUNTS, properties._endoplasmicReticulumLevel._filamentCounts);
+    _addStream(blocks, CELL, cell.buffer);
+    if (!cellLevel._annotations.empty())
+        _addStream(blocks, ANNOTATIONS, annotations.buffer);
+    if (!cellLevel._markers.empty())
+        _addStream(blocks, MARKERS, markers.buffer);
+
+    std::vector<BlockEntry> table;
+    table.reserve(blocks.size());
+    size_t size = _align(sizeof(Header) + blocks.size() * sizeof(BlockEntry));
+    for (const auto& block : blocks) {
+        table.push_back({block.id, block.elementSize, size, block.size, 0});
+        size = _align(size + block.size);
+    }
+
+    // Zero initialized: the padding is deterministic
+    std::vector<char> buffer(size);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        std::memcpy(&buffer[table[i].offset], blocks[i].data, blocks[i].size);
+        table[i].checksum = checksum(blocks[i].data, blocks[i].size);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatMajor = FORMAT_MAJOR;
+    header.formatMinor = FORMAT_MINOR;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.floatSize = sizeof(floatType);
+    header.size = size;
+    header.nBlocks = static_cast<uint32_t>(table.size());
+    header.tableChecksum = checksum(reinterpret_cast<const char*>(table.data()),
+                                     table.size() * sizeof(BlockEntry));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), table.data(), table.size() * sizeof(BlockEntry));
+    return buffer;
+}
+
+/**
+   FNV-1a over 64 bits words: it only has to catch truncated or corrupted buffers, and must
+   not be much slower than the memcpy of the arrays
+**/
+uint64_t checksum(const char* data, size_t size) noexcept {
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+    return hash;
+}
+
+bool isEncoded(const char* data, size_t size) noexcept {
+    return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+namespace {
+/** decode() and decodeInPlace(), the point level is viewed in place if `owner` is set **/
+Property::Properties _decode(const char* data,
+                             size_t size,
+                             const LoadOptions& loadOptions,
+                             std::shared_ptr<const void> owner) {
+    if (size < sizeof(Header) || !isEncoded(data, size))
+        throw _corrupted("this is not a serialized morphology");
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.formatMajor != FORMAT_MAJOR)
+        throw _corrupted("unsupported format version " + std::to_string(header.formatMajor) +
+                         "." + std::to_string(header.formatMinor));
+    if (header.byteOrderMark != BYTE_ORDER_MARK)
+        throw _corrupted("it was serialized on a platform with a different byte order");
+    if (header.floatSize != sizeof(floatType))
+        throw _corrupted("it was serialized with " + std::to_string(8 * header.floatSize) +
+                         " bits floating points instead of " +
+                         std::to_string(8 * sizeof(floatType)));
+    if (header.size > size)
+        throw _corrupted("the buffer is truncated");
+    if (header.nBlocks > (header.size - sizeof(Header)) / sizeof(BlockEntry))
+        throw _corrupted("the block table is truncated");
+
+    std::vector<BlockEntry> table(header.nBlocks);
+    std::memcpy(static_cast<void*>(table.data()),
+                data + sizeof(Header),
+                table.size() * sizeof(BlockEntry));
+    if (checksum(reinterpret_cast<const char*>(table.data()),
+                  table.size() * sizeof(BlockEntry)) != header.tableChecksum)
+        throw _corrupted("the block table checksum does not match");
+
+    // Block offsets are aligned relatively to the start of the buffer. The neurite filter
+    // rewrites the point level: it is copied then.
+    const bool inPlace = owner && reinterpret_cast<std::uintptr_t>(data) % ALIGNMENT == 0 &&
+                         loadOptions.neuriteTypes.empty();
+    range<const Point> points;
+    range<const floatType> diameters;
+    range<const floatType> perimeters;
+
+    Property::Properties properties;
+    for (const BlockEntry& entry : table) {
+        if (entry.offset > header.size || entry.size > header.size - entry.offset)
+            throw _corrupted("block " + std::to_string(entry.id) + " is out of the buffer");
+        const Block block{static_cast<BlockId>(entry.id),
+                          entry.elementSize,
+                          data + entry.offset,
+                          static_cast<size_t>(entry.size)};
+        if (_skipped(block.id, loadOptions))
+            continue;
+        if (checksum(block.data, block.size) != entry.checksum)
+            throw _corrupted("block " + std::to_string(entry.id) + " checksum does not match");
+
+        switch (block.id) {
+        case POINTS:
+            if (inPlace)
+                _viewArray(block, points);
+            else
+                _readArray(block, properties._pointLevel._points);
+            break;
+        case DIAMETERS:
+            if (inPlace)
+                _viewArray(block, diameters);
+            else
+                _readArray(block, properties._pointLevel._diameters);
+            break;
+        case PERIMETERS:
+            if (inPlace)
+                _viewArray(block, perimeters);
+            else
+                _readArray(block, properties._pointLevel._perimeters);
+            break;
+        case SECTIONS:
+            _readArray(block, properties._sectionLevel._sections);
+            break;
+        case SECTION_TYPES:
+            _readArray(block, properties._sectionLevel._sectionTypes);
+            break;
+        case SOMA_POINTS:
+            _readArray(block, properties._somaLevel._points);
+            break;
+        case SOMA_DIAMETERS:
+            _readArray(block, properties._somaLevel._diameters);
+            break;
+        case SOMA_PERIMETERS:
+            _readArray(block, properties._somaLevel._perimeters);
+            break;
+        case MITO_SECTION_IDS:
+            _readArray(block, properties._mitochondriaPointLevel._sectionIds);
+            break;
+        case MITO_PATH_LENGTHS:
+            _readArray(block, properties._mitochondriaPointLevel._relativePathLengths);
+            break;
+        case MITO_DIAMETERS:
+            _readArray(block, properties._mitochondriaPointLevel._diameters);
+            break;
+        case MITO_SECTIONS:
+            _readArray(block, properties._mitochondriaSectionLevel._sections);
+            break;
+        case ER_SECTION_INDICES:
+            _readArray(block, properties._endoplasmicReticulumLevel._sectionIndices);
+            break;
+        case ER_VOLUMES:
+            _readArray(block, properties._endoplasmicReticulumLevel._volumes);
+            break;
+        case ER_SURFACE_AREAS:
+            _readArray(block, properties._endoplasmicReticulumLevel._surfaceAreas);
+            break;
+        case ER_FILAMENT_COUNTS:
+            _readArray(block, properties._endoplasmicReticulumLevel._filamentCounts);
+            break;
+        case CELL:
+            _readCell(block, properties._cellLevel);
+            break;
+        case ANNOTATIONS:
+            _readAnnotations(block, properties._cellLevel._annotations);
+            break;
+        case MARKERS:
+            _readMarkers(block, properties._cellLevel._markers);
+            break;
+        case BLOCK_ID_END:
+        default:
+            // Blocks added by a later minor version: skipped
+            break;
+        }
+    }
+
+    if (inPlace) {
+        _checkSize("diameters", diameters.size(), points.size());
+        if (!perimeters.empty())
+            _checkSize("perimeters", perimeters.size(), points.size());
+        properties._lazyPointLevel = std::make_shared<MappedPointLevel>(
+            std::move(owner), points, diameters, perimeters);
+    }
+
+    _checkConsistency(properties);
+    neurite_filter::apply(properties, loadOptions);
+    return properties;
+}
+}  // namespace
+
+Property::Properties decode(const char* data, size_t size, const LoadOptions& loadOptions) {
+    return _decode(data, size, loadOptions, nullptr);
+}
+
+Property::Properties decodeInPlace(const char* data,
+                                   size_t size,
+                                   std::shared_ptr<const void> owner,
+                                   const LoadOptions& loadOptions) {
+    return _decode(data, size, loadOptions, std::move(owner));
+}
+
+}  // namespace serialization
+}  // namespace morphio
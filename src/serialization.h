@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>  // std::shared_ptr
+#include <vector>
+
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace serialization {
+/**
+   Compact binary encoding of a Property::Properties
+
+   The encoding is a 64 bytes header, a table of blocks and the blocks themselves: each array
+   of the properties is stored raw, in native byte order, in its own block aligned on 64 bytes.
+   The header and every block carry a checksum. Encoding and decoding are one memcpy per array.
+
+   The children maps are not encoded: they are rebuilt from the sections.
+**/
+std::vector<char> encode(const Property::Properties& properties);
+
+/**
+   Decode properties encoded by encode()
+
+   The blocks of the payloads disabled in loadOptions are skipped, checksum included. The
+   neurites filtered out by loadOptions are dropped once decoded.
+
+   @throw RawDataError if the buffer is truncated, corrupted, was encoded by an incompatible
+   version of MorphIO or on a platform with a different byte order or floating point precision
+**/
+Property::Properties decode(const char* data, size_t size, const LoadOptions& loadOptions = {});
+
+/**
+   Decode like decode(), without copying the points, diameters and perimeters of the neurites:
+   Properties::_lazyPointLevel views them in place in the buffer, that `owner` keeps alive
+
+   The blocks are viewed in place when the buffer is aligned on 64 bytes, as encode() aligns
+   them relatively to its start, and no neurite is filtered out by loadOptions; otherwise they
+   are copied.
+**/
+Property::Properties decodeInPlace(const char* data,
+                                   size_t size,
+                                   std::shared_ptr<const void> owner,
+                                   const LoadOptions& loadOptions = {});
+
+/**
+   Return true if the buffer starts with the magic bytes of the encoding
+**/
+bool isEncoded(const char* data, size_t size) noexcept;
+
+/**
+   The 64 bits checksum of the blocks: fast, but not a cryptographic hash
+**/
+uint64_t checksum(const char* data, size_t size) noexcept;
+}  // namespace serialization
+}  // namespace morphio
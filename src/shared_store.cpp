@@ -0,0 +1,265 @@
+#include <fcntl.h>     // O_* constants
+#include <sys/mman.h>  // mmap, shm_open
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close, ftruncate, unlink
+
+#include <atomic>  // std::atomic_thread_fence
+#include <cerrno>
+#include <cstring>  // std::memcpy, std::strerror
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <morphio/exceptions.h>
+#include <morphio/shared_store.h>
+
+#include "morphology_loading.h"
+#include "serialization.h"
+
+namespace morphio {
+
+namespace {
+constexpr char MAGIC[8] = {'\x89', 'M', 'O', 'R', 'P', 'H', 'S', 'T'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t ALIGNMENT = 64;
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t nEntries;
+    uint64_t size;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+    uint64_t reserved[3];
+};
+static_assert(sizeof(Header) == 64, "The header must be 64 bytes");
+
+size_t _align(size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+bool _isSharedMemory(const std::string& name) {
+    return name.find('/') == std::string::npos;
+}
+
+int _open(const std::string& name, int flags, mode_t mode) {
+    if (_isSharedMemory(name))
+        return shm_open(("/" + name).c_str(), flags, mode);
+    return open(name.c_str(), flags, mode);
+}
+
+RawDataError _systemError(const std::string& message) {
+    return RawDataError("SharedStore: " + message + ": " + std::strerror(errno));
+}
+
+template <typename T>
+void _append(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+}  // namespace
+
+struct SharedStore::Impl {
+    std::string _name;
+    // Also kept alive by the morphologies viewing their points in it
+    const char* _data = nullptr;
+    size_t _size = 0;
+
+    std::vector<std::string> _keys;
+    // Key -> (offset, size) of the serialized morphology
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> _index;
+
+    // Morphologies loaded by this process, shared while they are alive
+    mutable std::mutex _mutex;
+    mutable std::unordered_map<std::string, std::weak_ptr<Property::Properties>> _loaded;
+
+    ~Impl() {
+        if (_data)
+            munmap(const_cast<char*>(_data), _size);
+    }
+
+    RawDataError invalid(const std::string& reason) const {
+        return RawDataError("SharedStore: " + _name + " is not a valid store: " + reason);
+    }
+
+    /** Parse the index written by create(), every offset is checked against the mapping **/
+    void readIndex() {
+        if (_size < sizeof(Header) || std::memcmp(_data, MAGIC, sizeof(MAGIC)) != 0)
+            throw invalid("wrong magic bytes, or the store is still being created");
+
+        Header header;
+        std::memcpy(&header, _data, sizeof(header));
+        if (header.formatVersion != FORMAT_VERSION)
+            throw invalid("unsupported version " + std::to_string(header.formatVersion));
+        if (header.size > _size || header.indexOffset > header.size ||
+            header.indexSize > header.size - header.indexOffset)
+            throw invalid("truncated");
+
+        const char* position = _data + header.indexOffset;
+        const char* end = position + header.indexSize;
+        const auto read = [&](void* value, size_t size) {
+            if (size > static_cast<size_t>(end - position))
+                throw invalid("truncated index");
+            std::memcpy(value, position, size);
+            position += size;
+        };
+
+        _keys.reserve(header.nEntries);
+        for (uint32_t i = 0; i < header.nEntries; ++i) {
+            uint64_t offset, size, keySize;
+            read(&offset, sizeof(offset));
+            read(&size, sizeof(size));
+            read(&keySize, sizeof(keySize));
+            if (offset > header.size || size > header.size - offset ||
+                keySize > static_cast<size_t>(end - position))
+                throw invalid("truncated entry");
+            std::string key(position, keySize);
+            position += keySize;
+            _index[key] = {offset, size};
+            _keys.push_back(std::move(key));
+        }
+    }
+};
+
+SharedStore::SharedStore(const std::string& name)
+    : _impl(std::make_shared<Impl>()) {
+    _impl->_name = name;
+
+    const int fd = _open(name, O_RDONLY, 0);
+    if (fd < 0)
+        throw _systemError("cannot open " + name);
+
+    struct stat info {};
+    void* data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+        data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw _systemError("cannot map " + name);
+
+    _impl->_data = static_cast<const char*>(data);
+    _impl->_size = static_cast<size_t>(info.st_size);
+    _impl->readIndex();
+}
+
+SharedStore::~SharedStore() = default;
+
+SharedStore SharedStore::create(const std::string& name,
+                                const std::vector<std::string>& keys,
+                                const std::vector<const Morphology*>& morphologies) {
+    if (keys.size() != morphologies.size())
+        throw RawDataError("SharedStore: there are " + std::to_string(keys.size()) +
+                           " keys for " + std::to_string(morphologies.size()) +
+                           " morphologies");
+
+    if (std::unordered_set<std::string>(keys.begin(), keys.end()).size() != keys.size())
+        throw RawDataError("SharedStore: the keys must be unique");
+
+    std::vector<std::vector<char>> serialized;
+    serialized.reserve(morphologies.size());
+    for (const Morphology* morphology : morphologies) {
+        serialized.push_back(morphology->serialize());
+    }
+
+    // Layout: header, serialized morphologies, index
+    std::vector<char> index;
+    size_t size = _align(sizeof(Header));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        _append<uint64_t>(index, size);
+        _append<uint64_t>(index, serialized[i].size());
+        _append<uint64_t>(index, keys[i].size());
+        index.insert(index.end(), keys[i].begin(), keys[i].end());
+        size = _align(size + serialized[i].size());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.nEntries = static_cast<uint32_t>(keys.size());
+    header.indexOffset = size;
+    header.indexSize = index.size();
+    header.size = size + index.size();
+
+    const int fd = _open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        throw _systemError("cannot create " + name);
+
+    void* data = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(header.size)) == 0)
+        data = mmap(nullptr, header.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        const RawDataError error = _systemError("cannot allocate " + name);
+        remove(name);
+        throw error;
+    }
+
+    char* buffer = static_cast<char*>(data);
+    size_t offset = _align(sizeof(Header));
+    for (const auto& morphology : serialized) {
+        std::memcpy(buffer + offset, morphology.data(), morphology.size());
+        offset = _align(offset + morphology.size());
+    }
+    if (!index.empty())
+        std::memcpy(buffer + header.indexOffset, index.data(), index.size());
+
+    // The magic bytes go last: a process attaching before the end sees an invalid store
+    std::memcpy(buffer + sizeof(header.magic),
+                reinterpret_cast<const char*>(&header) + sizeof(header.magic),
+                sizeof(header) - sizeof(header.magic));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(buffer, header.magic, sizeof(header.magic));
+    munmap(data, header.size);
+
+    return SharedStore(name);
+}
+
+void SharedStore::remove(const std::string& name) {
+    if (_isSharedMemory(name))
+        shm_unlink(("/" + name).c_str());
+    else
+        unlink(name.c_str());
+}
+
+Morphology SharedStore::load(const std::string& key) const {
+    const auto entry = _impl->_index.find(key);
+    if (entry == _impl->_index.end())
+        throw RawDataError("SharedStore: " + _impl->_name + " has no morphology '" + key + "'");
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->_mutex);
+        const auto loaded = _impl->_loaded.find(key);
+        if (loaded != _impl->_loaded.end()) {
+            if (auto properties = loaded->second.lock())
+                return Morphology(std::move(properties));
+        }
+    }
+
+    // The points stay in the mapping, which they keep alive
+    auto properties = std::make_shared<Property::Properties>(
+        serialization::decodeInPlace(_impl->_data + entry->second.first,
+                                     entry->second.second,
+                                     _impl));
+    buildChildren(properties);
+
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    auto& loaded = _impl->_loaded[key];
+    if (auto alreadyLoaded = loaded.lock())
+        return Morphology(std::move(alreadyLoaded));  // loaded concurrently by another thread
+    loaded = properties;
+    return Morphology(std::move(properties));
+}
+
+bool SharedStore::contains(const std::string& key) const {
+    return _impl->_index.count(key) > 0;
+}
+
+const std::vector<std::string>& SharedStore::keys() const noexcept {
+    return _impl->_keys;
+}
+
+size_t SharedStore::size() const noexcept {
+    return _impl->_keys.size();
+}
+
+}  // namespace morphio
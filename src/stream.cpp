@@ -0,0 +1,77 @@
+#include <morphio/enums.h>
+#include <morphio/modifiers.h>
+#include <morphio/stream.h>
+
+#include "morphology_loading.h"
+
+namespace morphio {
+
+namespace {
+template <typename T>
+range<const T> _range(const std::vector<T>& data, size_t offset, size_t count) {
+    if (data.empty())
+        return {};
+    return {data.data() + offset, count};
+}
+}  // namespace
+
+void stream(const std::string& path, MorphologyHandler& handler, const LoadOptions& loadOptions) {
+    // Only the HDF5 reader loads lazily, the others ignore the option
+    LoadOptions streamOptions = loadOptions;
+    streamOptions.lazy = true;
+    streamOptions.mitochondria = false;
+    streamOptions.endoplasmicReticulum = false;
+    Property::Properties properties = loadURI(path, NO_MODIFIER, streamOptions);
+
+    // Same soma type and section order as Morphology(path, NO_MODIFIER)
+    const std::string fileFormat = properties._cellLevel.fileFormat();
+    if (fileFormat != "swc" && fileFormat != "morphio")
+        properties._cellLevel._somaType = getSomaType(properties._somaLevel._points.size());
+
+    auto& lazy = properties._lazyPointLevel;
+    if (lazy && !modifiers::isCompact(properties)) {
+        properties._pointLevel = lazy->all();
+        lazy.reset();
+    }
+    if (fileFormat == "h5" || fileFormat == "morphio")
+        modifiers::apply(properties, NO_MODIFIER);
+
+    const auto& soma = properties._somaLevel;
+    handler.onSoma(properties._cellLevel._somaType,
+                   _range(soma._points, 0, soma._points.size()),
+                   _range(soma._diameters, 0, soma._diameters.size()));
+
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& types = properties._sectionLevel._sectionTypes;
+    const size_t nPoints = lazy ? lazy->size() : properties._pointLevel._points.size();
+    const Property::PointLevel* currentBlock = nullptr;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const auto id = static_cast<uint32_t>(i);
+        const auto begin = static_cast<size_t>(sections[i][0]);
+        const size_t end = i + 1 < sections.size() ? static_cast<size_t>(sections[i + 1][0])
+                                                   : nPoints;
+        const size_t count = end > begin ? end - begin : 0;
+        handler.onSectionBegin(id, types[i], sections[i][1]);
+
+        const Property::PointLevel* pointLevel = &properties._pointLevel;
+        size_t offset = begin;
+        if (lazy) {
+            pointLevel = &lazy->block({begin, begin + count}, offset);
+            // The sections before this one are done: so are the blocks before this one
+            if (pointLevel != currentBlock) {
+                lazy->release(begin);
+                currentBlock = pointLevel;
+            }
+        }
+        handler.onPoints(_range(pointLevel->_points, offset, count),
+                         _range(pointLevel->_diameters, offset, count),
+                         _range(pointLevel->_perimeters, offset, count));
+        handler.onSectionEnd(id);
+    }
+
+    for (const auto& marker : properties._cellLevel._markers) {
+        handler.onMarker(marker);
+    }
+}
+
+}  // namespace morphio
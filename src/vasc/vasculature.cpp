@@ -9,6 +9,7 @@
 #include <morphio/vasc/section.h>
 #include <morphio/vasc/vasculature.h>
 
+#include "../readers/morphologyHDF5.h"
 #include "../readers/morphologySWC.h"
 #include "../readers/vasculatureHDF5.h"
 
@@ -31,6 +32,7 @@ Vasculature::Vasculature(const std::string& source) {
 
     property::Properties loader;
     if (extension == ".h5") {
+        std::lock_guard<std::recursive_mutex> lock(readers::h5::hdf5Mutex());
         loader = readers::h5::VasculatureHDF5(source).load();
     } else {
         throw UnknownFileType("File: " + source + " does not end with the .h5 extension");
@@ -30,14 +30,15 @@ def test_mut_immut_have_same_methods():
         return set(method for method in dir(cls) if not method[:2] == '__')
 
     only_in_immut = {'section_types', 'diameters', 'perimeters', 'points', 'section_offsets',
-                     'as_mutable'}
+                     'as_mutable', 'section_parents', 'section_point_counts', 'section_lengths',
+                     'root_section_ids', 'section_children', 'section_order'}
     only_in_mut = {'remove_unifurcations', 'write', 'append_root_section', 'delete_section', 'build_read_only',
-                   'as_immutable'}
+                   'as_immutable', 'resample', 'simplify', 'checkout_neurite', 'merge_neurite'}
     assert (methods(morphio.Morphology) - only_in_immut ==
                  methods(morphio.mut.Morphology) - only_in_mut)
 
     assert (methods(morphio.Section) ==
-                 methods(morphio.mut.Section) - {'append_section'})
+                 methods(morphio.mut.Section) - {'append_section', 'set_point_data'})
 
     assert (methods(morphio.Soma) ==
                  methods(morphio.mut.Soma))
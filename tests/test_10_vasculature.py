@@ -76,3 +76,16 @@ def test_iterators_vasculature():
 def test_from_pathlib():
     vasc = vasculature.Vasculature(Path(_path, "h5/vasculature1.h5"))
     assert len(vasc.sections) == 3080
+
+
+def test_zero_copy_views():
+    morphology = vasculature.Vasculature(os.path.join(_path, "h5/vasculature1.h5"))
+    section = morphology.section(0)
+    for array in (morphology.points, morphology.diameters, morphology.section_types,
+                  section.points, section.diameters):
+        assert not array.flags.writeable
+    assert np.shares_memory(morphology.points, section.points)
+
+    points, expected = morphology.points, morphology.points.copy()
+    del morphology, section
+    assert_array_equal(points, expected)
@@ -0,0 +1,101 @@
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+from numpy.testing import assert_array_equal
+
+import morphio
+from morphio import (Morphology, MorphioError, RawDataError, Warning, set_ignored_warning,
+                     set_raise_warnings)
+from morphio.vasculature import Vasculature
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+
+FILES = [os.path.join(_path, name) for name in ('nrn_ordering.swc',
+                                                'simple.asc',
+                                                'h5/v1/Neuron.h5',
+                                                'h5/v2/Neuron.h5')]
+
+
+def _load_all(paths, n_threads):
+    with ThreadPoolExecutor(n_threads) as executor:
+        return list(executor.map(Morphology, paths))
+
+
+def test_concurrent_loads():
+    paths = FILES * 20
+    expected = [Morphology(path) for path in paths]
+    for morph, ref in zip(_load_all(paths, 8), expected):
+        assert_array_equal(morph.points, ref.points)
+        assert_array_equal(morph.section_offsets, ref.section_offsets)
+
+
+def test_concurrent_mutable_operations(tmpdir):
+    def work(i):
+        morph = morphio.mut.Morphology(FILES[i % len(FILES)])
+        morph.resample(1.)
+        immutable = morph.as_immutable()
+        morph.write(os.path.join(tmpdir, 'out{}.h5'.format(i)))
+        return len(immutable.points)
+
+    with ThreadPoolExecutor(8) as executor:
+        sizes = list(executor.map(work, range(32)))
+    for i, size in enumerate(sizes):
+        assert size == len(Morphology(os.path.join(tmpdir, 'out{}.h5'.format(i))).points)
+
+
+def test_concurrent_vasculature():
+    path = os.path.join(_path, 'h5/vasculature1.h5')
+    expected = Vasculature(path).points
+    with ThreadPoolExecutor(4) as executor:
+        for vasc in executor.map(Vasculature, [path] * 16):
+            assert_array_equal(vasc.points, expected)
+
+
+def test_concurrent_warnings():
+    # Warnings are raised as errors, so that the count of printed warnings is left untouched
+    path = os.path.join(_path, 'no_soma.swc')
+
+    def toggle(i):
+        set_ignored_warning(Warning.no_soma_found, i % 2 == 0)
+        try:
+            return Morphology(path)
+        except MorphioError:
+            return None
+
+    set_raise_warnings(True)
+    try:
+        with ThreadPoolExecutor(8) as executor:
+            results = list(executor.map(toggle, range(64)))
+        assert len(results) == 64
+    finally:
+        set_raise_warnings(False)
+        set_ignored_warning(Warning.no_soma_found, False)
+
+    with ThreadPoolExecutor(4) as executor:
+        with pytest.raises(RawDataError):
+            list(executor.map(Morphology, [os.path.join(_path, 'missing.swc')] * 4))
+
+
+@pytest.mark.skipif(not os.environ.get('MORPHIO_TIMING_TESTS'),
+                    reason='timing dependent: set MORPHIO_TIMING_TESTS=1 to run it')
+@pytest.mark.skipif((os.cpu_count() or 1) < 4, reason='needs at least 4 cores')
+def test_loads_scale_with_threads():
+    """Loads release the GIL: a pool of threads loads SWC files in parallel
+
+    Only run on request: the timings of shared CI machines are too noisy for a hard threshold
+    """
+    paths = [os.path.join(_path, 'nrn_ordering.swc')] * 200
+    _load_all(paths[:10], 1)  # warm up the file system cache
+
+    start = time.perf_counter()
+    _load_all(paths, 1)
+    serial = time.perf_counter() - start
+
+    start = time.perf_counter()
+    _load_all(paths, 4)
+    parallel = time.perf_counter() - start
+
+    # Linear scaling would be 4, leave room for noisy machines
+    assert serial / parallel > 2
@@ -5,7 +5,7 @@ import pytest
 from numpy.testing import assert_array_equal
 
 from morphio import (Morphology, RawDataError, SectionType, SomaError, MorphioError, SomaType,
-                     ostream_redirect, set_maximum_warnings, set_raise_warnings, set_ignored_warning, Warning)
+                     disable_parse_cache, enable_parse_cache, ostream_redirect, set_maximum_warnings, set_raise_warnings, set_ignored_warning, Warning)
 from utils import (_test_swc_exception, assert_string_equal, captured_output,
                    strip_color_codes, tmp_swc_file, ignored_warning)
 
@@ -75,6 +75,17 @@ def test_read_simple():
     assert_array_equal(simple.root_sections[1].points, [[0, 0, 0], [0, -4, 0]])
 
 
+def test_read_gzip():
+    expected = Morphology(os.path.join(_path, 'simple.swc'))
+    simple = Morphology(os.path.join(_path, 'simple.swc.gz'))
+    assert_array_equal(simple.points, expected.points)
+    assert_array_equal(simple.diameters, expected.diameters)
+    assert_array_equal(simple.section_offsets, expected.section_offsets)
+
+    with pytest.raises(RawDataError, match='unexpected end of file'):
+        Morphology(os.path.join(_path, 'truncated.swc.gz'))
+
+
 def test_set_raise_warnings():
     try:
         set_raise_warnings(True)
@@ -497,3 +508,29 @@ def test_no_soma():
             n = Morphology(tmp_file.name)
             assert ('{}:0:warning\nWarning: no soma found in file'.format(tmp_file.name) ==
                     strip_color_codes(err.getvalue().strip()))
+
+
+def test_parse_cache(tmpdir):
+    path = os.path.join(str(tmpdir), 'simple.swc')
+    with open(os.path.join(_path, 'simple.swc')) as source, open(path, 'w') as dest:
+        dest.write(source.read())
+    cache = os.path.join(str(tmpdir), 'cache')
+
+    enable_parse_cache(cache)
+    try:
+        parsed = Morphology(path)
+        assert len(os.listdir(cache)) == 1
+        cached = Morphology(path)
+        assert len(os.listdir(cache)) == 1
+        assert_array_equal(cached.points, parsed.points)
+        assert_array_equal(cached.diameters, parsed.diameters)
+        assert_array_equal(cached.section_types, parsed.section_types)
+        assert cached.soma_type == parsed.soma_type
+
+        # a modified file is parsed again
+        with open(path, 'a') as f:
+            f.write(' 10 2 -5 -8 0 2.  9\n')
+        assert len(Morphology(path).points) == len(parsed.points) + 1
+        assert len(os.listdir(cache)) == 2
+    finally:
+        disable_parse_cache()
@@ -625,3 +625,11 @@ def test_marker_with_string():
                                                      dtype=np.float32))
 def test_version():
     assert_array_equal(Morphology(DATA_DIR / 'simple.asc').version, ('asc', 1, 0))
+
+
+def test_read_gzip():
+    expected = Morphology(DATA_DIR / 'simple.asc')
+    simple = Morphology(DATA_DIR / 'simple.asc.gz')
+    assert_array_equal(simple.points, expected.points)
+    assert_array_equal(simple.diameters, expected.diameters)
+    assert_array_equal(simple.section_offsets, expected.section_offsets)
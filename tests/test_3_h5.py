@@ -1,9 +1,12 @@
 import os
+import sys
 from itertools import chain, repeat
 from pathlib import Path
 
 import requests
-from morphio import CellFamily, Morphology, RawDataError, SectionType, ostream_redirect
+from morphio import (CellFamily, IOPolicy, LoadOptions, Morphology, RawDataError, SectionType,
+                     enable_io_stats, get_io_policy, last_io_stats, ostream_redirect,
+                     set_io_policy)
 import pytest
 from numpy.testing import assert_array_equal
 
@@ -81,3 +84,46 @@ def test_single_children():
         with ostream_redirect(stdout=True, stderr=True):
             neuron = Morphology(H5V1_PATH / 'two_child_unmerged.h5')
     assert len(list(neuron.iter())) == 8
+
+
+def test_io_policy():
+    path = H5V1_PATH / 'simple.h5'
+    expected = Morphology(path)
+    try:
+        for policy in (IOPolicy.readahead, IOPolicy.slurp, IOPolicy.mmap):
+            set_io_policy(policy)
+            assert get_io_policy() == policy
+            morphology = Morphology(path)
+            assert_array_equal(morphology.points, expected.points)
+            assert_array_equal(morphology.diameters, expected.diameters)
+            assert_array_equal(morphology.section_types, expected.section_types)
+            assert LoadOptions().io_policy == policy
+    finally:
+        set_io_policy(IOPolicy.default)
+
+    for policy in (IOPolicy.readahead, IOPolicy.slurp, IOPolicy.mmap):
+        morphology = Morphology(path, load_options=LoadOptions(io_policy=policy))
+        assert_array_equal(morphology.points, expected.points)
+    assert get_io_policy() == IOPolicy.default
+
+
+@pytest.mark.skipif(not sys.platform.startswith('linux'), reason='I/O statistics need Linux')
+def test_io_stats():
+    path = H5V1_PATH / 'simple.h5'
+    enable_io_stats()
+    try:
+        set_io_policy(IOPolicy.slurp)
+        Morphology(path)
+        stats = last_io_stats()
+        assert stats.read_calls == 1
+        assert stats.bytes_read == path.stat().st_size
+        assert stats.bytes_mapped == 0
+
+        set_io_policy(IOPolicy.mmap)
+        Morphology(path)
+        stats = last_io_stats()
+        assert stats.read_calls == 0
+        assert stats.bytes_mapped == path.stat().st_size
+    finally:
+        set_io_policy(IOPolicy.default)
+        enable_io_stats(False)
@@ -1,4 +1,9 @@
+import copy
+import multiprocessing
 import os
+import pickle
+import shutil
+import sys
 from collections import OrderedDict
 
 import numpy as np
@@ -6,7 +11,9 @@ import pytest
 from numpy.testing import assert_array_almost_equal, assert_array_equal, assert_equal
 from pathlib import Path
 
+import morphio
 from morphio import SectionType, IterType, Morphology, GlialCell, CellFamily, RawDataError
+from morphio import Collection, LoadOptions, Option, Prefetcher, SharedStore, load_many
 
 _path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
 
@@ -156,3 +163,347 @@ def test_glia():
         GlialCell(Path(_path, 'simple.swc'))
     with pytest.raises(RawDataError):
         GlialCell(Path(_path, 'h5/v1/simple.h5'))
+
+
+def test_from_arrays():
+    expected = CELLS['h5']
+    parents = [-1 if section.is_root else section.parent.id for section in expected.sections]
+    morph = Morphology.from_arrays(expected.points,
+                                   expected.diameters,
+                                   [],
+                                   expected.section_offsets,
+                                   parents,
+                                   expected.section_types,
+                                   soma_points=expected.soma.points,
+                                   soma_diameters=expected.soma.diameters)
+    assert_array_equal(morph.points, expected.points)
+    assert_array_equal(morph.diameters, expected.diameters)
+    assert_array_equal(morph.section_offsets, expected.section_offsets)
+    assert_array_equal(morph.section_types, expected.section_types)
+    assert morph.connectivity == expected.connectivity
+    assert morph.soma_type == expected.soma_type
+
+    # Non contiguous and differently typed arrays are accepted
+    points = np.asfortranarray(np.array(expected.points, dtype=np.float64))
+    morph = Morphology.from_arrays(points,
+                                   expected.diameters,
+                                   [],
+                                   np.array(expected.section_offsets[:-1], dtype=np.int64),
+                                   parents,
+                                   expected.section_types)
+    assert_array_equal(morph.points, expected.points)
+
+    with pytest.raises(RawDataError):
+        Morphology.from_arrays(expected.points, expected.diameters[:-1], [],
+                               expected.section_offsets, parents, expected.section_types)
+    with pytest.raises(RawDataError):
+        Morphology.from_arrays(expected.points, expected.diameters, [],
+                               expected.section_offsets, [-1, 0, 0, 4, 3, 3],
+                               expected.section_types)
+
+
+def test_collection():
+    collection = Collection(Path(_path, 'h5', 'v1'))
+    assert 'simple' in collection
+    assert len(collection) == len(collection.names) == len(list(collection))
+    assert_array_equal(collection.load('simple').points,
+                       Morphology(os.path.join(_path, 'h5/v1/simple.h5')).points)
+    assert isinstance(collection.load('simple', mutable=True), morphio.mut.Morphology)
+    with pytest.raises(RawDataError):
+        collection.load('missing')
+
+    assert Collection(_path).path('simple') == os.path.join(_path, 'simple.swc')
+
+    container = Collection(os.path.join(_path, 'h5/merged.h5'), cache_size=10)
+    assert len(container) == 9
+    for name in container:
+        assert len(container.load(name, options=Option.no_duplicates).root_sections) > 0
+
+    archive = Collection(os.path.join(_path, 'morphologies.tar'))
+    assert 'h5/simple' in archive
+    assert archive.path('simple') == os.path.join(_path, 'morphologies.tar')
+    assert_array_equal(archive.load('simple').points,
+                       Morphology(os.path.join(_path, 'simple.swc')).points)
+    assert_array_equal(archive.load('h5/simple').points,
+                       Morphology(os.path.join(_path, 'h5/v1/simple.h5')).points)
+
+
+def test_collection_index(tmpdir):
+    index_path = str(tmpdir.join('merged.morphio-index'))
+    collection = Collection(os.path.join(_path, 'h5/merged.h5'), index_path=index_path)
+    assert not collection.has_index
+    with pytest.raises(RawDataError):
+        collection.select(lambda entry: True)
+    collection.write_index(index_path)
+
+    indexed = Collection(os.path.join(_path, 'h5/merged.h5'), index_path=index_path)
+    assert indexed.has_index
+    assert indexed.names == collection.names
+    for name in indexed:
+        morph = collection.load(name)
+        entry = indexed.entry(name)
+        assert entry.format == 'h5'
+        assert entry.n_sections == len(morph.section_types)
+        assert entry.n_points == len(morph.points)
+        assert np.all(entry.bounding_box[0] <= morph.points.min(axis=0))
+        assert np.all(morph.points.max(axis=0) <= entry.bounding_box[1])
+
+    large = indexed.select(lambda entry: entry.n_sections > 10)
+    assert large == [name for name in indexed.names if indexed.entry(name).n_sections > 10]
+
+    # Editing a file in place does not modify its directory: its entry is checked instead
+    directory = tmpdir.mkdir('directory')
+    for name in ('simple.swc', 'simple.asc'):
+        shutil.copy(os.path.join(_path, name), str(directory))
+    index_path = str(tmpdir.join('directory.morphio-index'))
+    Collection(str(directory), index_path=index_path).write_index()
+    with open(str(directory.join('simple.swc')), 'a') as f:
+        f.write('# edited\n')
+    indexed = Collection(str(directory), index_path=index_path)
+    assert indexed.has_index
+    assert indexed.entry('simple').format == 'swc'
+    with pytest.raises(RawDataError):
+        indexed.entry('simple', validate=True)
+
+
+def test_load_many():
+    paths = [Path(_path, 'h5/v1/simple.h5'), os.path.join(_path, 'simple.swc'),
+             os.path.join(_path, 'simple.asc')] * 5
+    morphs = load_many(paths, options=Option.nrn_order, n_threads=4)
+    assert len(morphs) == len(paths)
+    for path, morph in zip(paths, morphs):
+        assert_array_equal(morph.points, Morphology(path, options=Option.nrn_order).points)
+
+    assert load_many([]) == []
+    with pytest.raises(RawDataError):
+        load_many(paths + [os.path.join(_path, 'missing.swc')])
+
+
+def test_prefetcher():
+    paths = [Path(_path, 'h5/v1/simple.h5'), os.path.join(_path, 'simple.swc')] * 5
+    morphs = list(Prefetcher(paths, options=Option.nrn_order, depth=3))
+    assert len(morphs) == len(paths)
+    for path, morph in zip(paths, morphs):
+        assert_array_equal(morph.points, Morphology(path, options=Option.nrn_order).points)
+
+    with Prefetcher(paths, depth=2) as prefetcher:
+        next(prefetcher)
+        assert prefetcher.position == 1
+        prefetcher.cancel()
+        assert list(prefetcher) == []
+
+
+def test_zero_copy_views():
+    morph = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+    section = morph.section(2)
+    arrays = [morph.points, morph.diameters, morph.perimeters, morph.section_types,
+              morph.soma.points, morph.soma.diameters,
+              section.points, section.diameters, section.perimeters]
+    for array in arrays:
+        assert not array.flags.writeable
+        with pytest.raises(ValueError):
+            array[0] = 0
+
+    # Every access returns a view on the same data
+    assert np.shares_memory(morph.points, morph.points)
+    assert np.shares_memory(morph.points, section.points)
+    assert np.shares_memory(morph.diameters, section.diameters)
+    assert morph.points.shape == (len(morph.diameters), 3)
+    assert morph.section_types.dtype == np.int32
+
+    # The views keep the morphology alive
+    points, expected = morph.points, morph.points.copy()
+    start, end = morph.section_offsets[2:4]
+    section_points = section.points
+    del morph, section
+    assert_array_equal(points, expected)
+    assert_array_equal(section_points, expected[start:end])
+
+
+def test_section_tables():
+    morph = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+    sections = morph.sections
+    assert_array_equal(morph.section_parents,
+                       [-1 if s.is_root else s.parent.id for s in sections])
+    assert_array_equal(morph.section_point_counts, [len(s.points) for s in sections])
+    assert_array_almost_equal(
+        morph.section_lengths,
+        [np.linalg.norm(np.diff(s.points, axis=0), axis=1).sum() for s in sections],
+        decimal=3)
+    assert_array_equal(morph.root_section_ids, [s.id for s in morph.root_sections])
+
+    offsets, ids = morph.section_children
+    assert len(offsets) == len(sections) + 1
+    for section in sections:
+        assert_array_equal(ids[offsets[section.id]:offsets[section.id + 1]],
+                           [child.id for child in section.children])
+
+    assert_array_equal(morph.section_order(), [s.id for s in morph.iter()])
+    assert_array_equal(morph.section_order(IterType.breadth_first),
+                       [s.id for s in morph.iter(IterType.breadth_first)])
+    with pytest.raises(morphio.MorphioError):
+        morph.section_order(IterType.upstream)
+
+
+def _assert_same_morphology(morph, expected):
+    assert_array_equal(morph.points, expected.points)
+    assert_array_equal(morph.diameters, expected.diameters)
+    assert_array_equal(morph.perimeters, expected.perimeters)
+    assert_array_equal(morph.section_offsets, expected.section_offsets)
+    assert_array_equal(morph.section_types, expected.section_types)
+    assert_array_equal(morph.soma.points, expected.soma.points)
+    assert morph.soma_type == expected.soma_type
+    assert morph.version == expected.version
+    assert morph.connectivity == expected.connectivity
+    assert len(morph.mitochondria.sections) == len(expected.mitochondria.sections)
+    assert [m.label for m in morph.markers] == [m.label for m in expected.markers]
+
+
+@pytest.mark.parametrize('path', ['simple.swc', 'pia.asc', 'h5/v1/Neuron.h5',
+                                  'h5/v1/mitochondria.h5'])
+def test_from_buffer(path):
+    with open(os.path.join(_path, path), 'rb') as f:
+        content = f.read()
+    format = path.split('.')[-1]
+    for options in (Option.no_modifier, Option.nrn_order):
+        expected = Morphology(os.path.join(_path, path), options=options)
+        _assert_same_morphology(Morphology.from_buffer(content, format, options), expected)
+    _assert_same_morphology(Morphology.from_buffer(memoryview(bytearray(content)), format),
+                            Morphology(os.path.join(_path, path)))
+
+
+def test_from_buffer_errors():
+    for format in ('swc', 'h5', 'morphio'):
+        with pytest.raises(RawDataError):
+            Morphology.from_buffer(b'not a morphology', format)
+    with pytest.raises(morphio.UnknownFileType):
+        Morphology.from_buffer(b'1 1 0 0 0 1 -1', 'txt')
+
+
+@pytest.mark.parametrize('path', ['simple.swc', 'pia.asc', 'h5/v1/Neuron.h5',
+                                  'h5/v1/mitochondria.h5'])
+def test_pickle(path):
+    morph = Morphology(os.path.join(_path, path), options=Option.nrn_order)
+    for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+        _assert_same_morphology(pickle.loads(pickle.dumps(morph, protocol)), morph)
+    _assert_same_morphology(copy.deepcopy(morph), morph)
+
+    with pytest.raises(RawDataError):
+        Morphology.__new__(Morphology).__setstate__(b'not a morphology')
+
+
+@pytest.mark.skipif(sys.version_info < (3, 8), reason='pickle protocol 5 requires python 3.8')
+def test_pickle_out_of_band():
+    morph = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+    buffers = []
+    data = pickle.dumps(morph, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 1
+    assert len(data) < 200  # the arrays are not copied into the pickle
+    _assert_same_morphology(pickle.loads(data, buffers=buffers), morph)
+
+    glia = GlialCell(os.path.join(_path, 'h5/v1/glia.h5'))
+    assert pickle.loads(pickle.dumps(glia, protocol=5)).cell_family == CellFamily.GLIA
+
+
+def _load_from_store(args):
+    name, key = args
+    return len(SharedStore(name).load(key).points)
+
+
+def test_shared_store(tmpdir):
+    paths = [os.path.join(_path, name) for name in ('simple.swc', 'h5/v1/Neuron.h5')]
+    morphologies = {path: Morphology(path) for path in paths}
+    for name in ['morphio-test-{}'.format(os.getpid()), str(tmpdir.join('store.bin'))]:
+        SharedStore.remove(name)
+        SharedStore.create(name, morphologies)
+        with pytest.raises(RawDataError):
+            SharedStore.create(name, morphologies)
+
+        store = SharedStore(name)
+        assert store.keys == paths
+        assert list(store) == paths
+        assert len(store) == 2
+        assert paths[0] in store
+        for path in paths:
+            _assert_same_morphology(store.load(path), morphologies[path])
+        with pytest.raises(RawDataError):
+            store.load('missing')
+
+        with multiprocessing.Pool(2) as pool:
+            assert (pool.map(_load_from_store, [(name, path) for path in paths]) ==
+                    [len(morphologies[path].points) for path in paths])
+
+        SharedStore.remove(name)
+        with pytest.raises(RawDataError):
+            SharedStore(name)
+
+
+def test_load_options():
+    geometry_only = LoadOptions.geometry_only()
+    assert not geometry_only.perimeters and not geometry_only.line_numbers
+
+    path = Path(_path, 'h5', 'v1', 'mitochondria.h5')
+    full = Morphology(path)
+    no_mitochondria = Morphology(path, load_options=LoadOptions(mitochondria=False))
+    assert len(full.mitochondria.root_sections) > 0
+    assert len(no_mitochondria.mitochondria.root_sections) == 0
+    assert_array_equal(no_mitochondria.perimeters, full.perimeters)
+
+    path = Path(_path, 'h5', 'v1', 'glia.h5')
+    geometry = Morphology(path, load_options=geometry_only)
+    assert len(geometry.perimeters) == 0
+    assert_array_equal(geometry.points, Morphology(path).points)
+
+    path = Path(_path, 'markers.asc')
+    geometry = Morphology(path, load_options=geometry_only)
+    assert len(geometry.markers) == 0
+    assert_array_equal(geometry.points, Morphology(path).points)
+
+    morphs = load_many([path, path], load_options=geometry_only)
+    assert all(len(m.markers) == 0 for m in morphs)
+
+    path = os.path.join(_path, 'simple.swc')
+    resampled = Morphology(path, load_options=LoadOptions(resample_spacing=2.0))
+    expected = morphio.mut.Morphology(path)
+    expected.resample(spacing=2.0)
+    assert_array_equal(resampled.points, expected.as_immutable().points)
+    with pytest.raises(morphio.MorphioError):
+        Morphology(path, load_options=LoadOptions(simplify_tolerance=-1.0))
+
+
+def test_load_options_neurite_types():
+    axon_only = LoadOptions(neurite_types=[SectionType.axon])
+    assert axon_only.neurite_types == [SectionType.axon]
+    assert LoadOptions().neurite_types == []
+
+    full = Morphology(Path(_path, 'simple.swc'))
+    for path in [Path(_path, 'simple.swc'),
+                 Path(_path, 'simple.asc'),
+                 Path(_path, 'h5', 'v1', 'simple.h5')]:
+        axon = Morphology(path, load_options=axon_only)
+        assert_array_equal(axon.section_types, [SectionType.axon] * 3)
+        assert_array_equal(axon.points, np.vstack([s.points for s in full.sections[3:]]))
+        assert_array_equal(axon.section_offsets, [0, 2, 4, 6])
+        assert_array_equal(axon.soma.points, full.soma.points)
+
+        dendrites = Morphology(path, load_options=LoadOptions(
+            neurite_types=[SectionType.basal_dendrite, SectionType.apical_dendrite]))
+        assert_array_equal(dendrites.section_types, [SectionType.basal_dendrite] * 3)
+
+
+def test_load_options_lazy():
+    assert not LoadOptions().lazy
+    lazy_options = LoadOptions(lazy=True)
+    assert lazy_options.lazy
+
+    for filename in ['simple.h5', 'Neuron.h5']:
+        path = Path(_path, 'h5', 'v1', filename)
+        eager = Morphology(path)
+        lazy = Morphology(path, load_options=lazy_options)
+        assert_array_equal(lazy.section_offsets, eager.section_offsets)
+        assert_array_equal(lazy.section_types, eager.section_types)
+        for lazy_section, section in zip(lazy.iter(), eager.iter()):
+            assert_array_equal(lazy_section.points, section.points)
+            assert_array_equal(lazy_section.diameters, section.diameters)
+        assert_array_equal(lazy.points, eager.points)
+        assert_array_equal(lazy.diameters, eager.diameters)
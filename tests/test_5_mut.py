@@ -358,6 +358,60 @@ def test_non_C_nparray():
     section.points = non_standard_stride
     assert_array_equal(section.points, points)
 
+def test_writable_views():
+    m = Morphology(Path(DATA_DIR, "h5/v1/Neuron.h5"))
+    section = m.section(3)
+    points = section.points
+    diameters = section.diameters
+    assert points.flags.writeable
+    assert np.shares_memory(points, section.points)
+
+    # Writes through the views modify the section, even after a build
+    m.as_immutable()
+    points[0] = [1, 2, 3]
+    diameters *= 2
+    assert_array_equal(section.points[0], [1, 2, 3])
+    assert_array_equal(m.as_immutable().section(3).points, section.points)
+    assert_array_equal(m.as_immutable().section(3).diameters, section.diameters)
+
+    # Setting the same number of points keeps the views valid
+    section.points = np.zeros_like(points)
+    assert_array_equal(points, np.zeros_like(points))
+
+    # Changing the number of points would leave the views dangling
+    with pytest.raises(SectionBuilderError):
+        section.points = np.zeros((len(points) + 1, 3))
+    with pytest.raises(SectionBuilderError):
+        section.set_point_data(points[:1], diameters[:1])
+    assert len(section.points) == len(points)
+
+    soma_points = m.soma.points
+    soma_points += 1
+    assert_array_equal(m.soma.points, soma_points)
+    with pytest.raises(SectionBuilderError):
+        m.soma.points = np.zeros((len(soma_points) + 1, 3))
+
+    # The views keep the section alive
+    del m, section
+    assert_array_equal(points, np.zeros_like(points))
+
+
+def test_set_point_data():
+    m = Morphology(Path(DATA_DIR, "simple.swc"))
+    section = m.root_sections[0]
+    points = np.array([[1, 2, 3], [4, 5, 6], [7, 8, 9]], dtype=np.float32)
+    section.set_point_data(points, np.array([1, 2, 3], dtype=np.float32))
+    assert_array_equal(section.points, points)
+    assert_array_equal(section.diameters, [1, 2, 3])
+    assert len(section.perimeters) == 0
+
+    section.set_point_data(points[:2], [4, 5], [6, 7])
+    assert_array_equal(section.perimeters, [6, 7])
+
+    with pytest.raises(MorphioError):
+        section.set_point_data(points, [1, 2])
+
+
 def test_annotation():
     with captured_output() as (_, err):
         with ostream_redirect(stdout=True, stderr=True):
@@ -614,3 +668,89 @@ def test_lifetime_iteration_fails_with_orphan_section():
     for iter_type in IterType.depth_first, IterType.breadth_first, IterType.upstream:
         with pytest.raises(RuntimeError):
             section.iter(iter_type)
+
+
+def test_resample():
+    m = Morphology()
+    axon = m.append_root_section(PointLevel([[0, 0, 0], [1, 0, 0], [10, 0, 0]], [2, 2, 20]),
+                                 SectionType.axon)
+    dendrite = m.append_root_section(PointLevel([[0, 0, 0], [0, 1, 0], [0, 2, 0]], [2, 2, 2]),
+                                     SectionType.basal_dendrite)
+
+    m.resample({SectionType.axon: 4})
+    np.testing.assert_allclose(axon.points,
+                               [[0, 0, 0], [10 / 3, 0, 0], [20 / 3, 0, 0], [10, 0, 0]],
+                               rtol=1e-5)
+    np.testing.assert_allclose(axon.diameters, [2, 20 / 3, 40 / 3, 20], rtol=1e-5)
+    assert len(dendrite.points) == 3
+
+    m.resample(0.5)
+    assert len(dendrite.points) == 5
+
+    with pytest.raises(MorphioError):
+        m.resample(0)
+    with pytest.raises(MorphioError):
+        m.resample({SectionType.axon: 1, SectionType.basal_dendrite: float('nan')})
+    assert len(dendrite.points) == 5
+
+
+def test_simplify():
+    m = Morphology()
+    section = m.append_root_section(PointLevel([[0, 0, 0], [1, 0.01, 0], [2, 0, 0],
+                                                [3, 1, 0], [4, 0, 0]],
+                                               [2, 2, 2, 2, 2]),
+                                    SectionType.basal_dendrite)
+    child = section.append_section(PointLevel([[4, 0, 0], [5, 0, 0], [6, 0, 0]], [2, 4, 2]))
+
+    m.simplify({SectionType.axon: 0.1})
+    assert len(section.points) == 5
+
+    m.simplify(0.1)
+    assert_array_equal(section.points, [[0, 0, 0], [2, 0, 0], [3, 1, 0], [4, 0, 0]])
+    # a straight section whose diameter changes is kept
+    assert len(child.points) == 3
+
+    with pytest.raises(MorphioError):
+        m.simplify(-1)
+
+
+def test_from_arrays():
+    points = np.array([[0, 0, 0], [1, 0, 0], [1, 0, 0], [2, 1, 0], [1, 0, 0], [2, -1, 0]])
+    morph = Morphology.from_arrays(points, [2, 2, 2, 1, 2, 1], [], [0, 2, 4], [-1, 0, 0],
+                                   [SectionType.dendrite, SectionType.dendrite, SectionType.axon])
+    assert len(morph.root_sections) == 1
+    assert [child.id for child in morph.section(0).children] == [1, 2]
+    assert morph.section(2).type == SectionType.axon
+    assert_array_equal(morph.section(2).points, [[1, 0, 0], [2, -1, 0]])
+
+    with pytest.raises(MorphioError, match='Wrong array shape'):
+        Morphology.from_arrays(points[:, :2], [2, 2, 2, 1, 2, 1], [], [0, 2, 4], [-1, 0, 0],
+                               [SectionType.dendrite, SectionType.dendrite, SectionType.axon])
+
+
+def test_checkout_neurite():
+    morph = Morphology(DATA_DIR / 'simple.swc')
+    dendrite = morph.checkout_neurite(0)
+    axon = morph.checkout_neurite(3)
+    assert sorted(dendrite.sections) == [0, 1, 2]
+    assert sorted(axon.sections) == [3, 4, 5]
+
+    with pytest.raises(SectionBuilderError):
+        morph.checkout_neurite(1)
+
+    new_section = dendrite.section(1).append_section(PointLevel([[-5, 5, 0], [-6, 6, 0]], [1, 1]))
+    assert new_section.id == 6
+    axon.delete_section(axon.section(5))
+
+    with pytest.raises(SectionBuilderError):
+        morph.merge_neurite(3, dendrite)
+    with pytest.raises(SectionBuilderError):
+        Morphology(DATA_DIR / 'simple.swc').merge_neurite(0, dendrite)
+
+    morph.merge_neurite(0, dendrite)
+    morph.merge_neurite(3, axon)
+    assert not dendrite.sections
+    assert sorted(morph.sections) == [0, 1, 2, 3, 4, 6]
+    assert morph.section(6).parent.id == 1
+    assert [root.id for root in morph.root_sections] == [0, 3]
+
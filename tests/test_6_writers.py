@@ -4,7 +4,8 @@ from pathlib import Path
 import numpy as np
 from morphio import MitochondriaPointLevel
 from morphio import Morphology as ImmutMorphology
-from morphio import PointLevel, SectionBuilderError, SectionType, WriterError, ostream_redirect
+from morphio import (Option, PointLevel, SectionBuilderError, SectionType, WriterError,
+                     ostream_redirect)
 from morphio.mut import Morphology
 import pytest
 from numpy.testing import assert_array_equal
@@ -310,3 +311,25 @@ def test_single_point_root_section():
     with setup_tempdir('test_single_point_root_section') as tmp_folder:
         with pytest.raises(SectionBuilderError):
             m.write(Path(tmp_folder, "h5/empty_vasculature.h5"))
+
+
+@pytest.mark.parametrize('path', ['h5/v1/Neuron.h5', 'h5/v1/mitochondria.h5', 'simple.swc',
+                                  'simple.asc'])
+def test_write_binary(path):
+    data = Path(__file__).parent / 'data'
+    morph = Morphology(data / path)
+    with setup_tempdir('test_write_binary') as tmp_folder:
+        morph.write(Path(tmp_folder, 'morph.morphio'))
+        morph.write(Path(tmp_folder, 'morph.h5'))
+        for options in [Option.no_modifier, Option.nrn_order | Option.soma_sphere]:
+            binary = ImmutMorphology(Path(tmp_folder, 'morph.morphio'), options)
+            h5 = ImmutMorphology(Path(tmp_folder, 'morph.h5'), options)
+            assert_array_equal(binary.points, h5.points)
+            assert_array_equal(binary.diameters, h5.diameters)
+            assert_array_equal(binary.section_offsets, h5.section_offsets)
+            assert_array_equal(binary.section_types, h5.section_types)
+            assert_array_equal(binary.soma.points, h5.soma.points)
+            assert len(binary.mitochondria.sections) == len(h5.mitochondria.sections)
+            assert binary.version[0] == 'morphio'
+        assert (Morphology(Path(tmp_folder, 'morph.morphio')).soma_type ==
+                ImmutMorphology(data / path).soma_type)
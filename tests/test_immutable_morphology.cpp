@@ -1,15 +1,28 @@
 #include "contrib/catch.hpp"
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
 
+#include <unistd.h>  // getpid
+
+#include <morphio/collection.h>
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/glial_cell.h>
+#include <morphio/io_policy.h>
+#include <morphio/loading.h>
 #include <morphio/mito_section.h>
 #include <morphio/mitochondria.h>
+#include <morphio/modifiers.h>
 #include <morphio/morphology.h>
 #include <morphio/mut/morphology.h>
+#include <morphio/parse_cache.h>
 #include <morphio/properties.h>
 #include <morphio/section.h>
+#include <morphio/shared_store.h>
 #include <morphio/soma.h>
+#include <morphio/stream.h>
 
 
 namespace {
@@ -122,6 +135,110 @@ TEST_CASE("modifers", "[immutableMorphology]") {
                                   });
 }
 
+TEST_CASE("flatModifiers", "[immutableMorphology]") {
+    // H5 modifiers are applied on the flat arrays, they must match the mut::Morphology ones
+    const std::vector<unsigned int> allOptions{
+        morphio::Option::NO_MODIFIER,
+        morphio::Option::TWO_POINTS_SECTIONS,
+        morphio::Option::SOMA_SPHERE,
+        morphio::Option::NO_DUPLICATES,
+        morphio::Option::NRN_ORDER,
+        morphio::Option::SOMA_SPHERE | morphio::Option::NO_DUPLICATES | morphio::Option::NRN_ORDER};
+    for (unsigned int options : allOptions) {
+        for (const char* filename : {"data/h5/v1/Neuron.h5", "data/h5/v1/mitochondria.h5"}) {
+            morphio::Morphology morph(filename, options);
+
+            morphio::mut::Morphology mutMorph(filename);
+            mutMorph.applyModifiers(options);
+            morphio::Morphology expected(mutMorph);
+
+            REQUIRE(morph.points() == expected.points());
+            REQUIRE(morph.diameters() == expected.diameters());
+            REQUIRE(morph.perimeters() == expected.perimeters());
+            REQUIRE(morph.sectionOffsets() == expected.sectionOffsets());
+            REQUIRE(morph.sectionTypes() == expected.sectionTypes());
+            REQUIRE(morph.connectivity() == expected.connectivity());
+            const auto somaPoints = morph.soma().points();
+            const auto expectedSomaPoints = expected.soma().points();
+            REQUIRE(std::equal(somaPoints.begin(),
+                               somaPoints.end(),
+                               expectedSomaPoints.begin(),
+                               expectedSomaPoints.end()));
+            const auto somaDiameters = morph.soma().diameters();
+            const auto expectedSomaDiameters = expected.soma().diameters();
+            REQUIRE(std::equal(somaDiameters.begin(),
+                               somaDiameters.end(),
+                               expectedSomaDiameters.begin(),
+                               expectedSomaDiameters.end()));
+            REQUIRE(morph.somaType() == expected.somaType());
+            REQUIRE(morph.mitochondria().rootSections().size() ==
+                    expected.mitochondria().rootSections().size());
+        }
+    }
+}
+
+
+TEST_CASE("fromArrays", "[immutableMorphology]") {
+    const morphio::Morphology expected("data/h5/v1/simple.h5");
+    const auto points = expected.points();
+    const auto diameters = expected.diameters();
+    const auto somaPoints = expected.soma().points();
+    const auto somaDiameters = expected.soma().diameters();
+
+    std::vector<int32_t> parents;
+    for (const auto& section : expected.sections()) {
+        parents.push_back(section.isRoot() ? -1 : static_cast<int32_t>(section.parent().id()));
+    }
+    const morphio::Points pointsVector(points.begin(), points.end());
+    const std::vector<morphio::floatType> diametersVector(diameters.begin(), diameters.end());
+
+    const auto fromArrays = [&](std::vector<uint32_t> offsets,
+                                std::vector<int32_t> sectionParents,
+                                std::vector<morphio::SectionType> types) {
+        return morphio::Morphology::fromArrays(
+            pointsVector,
+            diametersVector,
+            {},
+            std::move(offsets),
+            std::move(sectionParents),
+            std::move(types),
+            morphio::Points(somaPoints.begin(), somaPoints.end()),
+            std::vector<morphio::floatType>(somaDiameters.begin(), somaDiameters.end()));
+    };
+
+    const auto& offsets = expected.sectionOffsets();
+    const auto& types = expected.sectionTypes();
+
+    // with and without the trailing offset
+    std::vector<morphio::Morphology> morphs;
+    morphs.push_back(fromArrays(offsets, parents, types));
+    morphs.push_back(fromArrays({offsets.begin(), offsets.end() - 1}, parents, types));
+    for (const auto& morph : morphs) {
+        REQUIRE(morph.sectionOffsets() == offsets);
+        REQUIRE(morph.sectionTypes() == types);
+        REQUIRE(morph.connectivity() == expected.connectivity());
+        REQUIRE(morph.somaType() == expected.somaType());
+        REQUIRE(morph.points().size() == points.size());
+        REQUIRE(std::equal(points.begin(), points.end(), morph.points().begin()));
+        REQUIRE(morph.section(4).points().size() == expected.section(4).points().size());
+    }
+
+    REQUIRE_THROWS_AS(fromArrays({offsets.begin(), offsets.end() - 2}, parents, types),
+                      morphio::RawDataError);
+    REQUIRE_THROWS_AS(fromArrays({0, 4, 2, 6, 8, 10}, parents, types), morphio::RawDataError);
+
+    auto badParents = parents;
+    badParents[1] = 3;
+    REQUIRE_THROWS_AS(fromArrays(offsets, badParents, types), morphio::RawDataError);
+
+    auto badTypes = types;
+    badTypes[0] = morphio::SECTION_SOMA;
+    REQUIRE_THROWS_AS(fromArrays(offsets, parents, badTypes), morphio::RawDataError);
+
+    REQUIRE_THROWS_AS(morphio::Morphology::fromArrays(
+                          pointsVector, {1, 2}, {}, offsets, parents, types),
+                      morphio::RawDataError);
+}
 
 TEST_CASE("distance", "[immutableMorphology]") {
     Files files;
@@ -339,3 +456,1020 @@ TEST_CASE("annotations", "[immutableMorphology]") {
     REQUIRE(annotation._sectionId == 1);
     REQUIRE(annotation._type == morphio::SINGLE_CHILD);
 }
+
+TEST_CASE("collectionDirectory", "[immutableMorphology]") {
+    const morphio::Collection collection("data/h5/v1");
+    REQUIRE(collection.size() == collection.names().size());
+    REQUIRE(collection.contains("simple"));
+    REQUIRE(!collection.contains("simple.h5"));
+    REQUIRE(collection.path("simple") == "data/h5/v1/simple.h5");
+
+    const auto names = collection.names();
+    REQUIRE(std::find(names.begin(), names.end(), "Neuron") != names.end());
+
+    // Loading twice goes through the pool of open files
+    for (int i = 0; i < 2; ++i) {
+        const morphio::Morphology morph = collection.load("simple");
+        const morphio::Morphology expected("data/h5/v1/simple.h5");
+        REQUIRE(morph.sectionOffsets() == expected.sectionOffsets());
+        REQUIRE(std::equal(morph.points().begin(),
+                           morph.points().end(),
+                           expected.points().begin()));
+    }
+    REQUIRE_THROWS_AS(collection.load("missing"), morphio::RawDataError);
+
+    // The first extension wins when a name exists in several formats
+    REQUIRE(morphio::Collection("data").path("simple") == "data/simple.swc");
+    REQUIRE(morphio::Collection("data", 0, 64, {".asc", ".swc"}).path("simple") ==
+            "data/simple.asc");
+    REQUIRE(morphio::Collection("data").load("simple").sectionOffsets() ==
+            morphio::Morphology("data/simple.swc").sectionOffsets());
+
+    REQUIRE_THROWS_AS(morphio::Collection("data/missing"), morphio::RawDataError);
+}
+
+TEST_CASE("collectionContainer", "[immutableMorphology]") {
+    const std::string name = "00/00/00000009b4fa102d58b173a995525c3e";
+    const morphio::Collection collection("data/h5/merged.h5");
+    REQUIRE(collection.size() == 9);
+    REQUIRE(collection.contains(name));
+    REQUIRE(collection.contains("/" + name));
+    REQUIRE(collection.path(name) == "data/h5/merged.h5");
+    REQUIRE(collection.load(name).rootSections().size() == 8);
+
+    for (const auto& morphName : collection.names()) {
+        REQUIRE_NOTHROW(collection.load(morphName, morphio::NO_DUPLICATES));
+    }
+
+    // Cached morphologies share their data
+    const morphio::Collection cached("data/h5/merged.h5", 2);
+    const auto first = cached.load(name);
+    REQUIRE(cached.load(name).points().data() == first.points().data());
+    REQUIRE(cached.load(name, morphio::SOMA_SPHERE).points().data() != first.points().data());
+    REQUIRE(collection.load(name).points().data() != collection.load(name).points().data());
+
+    REQUIRE_THROWS_AS(morphio::Collection("data/h5/non-valid.h5"), morphio::RawDataError);
+}
+
+TEST_CASE("collectionArchive", "[immutableMorphology]") {
+    const std::string longName =
+        "neurons/a-file-name-longer-than-the-one-hundred-characters-of-a-ustar-header-which-"
+        "needs-a-pax-header";
+    const morphio::Collection collection("data/morphologies.tar");
+    REQUIRE(collection.names() ==
+            std::vector<std::string>{"simple",
+                                     "h5/simple",
+                                     "a-directory-with-a-long-name/a-directory-with-a-long-name/"
+                                     "a-directory-with-a-long-name/a-directory-with-a-long-name/"
+                                     "simple",
+                                     longName});
+    REQUIRE(!collection.contains("notes"));
+    REQUIRE(collection.path("simple") == "data/morphologies.tar");
+
+    const morphio::Morphology swc("data/simple.swc");
+    REQUIRE(collection.load("simple").points() == swc.points());
+    REQUIRE(collection.load(longName).points() == swc.points());
+    REQUIRE(collection.load("h5/simple").points() ==
+            morphio::Morphology("data/h5/v1/simple.h5").points());
+    REQUIRE(collection.load("simple", morphio::NRN_ORDER).sectionTypes() ==
+            morphio::Morphology("data/simple.swc", morphio::NRN_ORDER).sectionTypes());
+    REQUIRE_THROWS_AS(collection.load("missing"), morphio::RawDataError);
+
+    REQUIRE(morphio::Collection("data/morphologies.tar", 0, 64, {".asc"}).path("simple") ==
+            "data/morphologies.tar");
+    REQUIRE(morphio::Collection("data/morphologies.tar", 0, 64, {".asc"}).size() == 1);
+
+    {  // Truncated archive
+        const std::string truncated = std::filesystem::temp_directory_path() /
+                                      ("truncated-" + std::to_string(getpid()) + ".tar");
+        std::ifstream file("data/morphologies.tar", std::ios::binary);
+        std::vector<char> content(2048);
+        file.read(content.data(), static_cast<std::streamsize>(content.size()));
+        std::ofstream(truncated, std::ios::binary).write(content.data(), 2048);
+        REQUIRE_THROWS_AS(morphio::Collection(truncated), morphio::RawDataError);
+        std::filesystem::remove(truncated);
+    }
+
+    {  // Base-256 sizes that do not fit in the archive, or in 64 bits
+        const std::string forged = std::filesystem::temp_directory_path() /
+                                   ("forged-" + std::to_string(getpid()) + ".tar");
+        const auto writeArchive = [&forged](const std::vector<unsigned char>& size) {
+            std::vector<char> content(2048, '\0');
+            std::copy_n("simple.swc", 10, content.begin());
+            std::copy(size.begin(), size.end(), content.begin() + 124);
+            content[156] = '0';
+            std::fill_n(content.begin() + 148, 8, ' ');
+            unsigned int checksum = 0;
+            for (size_t i = 0; i < 512; ++i) {
+                checksum += static_cast<unsigned char>(content[i]);
+            }
+            std::snprintf(content.data() + 148, 8, "%06o", checksum);
+            std::ofstream(forged, std::ios::binary)
+                .write(content.data(), static_cast<std::streamsize>(content.size()));
+        };
+
+        // 2^64 - 1: the end of the member wraps around
+        writeArchive({0x80, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff});
+        REQUIRE_THROWS_AS(morphio::Collection(forged), morphio::RawDataError);
+        // 9 significant bytes
+        writeArchive({0x80, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0});
+        REQUIRE_THROWS_AS(morphio::Collection(forged), morphio::RawDataError);
+        std::filesystem::remove(forged);
+    }
+}
+
+TEST_CASE("collectionIndex", "[immutableMorphology]") {
+    const auto temp = std::filesystem::temp_directory_path();
+    const std::string pid = std::to_string(getpid());
+    const std::string indexPath = temp / ("collection-" + pid + ".morphio-index");
+    const std::string directory = temp / ("collection-" + pid);
+    std::filesystem::create_directory(directory);
+    for (const auto& file : {"simple.swc", "simple.asc", "h5/v1/Neuron.h5", "h5/v1/glia.h5"}) {
+        const std::filesystem::path path(file);
+        std::filesystem::copy_file("data" / path, directory / path.filename());
+    }
+
+    for (const std::string& collectionPath :
+         {directory, std::string("data/h5/merged.h5"), std::string("data/morphologies.tar")}) {
+        morphio::Collection listed(collectionPath, 0, 64, {".h5", ".swc", ".asc"}, indexPath);
+        REQUIRE(!listed.hasIndex());
+        REQUIRE_THROWS_AS(listed.select([](const morphio::CollectionEntry&) { return true; }),
+                          morphio::RawDataError);
+        listed.writeIndex(indexPath);
+        REQUIRE(listed.hasIndex());
+
+        const morphio::Collection indexed(collectionPath, 0, 64, {".h5", ".swc", ".asc"},
+                                          indexPath);
+        REQUIRE(indexed.hasIndex());
+        REQUIRE(indexed.names() == listed.names());
+        for (const auto& name : indexed.names()) {
+            const morphio::Morphology morph = listed.load(name);
+            const morphio::CollectionEntry& entry = indexed.entry(name);
+            REQUIRE(entry.name == name);
+            REQUIRE(indexed.path(name) == listed.path(name));
+            REQUIRE(entry.nSections == morph.sectionTypes().size());
+            REQUIRE(entry.nPoints == morph.points().size());
+            const bool inside = std::all_of(morph.points().begin(),
+                                            morph.points().end(),
+                                            [&entry](const morphio::Point& point) {
+                                                for (size_t i = 0; i < 3; ++i) {
+                                                    if (point[i] < entry.boundingBoxMin[i] ||
+                                                        point[i] > entry.boundingBoxMax[i])
+                                                        return false;
+                                                }
+                                                return true;
+                                            });
+            REQUIRE(inside);
+            REQUIRE(indexed.load(name).points() == morph.points());
+        }
+
+        const auto large = indexed.select(
+            [](const morphio::CollectionEntry& entry) { return entry.nSections > 5; });
+        for (const auto& name : indexed.names()) {
+            const bool selected = std::find(large.begin(), large.end(), name) != large.end();
+            REQUIRE(selected == (indexed.entry(name).nSections > 5));
+        }
+        REQUIRE_THROWS_AS(indexed.entry("missing"), morphio::RawDataError);
+
+        // Opened with other extensions, the index is stale
+        REQUIRE(!morphio::Collection(collectionPath, 0, 64, {".swc"}, indexPath).hasIndex());
+    }
+
+    {  // Editing a file in place does not modify its directory: its entry is checked instead
+        morphio::Collection listed(directory, 0, 64, {".h5", ".swc", ".asc"}, indexPath);
+        listed.writeIndex();
+        std::ofstream(directory + "/simple.swc", std::ios::app) << "# edited\n";
+        const morphio::Collection indexed(directory, 0, 64, {".h5", ".swc", ".asc"}, indexPath);
+        REQUIRE(indexed.hasIndex());
+        // Only checked on request
+        REQUIRE(indexed.entry("simple").format == "swc");
+        REQUIRE(indexed.select([](const morphio::CollectionEntry&) { return true; }).size() == 3);
+        REQUIRE_THROWS_AS(indexed.entry("simple", true), morphio::RawDataError);
+        REQUIRE(indexed.entry("Neuron", true).format == "h5");
+        REQUIRE_THROWS_AS(
+            indexed.select([](const morphio::CollectionEntry&) { return true; }, true),
+            morphio::RawDataError);
+        REQUIRE(indexed.select([](const morphio::CollectionEntry& entry) {
+                    return entry.format == "h5";
+                }, true).size() == 2);
+    }
+
+    {  // The index of an archive replaces the read of its headers
+        morphio::Collection archive("data/morphologies.tar", 0, 64, {".swc"}, indexPath);
+        archive.writeIndex();
+        const morphio::Collection indexed("data/morphologies.tar", 0, 64, {".swc"}, indexPath);
+        REQUIRE(indexed.hasIndex());
+        REQUIRE(indexed.entry("simple").format == "swc");
+        REQUIRE(indexed.load("simple").points() ==
+                morphio::Morphology("data/simple.swc").points());
+    }
+
+    {  // An archive rewritten with the same size and modification time
+        const std::string archivePath = temp / ("collection-" + pid + ".tar");
+        const std::string archiveIndex = archivePath + ".morphio-index";
+        std::filesystem::copy_file("data/morphologies.tar", archivePath);
+        morphio::Collection(archivePath, 0, 64, {".swc"}).writeIndex();
+        const auto modificationTime = std::filesystem::last_write_time(archivePath);
+        const uint64_t offset =
+            morphio::Collection(archivePath, 0, 64, {".swc"}).entry("simple").offset;
+        {
+            std::fstream archive(archivePath, std::ios::in | std::ios::out | std::ios::binary);
+            archive.seekp(static_cast<std::streamoff>(offset - 512));
+            archive.put('x');
+        }
+        std::filesystem::last_write_time(archivePath, modificationTime);
+
+        const morphio::Collection indexed(archivePath, 0, 64, {".swc"});
+        REQUIRE(indexed.hasIndex());
+        REQUIRE_THROWS_AS(indexed.load("simple"), morphio::RawDataError);
+        std::filesystem::remove(archivePath);
+        std::filesystem::remove(archiveIndex);
+    }
+
+    std::ofstream(indexPath, std::ios::app) << "truncated\tline\n";
+    REQUIRE_THROWS_AS(morphio::Collection("data/morphologies.tar", 0, 64, {".swc"}, indexPath),
+                      morphio::RawDataError);
+    std::filesystem::remove(indexPath);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("loadMany", "[immutableMorphology]") {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 10; ++i) {
+        paths.emplace_back("data/h5/v1/simple.h5");
+        paths.emplace_back("data/simple.swc");
+        paths.emplace_back("data/h5/v1/Neuron.h5");
+    }
+
+    for (unsigned int nThreads : {0u, 1u, 4u}) {
+        const auto morphologies = morphio::loadMany(paths, morphio::NO_DUPLICATES, nThreads);
+        REQUIRE(morphologies.size() == paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            const morphio::Morphology expected(paths[i], morphio::NO_DUPLICATES);
+            REQUIRE(morphologies[i].sectionOffsets() == expected.sectionOffsets());
+            REQUIRE(std::equal(morphologies[i].points().begin(),
+                               morphologies[i].points().end(),
+                               expected.points().begin()));
+        }
+    }
+
+    std::vector<size_t> sizes(paths.size());
+    morphio::loadMany(paths, morphio::NO_MODIFIER, 4, [&sizes](size_t i, morphio::Morphology&& m) {
+        sizes[i] = m.points().size();
+    });
+    REQUIRE(sizes[0] == morphio::Morphology("data/h5/v1/simple.h5").points().size());
+    REQUIRE(sizes[2] == morphio::Morphology("data/h5/v1/Neuron.h5").points().size());
+
+    REQUIRE(morphio::loadMany({}).empty());
+
+    // All the other morphologies are still loaded, then the first error is rethrown
+    paths.emplace(paths.begin() + 5, "data/missing.swc");
+    size_t loaded = 0;
+    std::mutex mutex;
+    REQUIRE_THROWS_AS(morphio::loadMany(paths,
+                                        morphio::NO_MODIFIER,
+                                        4,
+                                        [&](size_t, morphio::Morphology&&) {
+                                            std::lock_guard<std::mutex> lock(mutex);
+                                            ++loaded;
+                                        }),
+                      morphio::RawDataError);
+    REQUIRE(loaded == paths.size() - 1);
+}
+
+TEST_CASE("loadAsync", "[immutableMorphology]") {
+    auto future = morphio::loadAsync("data/h5/v1/Neuron.h5", morphio::NO_DUPLICATES);
+    REQUIRE(future.get().sectionOffsets() ==
+            morphio::Morphology("data/h5/v1/Neuron.h5", morphio::NO_DUPLICATES).sectionOffsets());
+    REQUIRE_THROWS_AS(morphio::loadAsync("data/missing.swc").get(), morphio::RawDataError);
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 5; ++i) {
+        paths.emplace_back("data/h5/v1/simple.h5");
+        paths.emplace_back("data/simple.swc");
+        paths.emplace_back("data/h5/v1/Neuron.h5");
+    }
+    paths.emplace(paths.begin() + 4, "data/missing.swc");
+
+    {
+        morphio::Prefetcher prefetcher(paths, morphio::NO_MODIFIER, 3);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            REQUIRE(prefetcher.hasNext());
+            REQUIRE(prefetcher.position() == i);
+            if (i == 4) {
+                // An error is raised for its own path only
+                REQUIRE_THROWS_AS(prefetcher.next(), morphio::RawDataError);
+                continue;
+            }
+            REQUIRE(prefetcher.next().points().size() ==
+                    morphio::Morphology(paths[i]).points().size());
+        }
+        REQUIRE(!prefetcher.hasNext());
+        REQUIRE_THROWS_AS(prefetcher.next(), morphio::MorphioError);
+    }
+
+    {
+        morphio::Prefetcher prefetcher(paths, morphio::NO_MODIFIER, 2);
+        prefetcher.next();
+        prefetcher.cancel();
+        REQUIRE(!prefetcher.hasNext());
+        REQUIRE_THROWS_AS(prefetcher.next(), morphio::MorphioError);
+    }
+
+    // Destroyed while loads are running
+    { morphio::Prefetcher prefetcher(paths); }
+}
+
+TEST_CASE("sectionTables", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/h5/v1/Neuron.h5");
+    const auto sections = morph.sections();
+
+    const auto parents = morph.sectionParents();
+    const auto counts = morph.sectionPointCounts();
+    const auto lengths = morph.sectionLengths();
+    REQUIRE(parents.size() == sections.size());
+    for (const auto& section : sections) {
+        const auto parent = section.isRoot() ? -1 : static_cast<int32_t>(section.parent().id());
+        REQUIRE(parents[section.id()] == parent);
+        REQUIRE(counts[section.id()] == section.points().size());
+        morphio::floatType length = 0;
+        for (size_t i = 1; i < section.points().size(); ++i) {
+            length += morphio::distance(section.points()[i - 1], section.points()[i]);
+        }
+        REQUIRE(std::abs(lengths[section.id()] - length) < 1e-4);
+    }
+
+    const auto roots = morph.rootSectionIds();
+    REQUIRE(roots.size() == morph.rootSections().size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        REQUIRE(roots[i] == morph.rootSections()[i].id());
+    }
+
+    const auto children = morph.sectionChildren();
+    REQUIRE(children.first.size() == sections.size() + 1);
+    for (const auto& section : sections) {
+        std::vector<uint32_t> expected;
+        for (const auto& child : section.children()) {
+            expected.push_back(child.id());
+        }
+        const auto first = children.second.begin() + children.first[section.id()];
+        const auto last = children.second.begin() + children.first[section.id() + 1];
+        REQUIRE(std::vector<uint32_t>(first, last) == expected);
+    }
+
+    std::vector<uint32_t> depthFirst;
+    for (auto it = morph.depth_begin(); it != morph.depth_end(); ++it) {
+        depthFirst.push_back((*it).id());
+    }
+    REQUIRE(morph.sectionIdsDepthFirst() == depthFirst);
+
+    std::vector<uint32_t> breadthFirst;
+    for (auto it = morph.breadth_begin(); it != morph.breadth_end(); ++it) {
+        breadthFirst.push_back((*it).id());
+    }
+    REQUIRE(morph.sectionIdsBreadthFirst() == breadthFirst);
+}
+
+TEST_CASE("fromBuffer", "[immutableMorphology]") {
+    const auto readFile = [](const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+    };
+
+    for (const auto& path : {"data/simple.swc", "data/simple.asc", "data/h5/v1/Neuron.h5"}) {
+        const std::string filePath(path);
+        const std::string format = filePath.substr(filePath.find_last_of('.') + 1);
+        const std::vector<char> content = readFile(filePath);
+        for (const unsigned int options : {morphio::NO_MODIFIER, morphio::TWO_POINTS_SECTIONS}) {
+            const morphio::Morphology expected(filePath, options);
+            const auto morph = morphio::Morphology::fromBuffer(content.data(),
+                                                                content.size(),
+                                                                format,
+                                                                options);
+            REQUIRE(morph.points() == expected.points());
+            REQUIRE(morph.diameters() == expected.diameters());
+            REQUIRE(morph.sectionTypes() == expected.sectionTypes());
+            REQUIRE(morph.connectivity() == expected.connectivity());
+            REQUIRE(morph.soma().points().size() == expected.soma().points().size());
+            REQUIRE(morph.somaType() == expected.somaType());
+            REQUIRE(morph.version() == expected.version());
+        }
+    }
+
+    {
+        const morphio::Morphology expected("data/simple.swc");
+        const std::vector<char> content = expected.serialize();
+        REQUIRE(morphio::Morphology::fromBuffer(content.data(), content.size(), "MORPHIO")
+                    .points() == expected.points());
+    }
+
+    const std::string invalid = "1 1 0 0 0 1 -1\n2 3 0 0\n";
+    CHECK_THROWS_AS(morphio::Morphology::fromBuffer(invalid.data(), invalid.size(), "swc"),
+                    morphio::RawDataError);
+    CHECK_THROWS_AS(morphio::Morphology::fromBuffer(invalid.data(), invalid.size(), "h5"),
+                    morphio::RawDataError);
+    CHECK_THROWS_AS(morphio::Morphology::fromBuffer(invalid.data(), invalid.size(), "morphio"),
+                    morphio::RawDataError);
+    CHECK_THROWS_AS(morphio::Morphology::fromBuffer(invalid.data(), invalid.size(), "txt"),
+                    morphio::UnknownFileType);
+}
+
+TEST_CASE("serialize", "[immutableMorphology]") {
+    const auto toVector = [](auto span) {
+        return std::vector<std::decay_t<decltype(span[0])>>(span.begin(), span.end());
+    };
+    const auto requireSame = [&toVector](const morphio::Morphology& a, const morphio::Morphology& b) {
+        REQUIRE(a.points() == b.points());
+        REQUIRE(a.diameters() == b.diameters());
+        REQUIRE(a.perimeters() == b.perimeters());
+        REQUIRE(a.sectionOffsets() == b.sectionOffsets());
+        REQUIRE(a.sectionTypes() == b.sectionTypes());
+        REQUIRE(a.connectivity() == b.connectivity());
+        REQUIRE(toVector(a.soma().points()) == toVector(b.soma().points()));
+        REQUIRE(toVector(a.soma().diameters()) == toVector(b.soma().diameters()));
+        REQUIRE(a.somaType() == b.somaType());
+        REQUIRE(a.cellFamily() == b.cellFamily());
+        REQUIRE(a.version() == b.version());
+        REQUIRE(a.mitochondria().rootSections().size() == b.mitochondria().rootSections().size());
+        REQUIRE(a.endoplasmicReticulum().sectionIndices() ==
+                b.endoplasmicReticulum().sectionIndices());
+        REQUIRE(a.markers().size() == b.markers().size());
+        for (size_t i = 0; i < a.markers().size(); ++i) {
+            REQUIRE(a.markers()[i]._label == b.markers()[i]._label);
+            REQUIRE(a.markers()[i]._sectionId == b.markers()[i]._sectionId);
+            REQUIRE(a.markers()[i]._pointLevel._points == b.markers()[i]._pointLevel._points);
+        }
+        REQUIRE(a.annotations().size() == b.annotations().size());
+        for (size_t i = 0; i < a.annotations().size(); ++i) {
+            REQUIRE(a.annotations()[i]._type == b.annotations()[i]._type);
+            REQUIRE(a.annotations()[i]._sectionId == b.annotations()[i]._sectionId);
+            REQUIRE(a.annotations()[i]._details == b.annotations()[i]._details);
+            REQUIRE(a.annotations()[i]._lineNumber == b.annotations()[i]._lineNumber);
+        }
+    };
+
+    for (const std::string path : {"data/simple.swc",
+                                   "data/h5/v1/Neuron.h5",
+                                   "data/h5/v1/mitochondria.h5",
+                                   "data/h5/v1/endoplasmic-reticulum.h5",
+                                   "data/pia.asc"}) {
+        const morphio::Morphology morph(path);
+        const auto buffer = morph.serialize();
+        requireSame(morphio::Morphology::deserialize(buffer.data(), buffer.size()), morph);
+    }
+
+    morphio::mut::Morphology mutMorph("data/simple.swc");
+    mutMorph.addAnnotation(morphio::Property::Annotation(morphio::SINGLE_CHILD,
+                                                         1,
+                                                         morphio::Property::PointLevel(),
+                                                         "details",
+                                                         12));
+    morphio::Property::Marker marker;
+    marker._label = "pia";
+    marker._sectionId = -1;
+    marker._pointLevel = morphio::Property::PointLevel({{1, 2, 3}}, {4});
+    mutMorph.addMarker(marker);
+    const morphio::Morphology morph(mutMorph);
+    auto buffer = morph.serialize();
+    const auto copy = morphio::Morphology::deserialize(buffer.data(), buffer.size());
+    requireSame(copy, morph);
+    REQUIRE(copy.annotations().at(0)._details == "details");
+    REQUIRE(copy.markers().at(0)._pointLevel._diameters == std::vector<morphio::floatType>{4});
+
+    // Sections are rebuilt from the buffer, not from the original morphology
+    REQUIRE(copy.rootSections().size() == morph.rootSections().size());
+    REQUIRE(toVector(copy.section(1).points()) == toVector(morph.section(1).points()));
+
+    CHECK_THROWS_AS(morphio::Morphology::deserialize(buffer.data(), buffer.size() - 1),
+                    morphio::RawDataError);
+    CHECK_THROWS_AS(morphio::Morphology::deserialize(buffer.data(), 10), morphio::RawDataError);
+
+    // Corrupt the last point
+    const char* point = reinterpret_cast<const char*>(&morph.points().back());
+    const auto pointBytes =
+        std::search(buffer.begin(), buffer.end(), point, point + sizeof(morphio::Point));
+    REQUIRE(pointBytes != buffer.end());
+    *pointBytes ^= 1;
+    CHECK_THROWS_AS(morphio::Morphology::deserialize(buffer.data(), buffer.size()),
+                    morphio::RawDataError);
+}
+
+TEST_CASE("sharedStore", "[immutableMorphology]") {
+    const std::vector<std::string> paths = {"data/simple.swc", "data/h5/v1/Neuron.h5"};
+    const morphio::Morphology simple(paths[0]);
+    const morphio::Morphology neuron(paths[1]);
+
+    const std::string pid = std::to_string(getpid());
+    for (const std::string& name : {"morphio-test-" + pid, "./shared-store-" + pid + ".bin"}) {
+        morphio::SharedStore::remove(name);
+        {
+            const auto created = morphio::SharedStore::create(name, paths, {&simple, &neuron});
+            REQUIRE(created.size() == 2);
+            CHECK_THROWS_AS(morphio::SharedStore::create(name, paths, {&simple, &neuron}),
+                            morphio::RawDataError);
+        }
+
+        const morphio::SharedStore store(name);
+        REQUIRE(store.keys() == paths);
+        REQUIRE(store.contains(paths[1]));
+        REQUIRE(!store.contains("missing"));
+        CHECK_THROWS_AS(store.load("missing"), morphio::RawDataError);
+
+        const morphio::Morphology loaded = store.load(paths[1]);
+        REQUIRE(loaded.points() == neuron.points());
+        REQUIRE(loaded.sectionOffsets() == neuron.sectionOffsets());
+        REQUIRE(loaded.connectivity() == neuron.connectivity());
+        REQUIRE(store.load(paths[0]).diameters() == simple.diameters());
+
+        // Loaded morphologies share their data within a process
+        REQUIRE(store.load(paths[1]).points().data() == loaded.points().data());
+
+        // The points of the sections are viewed in the mapping, that the morphology keeps
+        const morphio::Morphology attached = morphio::SharedStore(name).load(paths[1]);
+        morphio::SharedStore::remove(name);
+        for (const auto& section : neuron.sections()) {
+            const auto points = attached.section(section.id()).points();
+            REQUIRE(std::equal(points.begin(),
+                               points.end(),
+                               section.points().begin(),
+                               section.points().end()));
+        }
+        REQUIRE(store.load(paths[0]).points() == simple.points());  // still mapped
+        CHECK_THROWS_AS(morphio::SharedStore(name), morphio::RawDataError);
+    }
+
+    CHECK_THROWS_AS(morphio::SharedStore("data/simple.swc"), morphio::RawDataError);
+    CHECK_THROWS_AS(morphio::SharedStore::create("morphio-test-" + pid, paths, {&simple}),
+                    morphio::RawDataError);
+}
+
+TEST_CASE("parseCache", "[immutableMorphology]") {
+    namespace fs = std::filesystem;
+    const auto tmpDirectory = fs::temp_directory_path() / "test_immutable_morphology.cpp";
+    const auto cacheDirectory = tmpDirectory / "cache";
+    fs::remove_all(tmpDirectory);
+    fs::create_directories(tmpDirectory);
+    const auto path = (tmpDirectory / "simple.swc").string();
+    fs::copy_file("data/simple.swc", path);
+
+    const auto countEntries = [&cacheDirectory]() {
+        size_t count = 0;
+        for (const auto& entry : fs::directory_iterator(cacheDirectory)) {
+            count += entry.path().extension() == ".cache";
+        }
+        return count;
+    };
+
+    morphio::enableParseCache(cacheDirectory.string());
+    REQUIRE(countEntries() == 0);
+
+    const morphio::Morphology parsed(path);
+    REQUIRE(countEntries() == 1);
+    const morphio::Morphology cached(path);
+    REQUIRE(countEntries() == 1);
+    REQUIRE(cached.points() == parsed.points());
+    REQUIRE(cached.diameters() == parsed.diameters());
+    REQUIRE(cached.sectionTypes() == parsed.sectionTypes());
+    REQUIRE(cached.connectivity() == parsed.connectivity());
+    REQUIRE(cached.somaType() == parsed.somaType());
+
+    // The options are part of the key
+    morphio::Morphology(path, morphio::TWO_POINTS_SECTIONS);
+    REQUIRE(countEntries() == 2);
+
+    // So are the neurite types loaded
+    const morphio::Morphology axon(path, morphio::NO_MODIFIER, {morphio::SECTION_AXON});
+    REQUIRE(countEntries() == 3);
+    const morphio::Morphology dendrite(path, morphio::NO_MODIFIER, {morphio::SECTION_DENDRITE});
+    REQUIRE(countEntries() == 4);
+    REQUIRE(axon.sectionTypes() == std::vector<morphio::SectionType>(3, morphio::SECTION_AXON));
+    REQUIRE(dendrite.sectionTypes() ==
+            std::vector<morphio::SectionType>(3, morphio::SECTION_DENDRITE));
+    REQUIRE(morphio::Morphology(path, morphio::NO_MODIFIER, {morphio::SECTION_AXON}).points() ==
+            axon.points());
+    REQUIRE(countEntries() == 4);
+
+    {  // Same size and modification time but different content: the file is parsed again
+        const auto lastWrite = fs::last_write_time(path);
+        std::string content;
+        {
+            std::ifstream file(path);
+            content.assign(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+        }
+        content.replace(content.find(" 8 2  6 -4"), 10, " 8 2  7 -4");
+        std::ofstream(path) << content;
+        fs::last_write_time(path, lastWrite);
+
+        const morphio::Morphology modified(path);
+        REQUIRE(modified.points() != parsed.points());
+        REQUIRE(modified.points() == morphio::Morphology(path).points());
+    }
+
+#ifdef __linux__
+    // A miss reads the file once: the content read to check the cache is parsed
+    morphio::enableIOStats();
+    morphio::Morphology(path, morphio::NO_DUPLICATES);
+    REQUIRE(morphio::lastIOStats().bytesRead == fs::file_size(path));
+    morphio::enableIOStats(false);
+#endif
+
+    morphio::disableParseCache();
+    fs::remove_all(cacheDirectory);
+    REQUIRE(morphio::Morphology(path).points().size() == parsed.points().size());
+    REQUIRE(!fs::exists(cacheDirectory));
+}
+
+TEST_CASE("ioPolicy", "[immutableMorphology]") {
+    const std::vector<std::string> paths{"data/simple.swc",
+                                         "data/simple.asc",
+                                         "data/h5/v1/simple.h5",
+                                         "data/simple.swc.gz"};
+    const std::vector<morphio::IOPolicy> policies{morphio::IO_READAHEAD,
+                                                  morphio::IO_SLURP,
+                                                  morphio::IO_MMAP};
+    for (const auto& path : paths) {
+        const morphio::Morphology expected(path);
+        for (const auto policy : policies) {
+            morphio::setIOPolicy(policy);
+            REQUIRE(morphio::getIOPolicy() == policy);
+            const morphio::Morphology morphology(path);
+            REQUIRE(morphology.points() == expected.points());
+            REQUIRE(morphology.diameters() == expected.diameters());
+            REQUIRE(morphology.sectionTypes() == expected.sectionTypes());
+            REQUIRE(morphology.connectivity() == expected.connectivity());
+        }
+    }
+
+    morphio::setIOPolicy(morphio::IO_SLURP);
+    CHECK_THROWS_AS(morphio::Morphology("data/simple-missing.swc"), morphio::RawDataError);
+    // The policy of the process is the default of the options
+    REQUIRE(morphio::LoadOptions().ioPolicy == morphio::IO_SLURP);
+    morphio::setIOPolicy(morphio::IO_DEFAULT);
+    REQUIRE(morphio::LoadOptions().ioPolicy == morphio::IO_DEFAULT);
+
+#ifdef __linux__
+    morphio::enableIOStats();
+    const auto fileSize = std::filesystem::file_size("data/simple.swc");
+
+    morphio::setIOPolicy(morphio::IO_SLURP);
+    morphio::Morphology("data/simple.swc");
+    REQUIRE(morphio::lastIOStats().readCalls == 1);
+    REQUIRE(morphio::lastIOStats().bytesRead == fileSize);
+    REQUIRE(morphio::lastIOStats().bytesMapped == 0);
+
+    morphio::setIOPolicy(morphio::IO_MMAP);
+    morphio::Morphology("data/simple.swc");
+    REQUIRE(morphio::lastIOStats().readCalls == 0);
+    REQUIRE(morphio::lastIOStats().bytesRead == 0);
+    REQUIRE(morphio::lastIOStats().bytesMapped == fileSize);
+
+    morphio::setIOPolicy(morphio::IO_DEFAULT);
+    morphio::Morphology("data/simple.swc");
+    REQUIRE(morphio::lastIOStats().readCalls >= 1);
+    REQUIRE(morphio::lastIOStats().bytesRead == fileSize);
+
+    // A load can read its file with another policy than the process
+    morphio::LoadOptions mapped;
+    mapped.ioPolicy = morphio::IO_MMAP;
+    morphio::Morphology("data/simple.swc", morphio::NO_MODIFIER, mapped);
+    REQUIRE(morphio::lastIOStats().bytesMapped == fileSize);
+    REQUIRE(morphio::getIOPolicy() == morphio::IO_DEFAULT);
+
+    // Stats are left unchanged when they are not collected
+    morphio::enableIOStats(false);
+    morphio::Morphology("data/h5/v1/simple.h5");
+    REQUIRE(morphio::lastIOStats().bytesRead == fileSize);
+#endif
+}
+
+TEST_CASE("loadOptionsResample", "[immutableMorphology]") {
+    for (const std::string path : {"data/simple.swc", "data/h5/v1/Neuron.h5"}) {
+        morphio::LoadOptions loadOptions;
+        loadOptions.simplifyTolerance = 0.5;
+        loadOptions.resampleSpacing = 2;
+        const morphio::Morphology morph(path, morphio::NO_MODIFIER, loadOptions);
+
+        morphio::Property::Properties expected = morphio::mut::Morphology(path).buildReadOnly();
+        morphio::modifiers::simplify(expected, 0.5);
+        morphio::modifiers::resample(expected, 2);
+        REQUIRE(morph.points() == expected._pointLevel._points);
+        REQUIRE(morph.diameters() == expected._pointLevel._diameters);
+        REQUIRE(morph.sectionOffsets().size() == expected._sectionLevel._sections.size() + 1);
+        REQUIRE(morph.section(0).children().size() ==
+                morphio::Morphology(path).section(0).children().size());
+    }
+
+    morphio::LoadOptions invalid;
+    invalid.resampleSpacing = -1;
+    REQUIRE_THROWS_AS(morphio::Morphology("data/simple.swc", morphio::NO_MODIFIER, invalid),
+                      morphio::MorphioError);
+}
+
+TEST_CASE("loadOptions", "[immutableMorphology]") {
+    const auto geometryOnly = morphio::LoadOptions::geometryOnly();
+    const auto requireSameGeometry = [](const morphio::Morphology& a,
+                                        const morphio::Morphology& b) {
+        REQUIRE(a.points() == b.points());
+        REQUIRE(a.diameters() == b.diameters());
+        REQUIRE(a.sectionTypes() == b.sectionTypes());
+        REQUIRE(a.connectivity() == b.connectivity());
+    };
+
+    {
+        const morphio::Morphology full("data/h5/v1/glia.h5");
+        const morphio::Morphology geometry("data/h5/v1/glia.h5",
+                                           morphio::NO_MODIFIER,
+                                           geometryOnly);
+        REQUIRE(full.perimeters().size() == 2);
+        REQUIRE(geometry.perimeters().empty());
+        requireSameGeometry(geometry, full);
+    }
+    {
+        morphio::LoadOptions noMitochondria;
+        noMitochondria.mitochondria = false;
+        const morphio::Morphology full("data/h5/v1/mitochondria.h5");
+        const morphio::Morphology partial("data/h5/v1/mitochondria.h5",
+                                          morphio::NO_MODIFIER,
+                                          noMitochondria);
+        REQUIRE(!full.mitochondria().rootSections().empty());
+        REQUIRE(partial.mitochondria().rootSections().empty());
+        REQUIRE(partial.perimeters() == full.perimeters());
+        requireSameGeometry(partial, full);
+    }
+    {
+        const morphio::Morphology geometry("data/h5/v1/endoplasmic-reticulum.h5",
+                                           morphio::NO_MODIFIER,
+                                           geometryOnly);
+        REQUIRE(geometry.endoplasmicReticulum().sectionIndices().empty());
+    }
+    {
+        const morphio::Morphology full("data/markers.asc");
+        const morphio::Morphology geometry("data/markers.asc", morphio::NO_MODIFIER, geometryOnly);
+        REQUIRE(full.markers().size() == 5);
+        REQUIRE(geometry.markers().empty());
+        requireSameGeometry(geometry, full);
+    }
+    requireSameGeometry(
+        morphio::Morphology("data/simple.swc", morphio::NO_MODIFIER, geometryOnly),
+        morphio::Morphology("data/simple.swc"));
+
+    {  // The MorphIO binary format skips the blocks of the disabled payloads
+        morphio::mut::Morphology mutMorph("data/simple.swc");
+        for (const auto& section : mutMorph.sections()) {
+            section.second->perimeters().assign(section.second->points().size(), 1);
+        }
+        mutMorph.mitochondria().appendRootSection(
+            morphio::Property::MitochondriaPointLevel({0}, {0.5}, {1}));
+        mutMorph.addAnnotation(morphio::Property::Annotation(
+            morphio::SINGLE_CHILD, 1, morphio::Property::PointLevel(), "details", 12));
+        morphio::Property::Marker marker;
+        marker._label = "pia";
+        marker._pointLevel = morphio::Property::PointLevel({{1, 2, 3}}, {4});
+        mutMorph.addMarker(marker);
+        const morphio::Morphology full(mutMorph);
+        const auto buffer = full.serialize();
+
+        const auto geometry = morphio::Morphology::fromBuffer(
+            buffer.data(), buffer.size(), "morphio", morphio::NO_MODIFIER, geometryOnly);
+        requireSameGeometry(geometry, full);
+        REQUIRE(!full.perimeters().empty());
+        REQUIRE(geometry.perimeters().empty());
+        REQUIRE(geometry.mitochondria().rootSections().empty());
+        REQUIRE(geometry.annotations().empty());
+        REQUIRE(geometry.markers().empty());
+
+        morphio::LoadOptions noMarkers;
+        noMarkers.markers = false;
+        const auto partial = morphio::Morphology::fromBuffer(
+            buffer.data(), buffer.size(), "morphio", morphio::NO_MODIFIER, noMarkers);
+        REQUIRE(partial.perimeters() == full.perimeters());
+        REQUIRE(partial.mitochondria().rootSections().size() == 1);
+        REQUIRE(partial.annotations().size() == 1);
+        REQUIRE(partial.markers().empty());
+    }
+}
+
+TEST_CASE("neuriteTypes", "[immutableMorphology]") {
+    const morphio::Morphology full("data/simple.swc");
+    const auto requireSamePoints = [](const morphio::Section& a, const morphio::Section& b) {
+        REQUIRE(a.points().size() == b.points().size());
+        REQUIRE(std::equal(a.points().begin(), a.points().end(), b.points().begin()));
+    };
+    const auto requireAxonOnly = [&](const morphio::Morphology& axon) {
+        REQUIRE(axon.sections().size() == 3);
+        for (const auto& section : axon.sections()) {
+            REQUIRE(section.type() == morphio::SECTION_AXON);
+            // Sections are renumbered in their order in the file
+            requireSamePoints(section, full.section(section.id() + 3));
+        }
+        REQUIRE(axon.rootSections().size() == 1);
+        REQUIRE(axon.connectivity().at(0) == std::vector<unsigned int>{1, 2});
+        REQUIRE(axon.soma().points().size() == full.soma().points().size());
+    };
+
+    for (const auto& path : {"data/simple.swc", "data/simple.asc", "data/h5/v1/simple.h5"}) {
+        const morphio::Morphology axon(path, morphio::NO_MODIFIER, {morphio::SECTION_AXON});
+        requireAxonOnly(axon);
+
+        const morphio::Morphology dendrites(path,
+                                            morphio::NO_MODIFIER,
+                                            {morphio::SECTION_DENDRITE,
+                                             morphio::SECTION_APICAL_DENDRITE});
+        REQUIRE(dendrites.sections().size() == 3);
+        for (const auto& section : dendrites.sections()) {
+            REQUIRE(section.type() == morphio::SECTION_DENDRITE);
+            requireSamePoints(section, full.section(section.id()));
+        }
+
+        const morphio::Morphology none(path,
+                                       morphio::NO_MODIFIER,
+                                       {morphio::SECTION_APICAL_DENDRITE});
+        REQUIRE(none.sections().empty());
+        REQUIRE(none.points().size() == 0);
+        REQUIRE(none.soma().points().size() == full.soma().points().size());
+    }
+
+    {  // Organelles are renumbered, those of skipped neurites dropped
+        const morphio::Morphology morph("data/h5/v1/mitochondria.h5",
+                                        morphio::NO_MODIFIER,
+                                        {morphio::SECTION_AXON});
+        for (const auto& mitoSection : morph.mitochondria().sections()) {
+            for (const auto id : mitoSection.neuriteSectionIds()) {
+                REQUIRE(morph.section(id).type() == morphio::SECTION_AXON);
+            }
+        }
+    }
+
+    {  // The MorphIO binary format filters the decoded neurites
+        morphio::mut::Morphology mutMorph("data/simple.swc");
+        mutMorph.mitochondria().appendRootSection(
+            morphio::Property::MitochondriaPointLevel({0}, {0.5}, {1}));
+        mutMorph.mitochondria().appendRootSection(
+            morphio::Property::MitochondriaPointLevel({4, 4}, {0.5, 0.7}, {1, 2}));
+        mutMorph.addAnnotation(morphio::Property::Annotation(
+            morphio::SINGLE_CHILD, 1, morphio::Property::PointLevel(), "details", 12));
+        const auto buffer = morphio::Morphology(mutMorph).serialize();
+
+        const auto axon = morphio::Morphology::fromBuffer(
+            buffer.data(), buffer.size(), "morphio", morphio::NO_MODIFIER, {morphio::SECTION_AXON});
+        requireAxonOnly(axon);
+        REQUIRE(axon.mitochondria().rootSections().size() == 1);
+        const auto ids = axon.mitochondria().rootSections()[0].neuriteSectionIds();
+        REQUIRE(std::vector<uint32_t>(ids.begin(), ids.end()) == std::vector<uint32_t>{1, 1});
+        REQUIRE(axon.annotations().empty());
+    }
+}
+
+TEST_CASE("lazy", "[immutableMorphology]") {
+    morphio::LoadOptions lazyOptions;
+    lazyOptions.lazy = true;
+
+    for (const auto& path :
+         {"data/h5/v1/simple.h5", "data/h5/v1/Neuron.h5", "data/h5/v1/glia.h5"}) {
+        const morphio::Morphology eager(path);
+        const morphio::Morphology lazy(path, morphio::NO_MODIFIER, lazyOptions);
+
+        // Topology is available without reading the points
+        REQUIRE(lazy.sectionOffsets() == eager.sectionOffsets());
+        REQUIRE(lazy.sectionTypes() == eager.sectionTypes());
+        REQUIRE(lazy.connectivity() == eager.connectivity());
+        REQUIRE(lazy.soma().points().size() == eager.soma().points().size());
+
+        for (const auto& section : eager.sections()) {
+            const auto lazySection = lazy.section(section.id());
+            REQUIRE(std::equal(section.points().begin(),
+                               section.points().end(),
+                               lazySection.points().begin(),
+                               lazySection.points().end()));
+            REQUIRE(std::equal(section.diameters().begin(),
+                               section.diameters().end(),
+                               lazySection.diameters().begin(),
+                               lazySection.diameters().end()));
+            REQUIRE(std::equal(section.perimeters().begin(),
+                               section.perimeters().end(),
+                               lazySection.perimeters().begin(),
+                               lazySection.perimeters().end()));
+        }
+        REQUIRE(lazy.points() == eager.points());
+        REQUIRE(lazy.diameters() == eager.diameters());
+        REQUIRE(lazy.perimeters() == eager.perimeters());
+        REQUIRE(morphio::mut::Morphology(lazy).section(0)->points() ==
+                morphio::mut::Morphology(eager).section(0)->points());
+    }
+
+    {  // Combined with a neurite filter
+        lazyOptions.neuriteTypes = {morphio::SECTION_AXON};
+        const morphio::Morphology eager("data/h5/v1/simple.h5",
+                                        morphio::NO_MODIFIER,
+                                        {morphio::SECTION_AXON});
+        const morphio::Morphology lazy("data/h5/v1/simple.h5", morphio::NO_MODIFIER, lazyOptions);
+        REQUIRE(lazy.sectionOffsets() == eager.sectionOffsets());
+        REQUIRE(lazy.section(2).points()[1] == eager.section(2).points()[1]);
+        REQUIRE(lazy.points() == eager.points());
+    }
+
+    {  // Modifiers read all the points at load time
+        lazyOptions.neuriteTypes.clear();
+        const morphio::Morphology eager("data/h5/v1/Neuron.h5", morphio::TWO_POINTS_SECTIONS);
+        const morphio::Morphology lazy("data/h5/v1/Neuron.h5",
+                                       morphio::TWO_POINTS_SECTIONS,
+                                       lazyOptions);
+        REQUIRE(lazy.points() == eager.points());
+    }
+}
+
+namespace {
+/** Rebuild the arrays of a morphology from the events of morphio::stream **/
+class ArraysHandler: public morphio::MorphologyHandler
+{
+  public:
+    void onSoma(morphio::SomaType type,
+                morphio::range<const morphio::Point> somaPoints_,
+                morphio::range<const morphio::floatType> /*diameters*/) override {
+        somaType = type;
+        somaPoints = somaPoints_.size();
+    }
+    void onSectionBegin(uint32_t id, morphio::SectionType type, int32_t parent) override {
+        REQUIRE(id == types.size());
+        REQUIRE(!inSection);
+        inSection = true;
+        offsets.push_back(static_cast<uint32_t>(points.size()));
+        types.push_back(type);
+        parents.push_back(parent);
+    }
+    void onPoints(morphio::range<const morphio::Point> sectionPoints,
+                  morphio::range<const morphio::floatType> sectionDiameters,
+                  morphio::range<const morphio::floatType> sectionPerimeters) override {
+        points.insert(points.end(), sectionPoints.begin(), sectionPoints.end());
+        diameters.insert(diameters.end(), sectionDiameters.begin(), sectionDiameters.end());
+        perimeters.insert(perimeters.end(), sectionPerimeters.begin(), sectionPerimeters.end());
+    }
+    void onSectionEnd(uint32_t id) override {
+        REQUIRE(inSection);
+        REQUIRE(id + 1 == types.size());
+        inSection = false;
+    }
+    void onMarker(const morphio::Property::Marker& marker) override {
+        markers.push_back(marker._label);
+    }
+
+    morphio::SomaType somaType = morphio::SOMA_UNDEFINED;
+    size_t somaPoints = 0;
+    bool inSection = false;
+    std::vector<uint32_t> offsets;
+    std::vector<morphio::SectionType> types;
+    std::vector<int32_t> parents;
+    morphio::Points points;
+    std::vector<morphio::floatType> diameters;
+    std::vector<morphio::floatType> perimeters;
+    std::vector<std::string> markers;
+};
+}  // namespace
+
+TEST_CASE("stream", "[immutableMorphology]") {
+    const auto requireSameMorphology = [](const ArraysHandler& handler,
+                                          const morphio::Morphology& morph) {
+        REQUIRE(handler.somaType == morph.soma().type());
+        REQUIRE(handler.somaPoints == morph.soma().points().size());
+        auto offsets = morph.sectionOffsets();
+        offsets.pop_back();
+        REQUIRE(handler.offsets == offsets);
+        REQUIRE(handler.types == morph.sectionTypes());
+        for (const auto& section : morph.sections()) {
+            const int32_t parent = section.isRoot() ? -1
+                                                    : static_cast<int32_t>(section.parent().id());
+            REQUIRE(handler.parents[section.id()] == parent);
+        }
+        REQUIRE(handler.points == morph.points());
+        REQUIRE(handler.diameters == morph.diameters());
+        REQUIRE(handler.perimeters == morph.perimeters());
+        REQUIRE(handler.markers.size() == morph.markers().size());
+    };
+
+    for (const auto& path : {"data/simple.swc",
+                             "data/simple.asc",
+                             "data/markers.asc",
+                             "data/h5/v1/simple.h5",
+                             "data/h5/v1/Neuron.h5",
+                             "data/h5/v1/glia.h5"}) {
+        ArraysHandler handler;
+        morphio::stream(path, handler);
+        requireSameMorphology(handler, morphio::Morphology(path));
+    }
+
+    {  // Load options apply
+        ArraysHandler handler;
+        morphio::stream("data/h5/v1/simple.h5", handler, {morphio::SECTION_AXON});
+        requireSameMorphology(handler,
+                              morphio::Morphology("data/h5/v1/simple.h5",
+                                                  morphio::NO_MODIFIER,
+                                                  {morphio::SECTION_AXON}));
+    }
+
+    {  // Callbacks that are not overridden do nothing
+        morphio::MorphologyHandler handler;
+        morphio::stream("data/simple.swc", handler);
+    }
+}
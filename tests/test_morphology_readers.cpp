@@ -141,6 +141,20 @@ TEST_CASE("LoadSWCMorphology", "[morphology]") {
     REQUIRE(m.diameters().size() == 12);
 }
 
+TEST_CASE("LoadGzipMorphology", "[morphology]") {
+    for (const std::string path : {"data/simple.swc", "data/simple.asc"}) {
+        const morphio::Morphology expected(path, morphio::NRN_ORDER);
+        const morphio::Morphology m(path + ".gz", morphio::NRN_ORDER);
+        REQUIRE(m.points().size() == expected.points().size());
+        REQUIRE(std::equal(m.points().begin(), m.points().end(), expected.points().begin()));
+        REQUIRE(
+            std::equal(m.diameters().begin(), m.diameters().end(), expected.diameters().begin()));
+        REQUIRE(std::get<0>(m.version()) == std::get<0>(expected.version()));
+    }
+
+    CHECK_THROWS_AS(morphio::Morphology("data/truncated.swc.gz"), morphio::RawDataError);
+}
+
 TEST_CASE("LoadNeurolucidaMorphology", "[morphology]") {
     const morphio::Morphology m("data/multiple_point_section.asc");
 
@@ -1,9 +1,18 @@
 #include "contrib/catch.hpp"
 
+#include <morphio/endoplasmic_reticulum.h>
+#include <morphio/mitochondria.h>
 #include <morphio/morphology.h>
+#include <morphio/modifiers.h>
+#include <morphio/mut/modifiers.h>
 #include <morphio/mut/morphology.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <thread>
+#include <type_traits>
 namespace fs = std::filesystem;
 
 
@@ -53,3 +62,319 @@ TEST_CASE("writing", "[mutableMorphology]") {
     REQUIRE(savedMorphSwc.rootSections().size() == 2);
     fs::remove_all(tmpDirectory);
 }
+
+namespace {
+void requireSameBuild(const morphio::mut::Morphology& morph) {
+    const morphio::Property::Properties built = morph.buildReadOnly();
+    const morphio::Property::Properties copied = morphio::mut::Morphology(morph).buildReadOnly();
+    REQUIRE(built._pointLevel._points == copied._pointLevel._points);
+    REQUIRE(built._pointLevel._diameters == copied._pointLevel._diameters);
+    REQUIRE(built._pointLevel._perimeters == copied._pointLevel._perimeters);
+    REQUIRE(built._sectionLevel._sections == copied._sectionLevel._sections);
+    REQUIRE(built._sectionLevel._sectionTypes == copied._sectionLevel._sectionTypes);
+}
+}  // anonymous namespace
+
+TEST_CASE("buildReadOnlyAfterEdits", "[mutableMorphology]") {
+    morphio::mut::Morphology morph("data/h5/v1/Neuron.h5");
+    requireSameBuild(morph);
+
+    const auto& firstRoot = morph.rootSections()[0];
+    std::shared_ptr<morphio::mut::Section> leaf;
+    for (auto it = firstRoot->depth_begin(); it != firstRoot->depth_end(); ++it) {
+        leaf = *it;
+    }
+    leaf->points()[0] = {1, 2, 3};
+    requireSameBuild(morph);
+
+    morph.rootSections()[1]->setProperties(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 1, 1}, {2, 2, 2}}, {1, 1, 1}));
+    requireSameBuild(morph);
+
+    leaf->acquireWritableView();
+    morphio::floatType* view = leaf->points().data()->data();
+    view[0] = 42;
+    requireSameBuild(morph);
+    // The points can not be reallocated under the view
+    CHECK_THROWS_AS(morphio::mut::modifiers::no_duplicate_point(morph),
+                    morphio::SectionBuilderError);
+    leaf->releaseWritableView();
+
+    leaf->appendSection(morphio::Property::PointLevel({{1, 2, 3}, {4, 5, 6}}, {1, 1}),
+                        morphio::SECTION_AXON);
+    requireSameBuild(morph);
+
+    // Children are re-attached to their grand-parent
+    morph.deleteSection(firstRoot->children()[0], false);
+    requireSameBuild(morph);
+
+    morph.deleteSection(morph.rootSections()[1]);
+    requireSameBuild(morph);
+
+    // Children become root sections
+    morph.deleteSection(morph.rootSections()[0], false);
+    requireSameBuild(morph);
+}
+
+TEST_CASE("mutableFromArrays", "[mutableMorphology]") {
+    // Section 1 is a child of section 2: mutable IDs are those of the arrays,
+    // not a depth first renumbering
+    const morphio::Points points{
+        {0, 0, 0}, {1, 0, 0}, {1, 0, 0}, {2, 1, 0}, {1, 0, 0}, {2, -1, 0}};
+    const std::vector<morphio::floatType> diameters{2, 2, 2, 1, 2, 1};
+    const std::vector<uint32_t> offsets{0, 2, 4};
+    const std::vector<int32_t> parents{-1, 0, 0};
+    const std::vector<morphio::SectionType> types{morphio::SECTION_DENDRITE,
+                                                  morphio::SECTION_DENDRITE,
+                                                  morphio::SECTION_AXON};
+
+    auto morph = morphio::mut::Morphology::fromArrays(
+        points, diameters, {}, offsets, parents, types, {{0, 0, 0}}, {4});
+    REQUIRE(morph.rootSections().size() == 1);
+    REQUIRE(morph.section(0)->children().size() == 2);
+    REQUIRE(morph.section(2)->type() == morphio::SECTION_AXON);
+    REQUIRE(morph.section(2)->points() == morphio::Points{{1, 0, 0}, {2, -1, 0}});
+    REQUIRE(morph.section(1)->parent()->id() == 0);
+    REQUIRE(morph.soma()->points() == morphio::Points{{0, 0, 0}});
+    REQUIRE(morph.soma()->type() == morphio::SOMA_SINGLE_POINT);
+
+    // Moving keeps the IDs, and the sections now belong to the new morphology
+    static_assert(std::is_nothrow_move_constructible<morphio::mut::Morphology>::value, "");
+    morphio::mut::Morphology moved(std::move(morph));
+    REQUIRE(morph.sections().empty());
+    REQUIRE(moved.sections().size() == 3);
+    REQUIRE(moved.section(2)->parent()->id() == 0);
+
+    // New sections get IDs after the ones of the arrays
+    const morphio::Property::PointLevel newPoints({{2, 1, 0}, {3, 1, 0}}, {1, 1});
+    REQUIRE(moved.section(1)->appendSection(newPoints)->id() == 3);
+    REQUIRE(moved.sections().size() == 4);
+
+    const morphio::Morphology immutable(moved);
+    REQUIRE(immutable.points().size() == 8);
+    REQUIRE(immutable.sectionOffsets() == std::vector<uint32_t>{0, 2, 4, 6, 8});
+
+    REQUIRE_THROWS_AS(morphio::mut::Morphology::fromArrays(
+                          points, diameters, {}, offsets, {-1, 2, 0}, types),
+                      morphio::RawDataError);
+}
+
+TEST_CASE("neuriteCheckout", "[mutableMorphology]") {
+    morphio::mut::Morphology morph("data/simple.swc");
+    const morphio::Property::Properties before = morph.buildReadOnly();
+    const auto section2 = morph.section(2);
+
+    auto dendrite = morph.checkoutNeurite(0);
+    auto axon = morph.checkoutNeurite(3);
+    REQUIRE(dendrite->rootSections().size() == 1);
+    REQUIRE(dendrite->sections().size() == 3);
+    REQUIRE(dendrite->section(2)->parent()->id() == 0);
+    REQUIRE_THROWS_AS(morph.checkoutNeurite(1), morphio::SectionBuilderError);
+
+    // Catch assertions are not thread safe: results are checked after the join
+    uint32_t dendriteNewId = 0;
+    uint32_t axonNewId = 0;
+    std::thread dendriteEditor([&dendrite, &dendriteNewId]() {
+        const morphio::Property::PointLevel points({{-5, 5, 0}, {-6, 6, 0}}, {1, 1});
+        dendriteNewId = dendrite->section(1)->appendSection(points)->id();
+        dendrite->deleteSection(dendrite->section(2));
+    });
+    std::thread axonEditor([&axon, &axonNewId]() {
+        const morphio::Property::PointLevel points({{6, -4, 0}, {7, -5, 0}}, {1, 1});
+        axonNewId = axon->section(4)->appendSection(points)->id();
+        axon->section(5)->diameters() = {4, 4};
+    });
+    dendriteEditor.join();
+    axonEditor.join();
+
+    // Both checkouts number their new sections after the sections of morph
+    REQUIRE(dendriteNewId == 6);
+    REQUIRE(axonNewId == 6);
+
+    // Nothing changed until the neurites are merged back
+    REQUIRE(morph.section(5)->diameters() == std::vector<morphio::floatType>{2, 4});
+    REQUIRE(morph.buildReadOnly()._sectionLevel._sections == before._sectionLevel._sections);
+
+    // A neurite only goes back to the root it was checked out from
+    morphio::mut::Morphology other("data/simple.swc");
+    REQUIRE_THROWS_AS(other.mergeNeurite(3, std::move(*axon)), morphio::SectionBuilderError);
+    REQUIRE_THROWS_AS(morph.mergeNeurite(0, std::move(*axon)), morphio::SectionBuilderError);
+    REQUIRE(axon->sections().size() == 4);
+
+    morph.mergeNeurite(3, std::move(*axon));
+    morph.mergeNeurite(0, std::move(*dendrite));
+    REQUIRE_THROWS_AS(morph.mergeNeurite(0, std::move(*dendrite)), morphio::SectionBuilderError);
+    REQUIRE(axon->sections().empty());
+    REQUIRE(dendrite->sections().empty());
+
+    // Section 2 was deleted: the previous instance is no longer part of the morphology
+    REQUIRE(morph.sections().count(2) == 0);
+    REQUIRE(section2->id() == 0xffffffff);
+    REQUIRE(morph.section(1)->children().size() == 1);
+    REQUIRE(morph.section(1)->children()[0]->id() == 7);
+    REQUIRE(morph.section(4)->children()[0]->id() == 6);
+    REQUIRE(morph.section(7)->parent()->id() == 1);
+    REQUIRE(morph.section(5)->diameters() == std::vector<morphio::floatType>{4, 4});
+    REQUIRE(morph.rootSections()[0]->id() == 0);
+    REQUIRE(morph.rootSections()[1]->id() == 3);
+
+    const morphio::Morphology merged(morph);
+    REQUIRE(merged.sectionOffsets() == std::vector<uint32_t>{0, 2, 4, 6, 8, 10, 12, 14});
+    REQUIRE(merged.diameters()[12] == 4);
+
+    // The section just appended is not a root section
+    auto checkedOutAgain = morph.checkoutNeurite(0);
+    REQUIRE_THROWS_AS(morph.mergeNeurite(7, std::move(*checkedOutAgain)),
+                      morphio::SectionBuilderError);
+    REQUIRE(checkedOutAgain->sections().size() == 3);
+}
+
+TEST_CASE("resample", "[mutableMorphology]") {
+    morphio::mut::Morphology morph;
+    const auto axon = morph.appendRootSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 0, 0}, {10, 0, 0}}, {2, 2, 20}),
+        morphio::SECTION_AXON);
+    const auto dendrite = morph.appendRootSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {0, 1, 0}, {0, 2, 0}}, {2, 2, 2}),
+        morphio::SECTION_DENDRITE);
+
+    morphio::mut::modifiers::resample(morph, {{morphio::SECTION_AXON, 4}});
+
+    // 10um long: 3 segments of 3.33um
+    const std::vector<double> expectedX{0, 10. / 3, 20. / 3, 10};
+    const std::vector<double> expectedDiameters{2, 20. / 3, 40. / 3, 20};
+    REQUIRE(axon->points().size() == 4);
+    REQUIRE(axon->diameters().size() == 4);
+    for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(axon->points()[i][0] == Approx(expectedX[i]));
+        REQUIRE(axon->points()[i][1] == 0);
+        REQUIRE(axon->diameters()[i] == Approx(expectedDiameters[i]));
+    }
+    REQUIRE(dendrite->points().size() == 3);
+
+    // Invalid spacings are rejected before any section is modified
+    REQUIRE_THROWS_AS(morphio::mut::modifiers::resample(morph, 0), morphio::MorphioError);
+    REQUIRE_THROWS_AS(morphio::mut::modifiers::resample(morph, std::nanf("")),
+                      morphio::MorphioError);
+    REQUIRE_THROWS_AS(morphio::mut::modifiers::resample(
+                          morph, {{morphio::SECTION_AXON, 1}, {morphio::SECTION_DENDRITE, -1}}),
+                      morphio::MorphioError);
+    REQUIRE(axon->points().size() == 4);
+
+    // Flat array version on the built properties gives the same result
+    morphio::mut::Morphology other;
+    other.appendRootSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 0, 0}, {10, 0, 0}}, {2, 2, 20}),
+        morphio::SECTION_AXON);
+    morphio::Property::Properties properties = other.buildReadOnly();
+    morphio::modifiers::resample(properties, 4);
+    REQUIRE(properties._pointLevel._points == axon->points());
+    REQUIRE(properties._pointLevel._diameters == axon->diameters());
+}
+
+TEST_CASE("simplify", "[mutableMorphology]") {
+    morphio::mut::Morphology morph;
+    const auto section = morph.appendRootSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 0.01f, 0}, {2, 0, 0}, {3, 1, 0}, {4, 0, 0}},
+                                      {2, 2, 2, 2, 2}),
+        morphio::SECTION_DENDRITE);
+    const auto child = section->appendSection(
+        morphio::Property::PointLevel({{4, 0, 0}, {5, 0, 0}, {6, 0, 0}}, {2, 4, 2}));
+
+    morphio::mut::Morphology copy(morph);
+    morphio::mut::modifiers::simplify(morph, 0.1f);
+
+    REQUIRE(section->points() ==
+            std::vector<morphio::Point>{{0, 0, 0}, {2, 0, 0}, {3, 1, 0}, {4, 0, 0}});
+    // The middle point is straight but carries a diameter change
+    REQUIRE(child->points().size() == 3);
+
+    morphio::Property::Properties properties = copy.buildReadOnly();
+    morphio::modifiers::simplify(properties, 0.1f);
+    REQUIRE(properties._pointLevel._points == morphio::Morphology(morph).points());
+    REQUIRE(properties._sectionLevel._sections[1][0] == 4);
+
+    REQUIRE_THROWS_AS(morphio::mut::modifiers::simplify(morph, -1), morphio::MorphioError);
+    REQUIRE_THROWS_AS(morphio::modifiers::simplify(properties, std::nanf("")),
+                      morphio::MorphioError);
+}
+
+TEST_CASE("writingBinary", "[mutableMorphology]") {
+    auto tmpDirectory = std::filesystem::temp_directory_path() / "test_writing_binary";
+    std::filesystem::create_directories(tmpDirectory);
+    const auto binaryPath = tmpDirectory / "morph.morphio";
+    const auto h5Path = tmpDirectory / "morph.h5";
+
+    for (const std::string path : {"data/h5/v1/Neuron.h5",
+                                   "data/h5/v1/mitochondria.h5",
+                                   "data/h5/v1/endoplasmic-reticulum.h5",
+                                   "data/simple.swc",
+                                   "data/simple.asc"}) {
+        morphio::mut::Morphology morph(path);
+        morph.write(binaryPath);
+        morph.write(h5Path);
+
+        const std::vector<unsigned int> allOptions = {morphio::NO_MODIFIER,
+                                                      morphio::NRN_ORDER | morphio::SOMA_SPHERE};
+        for (unsigned int options : allOptions) {
+            const morphio::Morphology binary(binaryPath, options);
+            const morphio::Morphology h5(h5Path, options);
+            REQUIRE(binary.points() == h5.points());
+            REQUIRE(binary.diameters() == h5.diameters());
+            REQUIRE(binary.perimeters() == h5.perimeters());
+            REQUIRE(binary.sectionOffsets() == h5.sectionOffsets());
+            REQUIRE(binary.sectionTypes() == h5.sectionTypes());
+            REQUIRE(binary.connectivity() == h5.connectivity());
+            REQUIRE(binary.cellFamily() == h5.cellFamily());
+            REQUIRE(binary.mitochondria().sections().size() ==
+                    h5.mitochondria().sections().size());
+            REQUIRE(binary.endoplasmicReticulum().volumes() ==
+                    h5.endoplasmicReticulum().volumes());
+            REQUIRE(std::get<0>(binary.version()) == "morphio");
+        }
+
+        // Unlike H5, the soma type is stored
+        REQUIRE(morphio::Morphology(binaryPath).somaType() ==
+                morphio::Morphology(path).somaType());
+    }
+
+    // The extension is not case sensitive
+    const auto upperPath = tmpDirectory / "morph.MORPHIO";
+    morphio::mut::Morphology("data/simple.swc").write(upperPath);
+    REQUIRE(morphio::Morphology(upperPath).points() ==
+            morphio::Morphology("data/simple.swc").points());
+
+    std::ofstream(binaryPath) << "not a binary morphology";
+    CHECK_THROWS_AS(morphio::Morphology(binaryPath), morphio::RawDataError);
+    fs::remove_all(tmpDirectory);
+}
+
+TEST_CASE("readingBinaryInPlace", "[mutableMorphology]") {
+    // The points of the neurites are viewed in the mapping, unless they must be rewritten
+    const auto binaryPath = fs::temp_directory_path() / "reading_binary_in_place.morphio";
+    morphio::mut::Morphology("data/simple.swc").write(binaryPath);
+    const morphio::LoadOptions dendrites{morphio::SECTION_DENDRITE};
+    const std::vector<std::pair<unsigned int, morphio::LoadOptions>> loads = {
+        {morphio::NO_MODIFIER, {}},
+        {morphio::NO_MODIFIER, dendrites},
+        {morphio::TWO_POINTS_SECTIONS, {}}};
+    for (const auto& load : loads) {
+        const morphio::Morphology binary(binaryPath, load.first, load.second);
+        const morphio::Morphology swc("data/simple.swc", load.first, load.second);
+        REQUIRE(binary.sectionOffsets() == swc.sectionOffsets());
+        for (const auto& section : swc.sections()) {
+            const auto points = binary.section(section.id()).points();
+            const auto diameters = binary.section(section.id()).diameters();
+            REQUIRE(std::equal(points.begin(),
+                               points.end(),
+                               section.points().begin(),
+                               section.points().end()));
+            REQUIRE(std::equal(diameters.begin(),
+                               diameters.end(),
+                               section.diameters().begin(),
+                               section.diameters().end()));
+        }
+        REQUIRE(binary.points() == swc.points());
+    }
+    fs::remove(binaryPath);
+}